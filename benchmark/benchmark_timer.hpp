@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+
+namespace bench
+{
+
+// Runs the function once and returns the mean duration of one of its op_count operations, in nanoseconds.
+template <class FunctionT>
+double ns_per_op(std::size_t op_count, FunctionT&& function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(op_count);
+}
+
+inline void print_result(std::string_view label, double ns_per_op_value)
+{
+    std::cout << std::left << std::setw(48) << label << std::right << std::setw(10) << std::fixed
+              << std::setprecision(2) << ns_per_op_value << " ns/op" << std::endl;
+}
+
+// Prevents the compiler from optimizing away a value computed by a benchmark.
+template <class ValueT>
+inline void do_not_optimize(const ValueT& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace bench
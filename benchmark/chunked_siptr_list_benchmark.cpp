@@ -0,0 +1,67 @@
+#include "benchmark_timer.hpp"
+#include <arba/itru/chunked_siptr_list.hpp>
+#include <arba/itru/intrusive_ref_counter.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include <vector>
+
+struct element : public itru::intrusive_ref_counter<>
+{
+    std::uint64_t value = 0;
+};
+
+using element_siptr = itru::shared_intrusive_ptr<element>;
+
+template <class ListT, class FunctionT>
+double iteration_ns(const ListT& list, std::size_t round_count, FunctionT function)
+{
+    std::uint64_t sum = 0;
+    const double ns = bench::ns_per_op(list.size() * round_count,
+                                       [&]
+                                       {
+                                           for (std::size_t round = 0; round < round_count; ++round)
+                                               for (const element_siptr& value : list)
+                                                   sum += function(value);
+                                       });
+    bench::do_not_optimize(sum);
+    return ns;
+}
+
+// The std::list is filled in random order then sorted: its nodes are linked in an order unrelated to their
+// addresses, as in a list which has lived long enough. The chunked list is filled from it, in the same order.
+int main(int argc, char** argv)
+{
+    const std::size_t element_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const std::size_t round_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10;
+
+    std::vector<element_siptr> elements;
+    elements.reserve(element_count);
+    for (std::size_t i = 0; i < element_count; ++i)
+    {
+        elements.push_back(itru::make_shared_intrusive_ptr<element>());
+        elements.back()->value = i;
+    }
+    std::shuffle(elements.begin(), elements.end(), std::mt19937_64(42));
+
+    std::list<element_siptr> node_list(elements.begin(), elements.end());
+    node_list.sort([](const element_siptr& lhs, const element_siptr& rhs) { return lhs.get() < rhs.get(); });
+    itru::chunked_siptr_list<element> chunked_list;
+    for (const element_siptr& value : node_list)
+        chunked_list.push_back(value);
+    elements.clear();
+
+    const auto pointer_only = [](const element_siptr& value) { return reinterpret_cast<std::uintptr_t>(value.get()); };
+    const auto element_value = [](const element_siptr& value) { return value->value; };
+    bench::print_result("std::list iteration (pointers)", iteration_ns(node_list, round_count, pointer_only));
+    bench::print_result("chunked_siptr_list iteration (pointers)",
+                        iteration_ns(chunked_list, round_count, pointer_only));
+    bench::print_result("std::list iteration (elements)", iteration_ns(node_list, round_count, element_value));
+    bench::print_result("chunked_siptr_list iteration (elements)",
+                        iteration_ns(chunked_list, round_count, element_value));
+
+    return EXIT_SUCCESS;
+}
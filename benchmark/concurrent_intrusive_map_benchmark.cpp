@@ -0,0 +1,132 @@
+#include "benchmark_timer.hpp"
+#include <arba/itru/concurrent_intrusive_map.hpp>
+#include <arba/itru/intrusive_ref_counter.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct session : public itru::intrusive_ref_counter<>, public itru::concurrent_intrusive_map_hook<session>
+{
+    explicit session(std::uint64_t k) : key(k) {}
+
+    std::uint64_t key;
+    std::uint64_t payload = 0;
+};
+
+struct session_key_of
+{
+    std::uint64_t operator()(const session& value) const noexcept { return value.key; }
+};
+
+using session_map = itru::concurrent_intrusive_map<session, session_key_of>;
+
+// The structure being replaced: std::unordered_map shards, each one under a mutex.
+class sharded_session_map
+{
+public:
+    std::shared_ptr<session> find(std::uint64_t key)
+    {
+        shard& key_shard = shard_of_(key);
+        std::lock_guard lock(key_shard.mutex);
+        auto iter = key_shard.map.find(key);
+        return iter != key_shard.map.end() ? iter->second : nullptr;
+    }
+    bool emplace(std::uint64_t key)
+    {
+        shard& key_shard = shard_of_(key);
+        std::lock_guard lock(key_shard.mutex);
+        return key_shard.map.try_emplace(key, std::make_shared<session>(key)).second;
+    }
+    bool erase(std::uint64_t key)
+    {
+        shard& key_shard = shard_of_(key);
+        std::lock_guard lock(key_shard.mutex);
+        return key_shard.map.erase(key) != 0;
+    }
+
+private:
+    struct alignas(64) shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::uint64_t, std::shared_ptr<session>> map;
+    };
+
+    shard& shard_of_(std::uint64_t key) { return shards_[std::hash<std::uint64_t>()(key) % shards_.size()]; }
+
+    std::array<shard, 16> shards_;
+};
+
+// Each thread runs op_count operations on keys drawn in [0, key_range): a lookup with probability
+// read_percent / 100, else an insertion or an erasure. Returns the mean duration of one operation, measured over all
+// the threads: with perfect scaling, it is divided by the number of threads.
+template <class MapT>
+double mixed_ns_per_op(MapT& map, std::uint64_t key_range, std::size_t op_count, unsigned read_percent,
+                       unsigned thread_count)
+{
+    return bench::ns_per_op(op_count * thread_count,
+                            [&]
+                            {
+                                std::vector<std::thread> threads;
+                                for (unsigned i = 0; i < thread_count; ++i)
+                                {
+                                    threads.emplace_back(
+                                        [&, i]
+                                        {
+                                            std::mt19937_64 engine(i);
+                                            std::size_t found_count = 0;
+                                            for (std::size_t op = 0; op < op_count; ++op)
+                                            {
+                                                const std::uint64_t draw = engine();
+                                                const std::uint64_t key = (draw >> 8) % key_range;
+                                                if (draw % 100 < read_percent)
+                                                    found_count += map.find(key) != nullptr;
+                                                else if (draw & 128)
+                                                    found_count += map.emplace(key);
+                                                else
+                                                    found_count += map.erase(key);
+                                            }
+                                            bench::do_not_optimize(found_count);
+                                        });
+                                }
+                                for (std::thread& thread : threads)
+                                    thread.join();
+                            });
+}
+
+template <class MapT>
+void run(const std::string& name, std::size_t element_count, std::size_t op_count, unsigned max_thread_count)
+{
+    for (unsigned read_percent : { 95u, 50u })
+    {
+        for (unsigned thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+        {
+            MapT map;
+            for (std::uint64_t key = 0; key < element_count; ++key)
+                map.emplace(key * 2);
+            bench::print_result(name + " " + std::to_string(read_percent) + "% reads, threads: "
+                                    + std::to_string(thread_count),
+                                mixed_ns_per_op(map, element_count * 2, op_count, read_percent, thread_count));
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t element_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000;
+    const unsigned max_thread_count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+    const std::size_t op_count = 200'000;
+
+    run<session_map>("concurrent_intrusive_map", element_count, op_count, max_thread_count);
+    run<sharded_session_map>("sharded unordered_map", element_count, op_count, max_thread_count);
+    itru::epoch_reclaimer::synchronize();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+#include "benchmark_timer.hpp"
+#include <arba/itru/concurrent_intrusive_skip_list.hpp>
+#include <arba/itru/intrusive_ref_counter.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct skip_list_value : public itru::intrusive_ref_counter<>,
+                         public itru::concurrent_intrusive_skip_list_hook<skip_list_value>
+{
+    explicit skip_list_value(std::uint64_t k) : key(k) {}
+
+    std::uint64_t key;
+    std::uint64_t payload = 0;
+};
+
+struct skip_list_value_key_of
+{
+    std::uint64_t operator()(const skip_list_value& value) const noexcept { return value.key; }
+};
+
+using skip_list = itru::concurrent_intrusive_skip_list<skip_list_value, skip_list_value_key_of>;
+
+// Each thread looks up every key of its own shuffled copy of keys. Returns the mean duration of one lookup, measured
+// over all the threads: with perfect scaling, it is divided by the number of threads.
+double lookup_ns_per_op(const skip_list& list, const std::vector<std::uint64_t>& keys, unsigned thread_count)
+{
+    std::vector<std::vector<std::uint64_t>> thread_keys(thread_count, keys);
+    for (unsigned i = 0; i < thread_count; ++i)
+        std::shuffle(thread_keys[i].begin(), thread_keys[i].end(), std::mt19937_64(i));
+    return bench::ns_per_op(keys.size() * thread_count,
+                            [&]
+                            {
+                                std::vector<std::thread> threads;
+                                for (unsigned i = 0; i < thread_count; ++i)
+                                {
+                                    threads.emplace_back(
+                                        [&list, &lookup_keys = thread_keys[i]]
+                                        {
+                                            std::size_t found_count = 0;
+                                            for (std::uint64_t key : lookup_keys)
+                                                found_count += list.contains(key);
+                                            bench::do_not_optimize(found_count);
+                                        });
+                                }
+                                for (std::thread& thread : threads)
+                                    thread.join();
+                            });
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t element_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const unsigned max_thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+    std::mt19937_64 engine(42);
+    std::vector<std::uint64_t> keys(element_count);
+    for (std::uint64_t& key : keys)
+        key = engine();
+
+    skip_list list;
+    bench::print_result("skip_list insert", bench::ns_per_op(keys.size(),
+                                                                                  [&]
+                                                                                  {
+                                                                                      for (std::uint64_t key : keys)
+                                                                                          list.emplace(key);
+                                                                                  }));
+    for (unsigned thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+    {
+        bench::print_result("skip_list lookup, threads: " + std::to_string(thread_count),
+                            lookup_ns_per_op(list, keys, thread_count));
+    }
+
+    return EXIT_SUCCESS;
+}
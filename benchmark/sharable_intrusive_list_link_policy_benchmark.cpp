@@ -0,0 +1,76 @@
+#include "benchmark_timer.hpp"
+#include <arba/itru/intrusive_ref_counter.hpp>
+#include <arba/itru/sharable_intrusive_list.hpp>
+#include <arba/itru/sharable_intrusive_list_hook.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+struct shared_node : public itru::intrusive_ref_counter<>, public itru::sharable_intrusive_list_hook<shared_node>
+{
+    std::size_t value = 0;
+};
+
+struct raw_node : public itru::intrusive_ref_counter<>,
+                  public itru::sharable_intrusive_list_hook<raw_node, itru::raw_link_t>
+{
+    std::size_t value = 0;
+};
+
+// The nodes are owned by a vector of shared_intrusive_ptr in both cases: the lists only index them.
+template <class NodeT, class ToLinkT>
+void run_benchmark(std::string_view policy_name, std::size_t node_count, std::size_t round_count, ToLinkT to_link)
+{
+    std::vector<itru::shared_intrusive_ptr<NodeT>> nodes;
+    nodes.reserve(node_count);
+    for (std::size_t i = 0; i < node_count; ++i)
+        nodes.push_back(itru::make_shared_intrusive_ptr<NodeT>());
+
+    itru::sharable_intrusive_list<NodeT> list;
+    itru::sharable_intrusive_list<NodeT> other_list;
+    const std::size_t op_count = node_count * round_count;
+    double insert_ns = 0;
+    double erase_ns = 0;
+    double splice_ns = 0;
+    for (std::size_t round = 0; round < round_count; ++round)
+    {
+        insert_ns += bench::ns_per_op(op_count,
+                                      [&]
+                                      {
+                                          for (auto& node : nodes)
+                                              list.push_back(to_link(node));
+                                      });
+        splice_ns += bench::ns_per_op(op_count,
+                                      [&]
+                                      {
+                                          while (!list.empty())
+                                              other_list.splice(other_list.end(), list, list.begin());
+                                      });
+        erase_ns += bench::ns_per_op(op_count,
+                                     [&]
+                                     {
+                                         for (auto iter = other_list.begin(); iter != other_list.end();)
+                                             iter = other_list.erase(iter);
+                                     });
+        bench::do_not_optimize(other_list.size());
+    }
+
+    std::string label(policy_name);
+    bench::print_result(label + " push_back", insert_ns);
+    bench::print_result(label + " splice (one element)", splice_ns);
+    bench::print_result(label + " erase", erase_ns);
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t node_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const std::size_t round_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10;
+
+    run_benchmark<shared_node>("shared_link_t", node_count, round_count,
+                               [](const itru::shared_intrusive_ptr<shared_node>& node) { return node; });
+    run_benchmark<raw_node>("raw_link_t", node_count, round_count,
+                            [](const itru::shared_intrusive_ptr<raw_node>& node) { return node.get(); });
+
+    return EXIT_SUCCESS;
+}
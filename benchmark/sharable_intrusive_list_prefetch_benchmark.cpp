@@ -0,0 +1,74 @@
+#include "benchmark_timer.hpp"
+#include <arba/itru/intrusive_ref_counter.hpp>
+#include <arba/itru/sharable_intrusive_list.hpp>
+#include <arba/itru/sharable_intrusive_list_hook.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+struct node : public itru::intrusive_ref_counter<>, public itru::sharable_intrusive_list_hook<node>
+{
+    std::uint64_t value = 0;
+};
+
+// Some work per element, independent of the other elements.
+inline std::uint64_t mix(std::uint64_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+    }
+    return value;
+}
+
+// The nodes are allocated up front, then linked in a random order: successive elements of the list lie in unrelated
+// cache lines, as in a list which has lived long enough.
+int main(int argc, char** argv)
+{
+    const std::size_t node_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+    const std::size_t round_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5;
+
+    std::vector<itru::shared_intrusive_ptr<node>> nodes;
+    nodes.reserve(node_count);
+    for (std::size_t i = 0; i < node_count; ++i)
+    {
+        nodes.push_back(itru::make_shared_intrusive_ptr<node>());
+        nodes.back()->value = i;
+    }
+    std::shuffle(nodes.begin(), nodes.end(), std::mt19937_64(42));
+    itru::sharable_intrusive_list<node> list;
+    for (auto& element : nodes)
+        list.push_back(std::move(element));
+    nodes.clear();
+
+    const std::size_t op_count = node_count * round_count;
+    std::uint64_t sum = 0;
+    const double range_for_ns = bench::ns_per_op(op_count,
+                                                 [&]
+                                                 {
+                                                     for (std::size_t round = 0; round < round_count; ++round)
+                                                         for (const node& element : list)
+                                                             sum += mix(element.value);
+                                                 });
+    bench::print_result("range-for", range_for_ns);
+    for (std::size_t prefetch_distance : { 0, 1, 2, 4, 8, 16, 32 })
+    {
+        const double for_each_ns =
+            bench::ns_per_op(op_count,
+                             [&]
+                             {
+                                 for (std::size_t round = 0; round < round_count; ++round)
+                                     list.for_each([&](const node& element) { sum += mix(element.value); },
+                                                   prefetch_distance);
+                             });
+        bench::print_result("for_each, prefetch distance " + std::to_string(prefetch_distance), for_each_ns);
+    }
+    bench::do_not_optimize(sum);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+#include "benchmark_timer.hpp"
+#include <arba/itru/intrusive_ref_counter.hpp>
+#include <arba/itru/sharable_intrusive_unordered_set.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <malloc.h>
+
+// Heap bytes in use, allocator overhead included (glibc).
+inline std::size_t heap_bytes_in_use()
+{
+    return mallinfo2().uordblks;
+}
+
+struct map_value : public itru::intrusive_ref_counter<>
+{
+    explicit map_value(std::uint64_t k) : key(k) {}
+
+    std::uint64_t key;
+    std::uint64_t payload = 0;
+};
+
+struct set_value : public itru::intrusive_ref_counter<>, public itru::sharable_intrusive_unordered_set_hook<set_value>
+{
+    explicit set_value(std::uint64_t k) : key(k) {}
+
+    std::uint64_t key;
+    std::uint64_t payload = 0;
+};
+
+struct set_value_key_of
+{
+    std::uint64_t operator()(const set_value& value) const noexcept { return value.key; }
+};
+
+using intrusive_set = itru::sharable_intrusive_unordered_set<set_value, set_value_key_of>;
+using node_map = std::unordered_map<std::uint64_t, itru::shared_intrusive_ptr<map_value>>;
+
+struct measures
+{
+    double bytes_per_element = 0;
+    double insert_ns = 0;
+    double hit_lookup_ns = 0;
+    double miss_lookup_ns = 0;
+};
+
+void print_measures(std::string_view name, const measures& values)
+{
+    std::string label(name);
+    std::cout << std::left << std::setw(48) << label + " memory" << std::right << std::setw(10) << std::fixed
+              << std::setprecision(2) << values.bytes_per_element << " bytes/element" << std::endl;
+    bench::print_result(label + " insert", values.insert_ns);
+    bench::print_result(label + " lookup (hit)", values.hit_lookup_ns);
+    bench::print_result(label + " lookup (miss)", values.miss_lookup_ns);
+}
+
+template <class InsertT, class FindT>
+measures run_benchmark(const std::vector<std::uint64_t>& keys, const std::vector<std::uint64_t>& lookup_keys,
+                       const std::vector<std::uint64_t>& missing_keys, InsertT insert, FindT find)
+{
+    measures values;
+    const std::size_t bytes_before = heap_bytes_in_use();
+    values.insert_ns = bench::ns_per_op(keys.size(),
+                                        [&]
+                                        {
+                                            for (std::uint64_t key : keys)
+                                                insert(key);
+                                        });
+    values.bytes_per_element = double(heap_bytes_in_use() - bytes_before) / double(keys.size());
+    std::size_t found_count = 0;
+    for (std::uint64_t key : lookup_keys)
+        found_count += find(key);
+    values.hit_lookup_ns = bench::ns_per_op(lookup_keys.size(),
+                                            [&]
+                                            {
+                                                for (std::uint64_t key : lookup_keys)
+                                                    found_count += find(key);
+                                            });
+    values.miss_lookup_ns = bench::ns_per_op(missing_keys.size(),
+                                             [&]
+                                             {
+                                                 for (std::uint64_t key : missing_keys)
+                                                     found_count += find(key);
+                                             });
+    bench::do_not_optimize(found_count);
+    return values;
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t element_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    std::mt19937_64 engine(42);
+    std::vector<std::uint64_t> keys(element_count);
+    std::vector<std::uint64_t> missing_keys(element_count);
+    for (std::size_t i = 0; i < element_count; ++i)
+    {
+        keys[i] = engine();
+        missing_keys[i] = engine();
+    }
+    // Looking the keys up in insertion order would favour the containers allocating their nodes in that order.
+    std::vector<std::uint64_t> lookup_keys = keys;
+    std::shuffle(lookup_keys.begin(), lookup_keys.end(), engine);
+
+    {
+        intrusive_set set;
+        measures values = run_benchmark(
+            keys, lookup_keys, missing_keys, [&](std::uint64_t key) { set.emplace(key); },
+            [&](std::uint64_t key) { return set.contains(key); });
+        print_measures("sharable_intrusive_unordered_set", values);
+    }
+    {
+        node_map map;
+        measures values = run_benchmark(
+            keys, lookup_keys, missing_keys,
+            [&](std::uint64_t key) { map.emplace(key, itru::make_shared_intrusive_ptr<map_value>(key)); },
+            [&](std::uint64_t key) { return map.contains(key); });
+        print_measures("std::unordered_map<key, shared_intrusive_ptr>", values);
+    }
+
+    return EXIT_SUCCESS;
+}
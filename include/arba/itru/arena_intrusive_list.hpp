@@ -0,0 +1,128 @@
+#pragma once
+
+#include "node_arena.hpp"
+#include "sharable_intrusive_list.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Owning sharable_intrusive_list whose emplaced nodes are allocated by a node_arena of its own, i.e. in a few large
+// blocks rather than all over the heap. The nodes derive from arena_node_base.
+// After some churn, traversal order and address order diverge: compact() relocates the nodes into a new block, in
+// traversal order, by move construction. Only the nodes referenced by the list alone are relocated: the other ones
+// may be used through pointers which would dangle.
+template <typename IntrusiveT, typename HookAccessorT = base_list_hook_accessor<IntrusiveT>>
+class arena_intrusive_list : public sharable_intrusive_list<IntrusiveT, IntrusiveT, HookAccessorT>
+{
+    using base_type = sharable_intrusive_list<IntrusiveT, IntrusiveT, HookAccessorT>;
+
+    static_assert(std::is_base_of_v<arena_node_base, IntrusiveT>);
+    static_assert(base_type::owns_values);
+
+public:
+    using typename base_type::const_iterator;
+    using typename base_type::iterator;
+    using typename base_type::size_type;
+    using typename base_type::value_siptr_type;
+    using typename base_type::value_type;
+
+    arena_intrusive_list() : arena_(sizeof(value_type), alignof(value_type)) {}
+    arena_intrusive_list(arena_intrusive_list&& other) = default;
+    // The nodes are released before the arena, which then frees its blocks at once.
+    inline ~arena_intrusive_list() { this->clear(); }
+
+    template <class... ArgsT>
+    inline void emplace_front(ArgsT&&... args)
+    {
+        this->push_front(make_node_(std::forward<ArgsT>(args)...));
+    }
+    template <class... ArgsT>
+    inline void emplace_back(ArgsT&&... args)
+    {
+        this->push_back(make_node_(std::forward<ArgsT>(args)...));
+    }
+    template <class... ArgsT>
+    inline const_iterator emplace(const_iterator iter, ArgsT&&... args)
+    {
+        return this->insert(iter, make_node_(std::forward<ArgsT>(args)...));
+    }
+
+    // Relocates the nodes referenced by the list only (no other shared nor latent reference) into a new block, in
+    // traversal order, then releases the blocks left empty. Nodes inserted by push_back() and co. are moved into the
+    // arena too. The block is sized for the nodes found unique by a first pass: nodes released meanwhile by other
+    // threads are left where they are once it is full. Returns the number of relocated nodes.
+    size_type compact();
+
+    inline const node_arena& arena() const noexcept { return arena_; }
+
+private:
+    template <class... ArgsT>
+    value_siptr_type make_node_(ArgsT&&... args)
+    {
+        return construct_(arena_.allocate(), std::forward<ArgsT>(args)...);
+    }
+    template <class... ArgsT>
+    static value_siptr_type construct_(void* slot, ArgsT&&... args)
+    {
+        try
+        {
+            return value_siptr_type(new (slot) value_type(std::forward<ArgsT>(args)...));
+        }
+        catch (...)
+        {
+            node_arena::deallocate(slot);
+            throw;
+        }
+    }
+
+    node_arena arena_;
+};
+
+template <typename IntrusiveT, typename HookAccessorT>
+typename arena_intrusive_list<IntrusiveT, HookAccessorT>::size_type
+arena_intrusive_list<IntrusiveT, HookAccessorT>::compact()
+{
+    size_type count = 0;
+    for (const value_type& value : *this)
+        count += shared_intrusive_ptr_is_unique(&value) ? 1 : 0;
+    if (count == 0)
+        return 0;
+
+    node_arena::block& target = arena_.add_block(count);
+    size_type relocated_count = 0;
+    for (iterator iter = this->begin(), end_iter = this->end(); iter != end_iter && relocated_count < count;)
+    {
+        if (!shared_intrusive_ptr_is_unique(iter.ptr()))
+        {
+            ++iter;
+            continue;
+        }
+        // The node is unlinked before being moved: its hook holds no link anymore, whatever the move constructor
+        // does with it.
+        value_siptr_type node = iter.make_intrusive_shared();
+        iter = this->erase(iter);
+        value_siptr_type relocated;
+        try
+        {
+            relocated = construct_(arena_.allocate(target), std::move(*node));
+        }
+        catch (...)
+        {
+            this->insert(iter, std::move(node));
+            throw;
+        }
+        this->insert(iter, std::move(relocated));
+        ++relocated_count;
+    }
+    arena_.release_empty_blocks();
+    return relocated_count;
+}
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,370 @@
+#pragma once
+
+#include "shared_intrusive_ptr.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+template <typename ElementType, std::size_t chunk_capacity>
+class chunked_siptr_list;
+
+namespace private_
+{
+struct siptr_chunk_links
+{
+    siptr_chunk_links* previous = this;
+    siptr_chunk_links* next = this;
+    std::size_t count = 0;
+};
+} // namespace private_
+
+template <typename ElementType, std::size_t chunk_capacity, bool is_const>
+class chunked_siptr_list_iterator
+{
+public:
+    using value_type = shared_intrusive_ptr<ElementType>;
+    using pointer = std::conditional_t<is_const, const value_type*, value_type*>;
+    using reference = std::conditional_t<is_const, const value_type&, value_type&>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    chunked_siptr_list_iterator() = default;
+    chunked_siptr_list_iterator(const chunked_siptr_list_iterator&) = default;
+    chunked_siptr_list_iterator& operator=(const chunked_siptr_list_iterator&) = default;
+    inline chunked_siptr_list_iterator(const chunked_siptr_list_iterator<ElementType, chunk_capacity, false>& iter)
+        requires is_const
+        : links_(iter.links_), index_(iter.index_)
+    {
+    }
+
+    chunked_siptr_list_iterator& operator++() noexcept
+    {
+        if (++index_ == links_->count)
+        {
+            links_ = links_->next;
+            index_ = 0;
+        }
+        return *this;
+    }
+    chunked_siptr_list_iterator operator++(int) noexcept
+    {
+        chunked_siptr_list_iterator iter(*this);
+        ++(*this);
+        return iter;
+    }
+    chunked_siptr_list_iterator& operator--() noexcept
+    {
+        if (index_ == 0)
+        {
+            links_ = links_->previous;
+            index_ = links_->count;
+        }
+        --index_;
+        return *this;
+    }
+    chunked_siptr_list_iterator operator--(int) noexcept
+    {
+        chunked_siptr_list_iterator iter(*this);
+        --(*this);
+        return iter;
+    }
+
+    inline reference operator*() const noexcept { return chunk_()->elements[index_]; }
+    inline pointer operator->() const noexcept { return &chunk_()->elements[index_]; }
+
+    inline bool operator==(const chunked_siptr_list_iterator& iter) const noexcept = default;
+
+private:
+    using chunk_type = typename chunked_siptr_list<ElementType, chunk_capacity>::chunk;
+
+    inline chunked_siptr_list_iterator(private_::siptr_chunk_links* links, std::size_t index)
+        : links_(links), index_(index)
+    {
+    }
+
+    inline chunk_type* chunk_() const noexcept { return static_cast<chunk_type*>(links_); }
+
+    private_::siptr_chunk_links* links_ = nullptr;
+    std::size_t index_ = 0;
+
+    friend class chunked_siptr_list<ElementType, chunk_capacity>;
+    friend class chunked_siptr_list_iterator<ElementType, chunk_capacity, true>;
+};
+
+// Unrolled list of shared_intrusive_ptr: the pointers are stored by chunks of chunk_capacity, the default capacity
+// making a chunk of two cache lines. It suits elements which cannot carry a hook, or belong to many lists, and is
+// iterated several times faster than a list allocating a node per element.
+// Insertions, erasures and splices relocate the pointers between chunks by swapping them: no counter is touched.
+// A chunk is split when an insertion finds it full, and merged with the next one when an erasure leaves both of
+// them at most half full.
+// Insertions and erasures invalidate the iterators to the elements of the chunks they modify.
+template <typename ElementType, std::size_t chunk_capacity = 13>
+class chunked_siptr_list
+{
+    static_assert(chunk_capacity >= 2);
+
+public:
+    using element_type = ElementType;
+    using value_type = shared_intrusive_ptr<element_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = chunked_siptr_list_iterator<element_type, chunk_capacity, false>;
+    using const_iterator = chunked_siptr_list_iterator<element_type, chunk_capacity, true>;
+
+    chunked_siptr_list() = default;
+    chunked_siptr_list(const chunked_siptr_list& other);
+    inline chunked_siptr_list(chunked_siptr_list&& other) noexcept { splice(end(), other); }
+    inline chunked_siptr_list& operator=(chunked_siptr_list other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+    inline ~chunked_siptr_list() { clear(); }
+
+    inline iterator begin() noexcept { return iterator(sentinel_.next, 0); }
+    inline const_iterator begin() const noexcept { return const_iterator(sentinel_.next, 0); }
+    inline const_iterator cbegin() const noexcept { return begin(); }
+    inline iterator end() noexcept { return iterator(&sentinel_, 0); }
+    inline const_iterator end() const noexcept { return const_iterator(sentinel_links_(), 0); }
+    inline const_iterator cend() const noexcept { return end(); }
+
+    [[nodiscard]] inline bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] inline size_type size() const noexcept { return size_; }
+    // Number of allocated chunks.
+    [[nodiscard]] inline size_type chunk_count() const noexcept { return chunk_count_; }
+
+    inline reference front() noexcept { return *begin(); }
+    inline const_reference front() const noexcept { return *begin(); }
+    inline reference back() noexcept { return *std::prev(end()); }
+    inline const_reference back() const noexcept { return *std::prev(end()); }
+
+    inline void push_front(value_type value) { insert(begin(), std::move(value)); }
+    inline void push_back(value_type value) { insert(end(), std::move(value)); }
+    inline void pop_front() { erase(begin()); }
+    inline void pop_back() { erase(std::prev(end())); }
+
+    iterator insert(const_iterator iter, value_type value);
+    iterator erase(const_iterator iter);
+    void clear() noexcept;
+    void swap(chunked_siptr_list& other) noexcept;
+
+    // Moves the elements of other before iter. At most one chunk is split, the other ones are relinked.
+    void splice(const_iterator iter, chunked_siptr_list& other);
+    inline void splice(const_iterator iter, chunked_siptr_list&& other) { splice(iter, other); }
+
+    template <class UnaryPredicate>
+    size_type remove_if(UnaryPredicate predicate);
+
+private:
+    struct chunk : public private_::siptr_chunk_links
+    {
+        std::array<value_type, chunk_capacity> elements;
+    };
+
+    inline private_::siptr_chunk_links* sentinel_links_() const noexcept
+    {
+        return const_cast<private_::siptr_chunk_links*>(&sentinel_);
+    }
+    inline static chunk* chunk_(private_::siptr_chunk_links* links) noexcept { return static_cast<chunk*>(links); }
+    // Allocates an empty chunk linked after links.
+    chunk* new_chunk_after_(private_::siptr_chunk_links* links);
+    void delete_chunk_(chunk* list_chunk) noexcept;
+    // Moves the elements [index, count) of list_chunk at the end of target.
+    static void move_tail_(chunk* list_chunk, std::size_t index, chunk* target) noexcept;
+
+    private_::siptr_chunk_links sentinel_;
+    size_type size_ = 0;
+    size_type chunk_count_ = 0;
+
+    template <typename, std::size_t, bool>
+    friend class chunked_siptr_list_iterator;
+};
+
+template <typename ElementType, std::size_t chunk_capacity>
+chunked_siptr_list<ElementType, chunk_capacity>::chunked_siptr_list(const chunked_siptr_list& other)
+{
+    for (const value_type& value : other)
+        push_back(value);
+}
+
+template <typename ElementType, std::size_t chunk_capacity>
+typename chunked_siptr_list<ElementType, chunk_capacity>::iterator
+chunked_siptr_list<ElementType, chunk_capacity>::insert(const_iterator iter, value_type value)
+{
+    private_::siptr_chunk_links* links = iter.links_;
+    std::size_t index = iter.index_;
+    // Before the first element of a chunk, or at the end: the previous chunk is preferred when it has room.
+    if (index == 0 && links->previous != &sentinel_ && links->previous->count < chunk_capacity)
+    {
+        links = links->previous;
+        index = links->count;
+    }
+    else if (links == &sentinel_)
+    {
+        links = new_chunk_after_(sentinel_.previous);
+        index = 0;
+    }
+    chunk* list_chunk = chunk_(links);
+    if (list_chunk->count == chunk_capacity)
+    {
+        chunk* next_chunk = new_chunk_after_(list_chunk);
+        move_tail_(list_chunk, chunk_capacity / 2, next_chunk);
+        if (index > list_chunk->count)
+        {
+            index -= list_chunk->count;
+            list_chunk = next_chunk;
+        }
+    }
+    for (std::size_t i = list_chunk->count; i > index; --i)
+        list_chunk->elements[i].swap(list_chunk->elements[i - 1]);
+    list_chunk->elements[index] = std::move(value);
+    ++list_chunk->count;
+    ++size_;
+    return iterator(list_chunk, index);
+}
+
+template <typename ElementType, std::size_t chunk_capacity>
+typename chunked_siptr_list<ElementType, chunk_capacity>::iterator
+chunked_siptr_list<ElementType, chunk_capacity>::erase(const_iterator iter)
+{
+    chunk* list_chunk = chunk_(iter.links_);
+    const std::size_t index = iter.index_;
+    assert(list_chunk != &sentinel_ && index < list_chunk->count);
+    value_type erased = std::move(list_chunk->elements[index]);
+    for (std::size_t i = index + 1; i < list_chunk->count; ++i)
+        list_chunk->elements[i - 1].swap(list_chunk->elements[i]);
+    --list_chunk->count;
+    --size_;
+
+    private_::siptr_chunk_links* next_links = list_chunk->next;
+    if (list_chunk->count == 0)
+    {
+        delete_chunk_(list_chunk);
+        return iterator(next_links, 0);
+    }
+    if (next_links != &sentinel_ && list_chunk->count + next_links->count <= chunk_capacity / 2)
+    {
+        move_tail_(chunk_(next_links), 0, list_chunk);
+        delete_chunk_(chunk_(next_links));
+    }
+    if (index < list_chunk->count)
+        return iterator(list_chunk, index);
+    return iterator(list_chunk->next, 0);
+}
+
+template <typename ElementType, std::size_t chunk_capacity>
+void chunked_siptr_list<ElementType, chunk_capacity>::clear() noexcept
+{
+    while (sentinel_.next != &sentinel_)
+        delete_chunk_(chunk_(sentinel_.next));
+    size_ = 0;
+}
+
+template <typename ElementType, std::size_t chunk_capacity>
+void chunked_siptr_list<ElementType, chunk_capacity>::swap(chunked_siptr_list& other) noexcept
+{
+    chunked_siptr_list aux;
+    aux.splice(aux.end(), other);
+    other.splice(other.end(), *this);
+    splice(end(), aux);
+}
+
+template <typename ElementType, std::size_t chunk_capacity>
+void chunked_siptr_list<ElementType, chunk_capacity>::splice(const_iterator iter, chunked_siptr_list& other)
+{
+    if (other.empty() || &other == this)
+        return;
+    private_::siptr_chunk_links* next_links = iter.links_;
+    if (iter.index_ > 0)
+    {
+        chunk* list_chunk = chunk_(iter.links_);
+        next_links = new_chunk_after_(list_chunk);
+        move_tail_(list_chunk, iter.index_, chunk_(next_links));
+    }
+    private_::siptr_chunk_links* first = other.sentinel_.next;
+    private_::siptr_chunk_links* last = other.sentinel_.previous;
+    other.sentinel_.next = other.sentinel_.previous = &other.sentinel_;
+    first->previous = next_links->previous;
+    next_links->previous->next = first;
+    last->next = next_links;
+    next_links->previous = last;
+    size_ += std::exchange(other.size_, 0);
+    chunk_count_ += std::exchange(other.chunk_count_, 0);
+}
+
+template <typename ElementType, std::size_t chunk_capacity>
+template <class UnaryPredicate>
+typename chunked_siptr_list<ElementType, chunk_capacity>::size_type
+chunked_siptr_list<ElementType, chunk_capacity>::remove_if(UnaryPredicate predicate)
+{
+    // Chunk by chunk, the kept elements are compacted in place, then the empty chunks are released.
+    size_type count = 0;
+    for (private_::siptr_chunk_links* links = sentinel_.next; links != &sentinel_;)
+    {
+        chunk* list_chunk = chunk_(links);
+        links = links->next;
+        std::size_t kept_count = 0;
+        for (std::size_t i = 0; i < list_chunk->count; ++i)
+        {
+            value_type& value = list_chunk->elements[i];
+            if (predicate(std::as_const(value)))
+                value = nullptr;
+            else
+                list_chunk->elements[kept_count++].swap(value);
+        }
+        count += list_chunk->count - kept_count;
+        size_ -= list_chunk->count - kept_count;
+        list_chunk->count = kept_count;
+        if (kept_count == 0)
+            delete_chunk_(list_chunk);
+    }
+    return count;
+}
+
+template <typename ElementType, std::size_t chunk_capacity>
+typename chunked_siptr_list<ElementType, chunk_capacity>::chunk*
+chunked_siptr_list<ElementType, chunk_capacity>::new_chunk_after_(private_::siptr_chunk_links* links)
+{
+    chunk* list_chunk = new chunk();
+    list_chunk->previous = links;
+    list_chunk->next = links->next;
+    links->next->previous = list_chunk;
+    links->next = list_chunk;
+    ++chunk_count_;
+    return list_chunk;
+}
+
+template <typename ElementType, std::size_t chunk_capacity>
+void chunked_siptr_list<ElementType, chunk_capacity>::delete_chunk_(chunk* list_chunk) noexcept
+{
+    list_chunk->previous->next = list_chunk->next;
+    list_chunk->next->previous = list_chunk->previous;
+    --chunk_count_;
+    delete list_chunk;
+}
+
+template <typename ElementType, std::size_t chunk_capacity>
+void chunked_siptr_list<ElementType, chunk_capacity>::move_tail_(chunk* list_chunk, std::size_t index,
+                                                                 chunk* target) noexcept
+{
+    assert(target->count + list_chunk->count - index <= chunk_capacity);
+    std::swap_ranges(list_chunk->elements.begin() + index, list_chunk->elements.begin() + list_chunk->count,
+                     target->elements.begin() + target->count);
+    target->count += list_chunk->count - index;
+    list_chunk->count = index;
+}
+
+} // namespace itru
+} // namespace arba
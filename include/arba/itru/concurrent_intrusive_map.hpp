@@ -0,0 +1,412 @@
+#pragma once
+
+#include "concurrent_intrusive_map_hook.hpp"
+#include "epoch_reclaimer.hpp"
+#include "key_of.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Concurrent hash map of shared_intrusive_ptr threaded through the concurrent_intrusive_map_hook embedded in
+// IntrusiveT, and keyed by the key KeyOfT extracts from an element.
+// Lookups take no lock and never write to shared memory: while the bucket of the key is migrated, they search it,
+// then its target bucket. insert and erase lock the bucket of the key only.
+// When the map grows, the buckets of the previous table are migrated a few at a time by the following insertions
+// and erasures, so no writer pays for a whole rehash.
+// The map holds one shared reference on each element. The reference of an erased element is released through the
+// epoch_reclaimer, once no concurrent reader can reach it anymore.
+// The key of an element must not change while it is in the map. An extracted element must not be inserted again
+// before a grace period has passed (epoch_reclaimer::synchronize()): until then, concurrent readers may still follow
+// its hook, which insert overwrites.
+template <typename IntrusiveT, typename KeyOfT, typename HashT = std::hash<key_of_result_t<IntrusiveT, KeyOfT>>,
+          typename KeyEqualT = std::equal_to<key_of_result_t<IntrusiveT, KeyOfT>>>
+class concurrent_intrusive_map
+{
+public:
+    using key_type = key_of_result_t<IntrusiveT, KeyOfT>;
+    using value_type = IntrusiveT;
+    using size_type = std::size_t;
+    using hasher = HashT;
+    using key_equal = KeyEqualT;
+    using reference = std::add_lvalue_reference_t<value_type>;
+    using const_reference = std::add_lvalue_reference_t<std::add_const_t<value_type>>;
+    using pointer = std::add_pointer_t<value_type>;
+    using const_pointer = std::add_pointer_t<std::add_const_t<value_type>>;
+    using value_siptr_type = shared_intrusive_ptr<value_type>;
+    using hook_type = concurrent_map_hook_t<value_type>;
+
+    static constexpr size_type initial_bucket_count = 16;
+    static constexpr size_type rehash_step_bucket_count = 2;
+
+    concurrent_intrusive_map() : concurrent_intrusive_map(initial_bucket_count) {}
+    explicit concurrent_intrusive_map(size_type bucket_count, const hasher& hash = hasher(),
+                                      const key_equal& equal = key_equal(), const KeyOfT& key_of = KeyOfT())
+        : table_(new table(std::bit_ceil(std::max<size_type>(bucket_count, 1)))), hash_function_(hash),
+          key_equal_(equal), key_of_(key_of)
+    {
+    }
+    concurrent_intrusive_map(const concurrent_intrusive_map&) = delete;
+    concurrent_intrusive_map& operator=(const concurrent_intrusive_map&) = delete;
+    // Must not run concurrently with any other operation on the map.
+    ~concurrent_intrusive_map();
+
+    // Exact when the map is not being modified.
+    [[nodiscard]] inline size_type size() const noexcept { return size_.load(std::memory_order_relaxed); }
+    [[nodiscard]] inline bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] inline size_type bucket_count() const noexcept { return table_.load()->bucket_count; }
+
+    // Returns false, leaving the map unchanged, if an element with an equivalent key is already in the map.
+    bool insert(value_siptr_type value);
+    template <class... ArgsT>
+    inline bool emplace(ArgsT&&... args)
+    {
+        return insert(make_shared_intrusive_ptr<value_type>(std::forward<ArgsT>(args)...));
+    }
+
+    // The returned element can be inserted again once epoch_reclaimer::synchronize() has returned.
+    value_siptr_type extract(const key_type& key);
+    inline bool erase(const key_type& key) { return extract(key) != nullptr; }
+
+    [[nodiscard]] value_siptr_type find(const key_type& key) const;
+    [[nodiscard]] bool contains(const key_type& key) const;
+
+private:
+    using link_type = typename hook_type::link_type;
+
+    enum class bucket_state : unsigned char
+    {
+        normal,
+        migrating,
+        migrated
+    };
+
+    struct bucket
+    {
+        link_type head = nullptr;
+        std::atomic<bucket_state> state = bucket_state::normal;
+        std::atomic<bool> locked = false;
+    };
+
+    class bucket_lock
+    {
+    public:
+        explicit bucket_lock(bucket& locked_bucket) : bucket_(locked_bucket)
+        {
+            while (bucket_.locked.exchange(true, std::memory_order_acquire))
+                bucket_.locked.wait(true, std::memory_order_relaxed);
+        }
+        bucket_lock(const bucket_lock&) = delete;
+        bucket_lock& operator=(const bucket_lock&) = delete;
+        ~bucket_lock()
+        {
+            bucket_.locked.store(false, std::memory_order_release);
+            bucket_.locked.notify_one();
+        }
+
+    private:
+        bucket& bucket_;
+    };
+
+    struct table
+    {
+        explicit table(size_type count) : buckets(new bucket[count]), bucket_count(count) {}
+
+        inline bucket& bucket_of(std::size_t hash) const noexcept { return buckets[hash & (bucket_count - 1)]; }
+
+        std::unique_ptr<bucket[]> buckets;
+        size_type bucket_count;
+        // Table whose buckets are being migrated into this one.
+        std::atomic<table*> previous = nullptr;
+        std::atomic<size_type> migration_cursor = 0;
+        std::atomic<size_type> migrated_count = 0;
+    };
+
+    inline static hook_type& hook_(reference value) noexcept { return static_cast<hook_type&>(value); }
+    inline bool matches_(pointer node, std::size_t hash, const key_type& key) const
+    {
+        return hook_(*node).hash_code() == hash && key_equal_(key_of_(*node), key);
+    }
+
+    // Searches the bucket without locking it. If the bucket is being migrated meanwhile, the elements it misses are in
+    // the target table.
+    pointer scan_(const bucket& scanned_bucket, std::size_t hash, const key_type& key) const;
+    pointer find_node_(std::size_t hash, const key_type& key) const;
+    // Calls function on the bucket holding the elements of hash, i.e. the one of the previous table if it is not
+    // migrated yet, while it is locked.
+    template <class FunctionT>
+    auto apply_on_locked_bucket_(std::size_t hash, FunctionT function);
+    // The two functions below are called while the bucket is locked.
+    bool link_(bucket& locked_bucket, pointer node, std::size_t hash, const key_type& key);
+    pointer unlink_(bucket& locked_bucket, std::size_t hash, const key_type& key);
+    void grow_();
+    void migrate_step_();
+    void migrate_bucket_(table& target, bucket& migrated_bucket);
+    static void release_elements_(table& released_table) noexcept;
+
+    std::atomic<table*> table_;
+    std::atomic<size_type> size_ = 0;
+    std::mutex resize_mutex_;
+    [[no_unique_address]] hasher hash_function_;
+    [[no_unique_address]] key_equal key_equal_;
+    [[no_unique_address]] KeyOfT key_of_;
+};
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::~concurrent_intrusive_map()
+{
+    table* current = table_.load();
+    if (table* old = current->previous.load())
+    {
+        release_elements_(*old);
+        delete old;
+    }
+    release_elements_(*current);
+    delete current;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+bool concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::insert(value_siptr_type value)
+{
+    pointer node = value.get();
+    const key_type& key = key_of_(*node);
+    const std::size_t hash = hash_function_(key);
+
+    epoch_guard guard;
+    migrate_step_();
+    const bool inserted =
+        apply_on_locked_bucket_(hash, [&](bucket& locked_bucket) { return link_(locked_bucket, node, hash, key); });
+    if (!inserted)
+        return false;
+    if (size_.fetch_add(1, std::memory_order_relaxed) + 1 > table_.load()->bucket_count)
+        grow_();
+    return true;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+typename concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::value_siptr_type
+concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::extract(const key_type& key)
+{
+    const std::size_t hash = hash_function_(key);
+
+    epoch_guard guard;
+    migrate_step_();
+    pointer node =
+        apply_on_locked_bucket_(hash, [&](bucket& locked_bucket) { return unlink_(locked_bucket, hash, key); });
+    if (!node)
+        return nullptr;
+    value_siptr_type value(node);
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    epoch_reclaimer::retire_shared(node);
+    return value;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+typename concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::value_siptr_type
+concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::find(const key_type& key) const
+{
+    epoch_guard guard;
+    return value_siptr_type(find_node_(hash_function_(key), key));
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+bool concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::contains(const key_type& key) const
+{
+    epoch_guard guard;
+    return find_node_(hash_function_(key), key) != nullptr;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+typename concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::pointer
+concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::scan_(const bucket& scanned_bucket, std::size_t hash,
+                                                                      const key_type& key) const
+{
+    // A migrated element is relinked in front of a target bucket: the scan may go on in that bucket, after the
+    // elements which were behind it, all migrated before it (see migrate_bucket_()).
+    pointer node = scanned_bucket.head.load();
+    while (node && !matches_(node, hash, key))
+        node = hook_(*node).bucket_next().load();
+    return node;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+typename concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::pointer
+concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::find_node_(std::size_t hash,
+                                                                           const key_type& key) const
+{
+    for (;;)
+    {
+        const table* current = table_.load();
+        const table* old = current->previous.load();
+        pointer node = nullptr;
+        // The elements leaving the old bucket are linked in the current table before they are unlinked from the old
+        // bucket: searching the current table afterwards finds the ones the first scan missed.
+        if (old && old->bucket_of(hash).state.load() != bucket_state::migrated)
+            node = scan_(old->bucket_of(hash), hash, key);
+        const bucket& current_bucket = current->bucket_of(hash);
+        if (!node)
+            node = scan_(current_bucket, hash, key);
+        // A miss is only searched again if the current table has been replaced meanwhile, and the bucket has started
+        // migrating into the new one.
+        if (node || current_bucket.state.load() == bucket_state::normal)
+            return node;
+    }
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+template <class FunctionT>
+auto concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::apply_on_locked_bucket_(std::size_t hash,
+                                                                                             FunctionT function)
+{
+    for (;;)
+    {
+        table* current = table_.load();
+        if (table* old = current->previous.load())
+        {
+            bucket& old_bucket = old->bucket_of(hash);
+            bucket_lock lock(old_bucket);
+            if (old_bucket.state.load() == bucket_state::normal)
+                return function(old_bucket);
+        }
+        // The bucket is not migrated as long as it is locked: if it is normal, it holds the elements of hash.
+        bucket& current_bucket = current->bucket_of(hash);
+        bucket_lock lock(current_bucket);
+        if (current_bucket.state.load() == bucket_state::normal)
+            return function(current_bucket);
+    }
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+bool concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::link_(bucket& locked_bucket, pointer node,
+                                                                           std::size_t hash, const key_type& key)
+{
+    for (pointer curr = locked_bucket.head.load(); curr; curr = hook_(*curr).bucket_next().load())
+    {
+        if (matches_(curr, hash, key))
+            return false;
+    }
+    // Written only once no duplicate was found: node may already be in the map, read by lock-free lookups.
+    hook_(*node).hash_code() = hash;
+    shared_intrusive_ptr_add_ref(node);
+    hook_(*node).bucket_next().store(locked_bucket.head.load());
+    locked_bucket.head.store(node);
+    return true;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+typename concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::pointer
+concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::unlink_(bucket& locked_bucket, std::size_t hash,
+                                                                        const key_type& key)
+{
+    link_type* link = &locked_bucket.head;
+    for (pointer curr = link->load(); curr; curr = link->load())
+    {
+        // The link of curr is left as is: a concurrent reader standing on curr goes on with its next element.
+        if (matches_(curr, hash, key))
+        {
+            link->store(hook_(*curr).bucket_next().load());
+            return curr;
+        }
+        link = &hook_(*curr).bucket_next();
+    }
+    return nullptr;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+void concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::grow_()
+{
+    std::unique_lock lock(resize_mutex_, std::try_to_lock);
+    if (!lock.owns_lock())
+        return;
+    // A new table is only created once the previous migration is complete.
+    table* current = table_.load();
+    if (current->previous.load() || size() <= current->bucket_count)
+        return;
+    table* next = new table(current->bucket_count * 2);
+    next->previous.store(current);
+    table_.store(next);
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+void concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::migrate_step_()
+{
+    table* current = table_.load();
+    table* old = current->previous.load();
+    if (!old)
+        return;
+    for (size_type step = 0; step < rehash_step_bucket_count; ++step)
+    {
+        const size_type index = old->migration_cursor.fetch_add(1);
+        if (index >= old->bucket_count)
+            return;
+        migrate_bucket_(*current, old->buckets[index]);
+        if (old->migrated_count.fetch_add(1) + 1 == old->bucket_count)
+        {
+            current->previous.store(nullptr);
+            epoch_reclaimer::retire(old, [](void* table_ptr) { delete static_cast<table*>(table_ptr); });
+            return;
+        }
+    }
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+void concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::migrate_bucket_(table& target,
+                                                                                     bucket& migrated_bucket)
+{
+    // The target buckets are locked after the migrated one; writers never lock two buckets.
+    bucket_lock lock(migrated_bucket);
+    migrated_bucket.state.store(bucket_state::migrating);
+    // The last element is migrated first, and unlinked once linked in its target bucket: a concurrent reader
+    // leaving the bucket through a migrated element has seen every element still in the bucket. Buckets are short,
+    // so looking for the last element each time is cheap.
+    for (pointer node = migrated_bucket.head.load(); node; node = migrated_bucket.head.load())
+    {
+        link_type* link = &migrated_bucket.head;
+        for (pointer next = hook_(*node).bucket_next().load(); next; next = hook_(*node).bucket_next().load())
+        {
+            link = &hook_(*node).bucket_next();
+            node = next;
+        }
+        bucket& target_bucket = target.bucket_of(hook_(*node).hash_code());
+        {
+            bucket_lock target_lock(target_bucket);
+            hook_(*node).bucket_next().store(target_bucket.head.load());
+            target_bucket.head.store(node);
+        }
+        link->store(nullptr);
+    }
+    migrated_bucket.state.store(bucket_state::migrated);
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT>
+void concurrent_intrusive_map<IntrusiveT, KeyOfT, HashT, KeyEqualT>::release_elements_(table& released_table) noexcept
+{
+    for (size_type index = 0; index < released_table.bucket_count; ++index)
+    {
+        bucket& released_bucket = released_table.buckets[index];
+        if (released_bucket.state.load() == bucket_state::migrated)
+            continue;
+        for (pointer node = released_bucket.head.load(); node;)
+        {
+            pointer next = hook_(*node).bucket_next().load();
+            shared_intrusive_ptr_release(node);
+            node = next;
+        }
+    }
+}
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Bucket link of a concurrent_intrusive_map element, and the hash code of its key, kept to migrate the element when
+// the map grows.
+template <typename IntrusiveMapNodeT>
+class concurrent_intrusive_map_hook
+{
+public:
+    using link_type = std::atomic<IntrusiveMapNodeT*>;
+
+    concurrent_intrusive_map_hook() = default;
+    // A copied element is not linked in the map of the original one.
+    inline concurrent_intrusive_map_hook(const concurrent_intrusive_map_hook&) noexcept {}
+    inline concurrent_intrusive_map_hook& operator=(const concurrent_intrusive_map_hook&) noexcept { return *this; }
+
+    inline const link_type& bucket_next() const noexcept { return bucket_next_; }
+    inline link_type& bucket_next() noexcept { return bucket_next_; }
+    inline std::size_t hash_code() const noexcept { return hash_code_; }
+    inline std::size_t& hash_code() noexcept { return hash_code_; }
+
+private:
+    link_type bucket_next_ = nullptr;
+    std::size_t hash_code_ = 0;
+};
+
+template <typename IntrusiveMapNodeT>
+concurrent_intrusive_map_hook<IntrusiveMapNodeT>*
+concurrent_map_hook_base(const concurrent_intrusive_map_hook<IntrusiveMapNodeT>*);
+
+template <typename IntrusiveT>
+using concurrent_map_hook_t =
+    std::remove_pointer_t<decltype(concurrent_map_hook_base(std::declval<IntrusiveT*>()))>;
+
+} // namespace itru
+} // namespace arba
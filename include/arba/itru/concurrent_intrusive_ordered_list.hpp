@@ -0,0 +1,316 @@
+#pragma once
+
+#include "concurrent_intrusive_ordered_list_hook.hpp"
+#include "epoch_reclaimer.hpp"
+#include "key_of.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Lock-free ordered set of shared_intrusive_ptr (Harris-Michael list) threaded through the
+// concurrent_intrusive_ordered_list_hook embedded in IntrusiveT. Lookups are in O(n): it is meant for small sets, for
+// which a concurrent_intrusive_skip_list would be overkill. insert, erase and the lookups can be called concurrently.
+// The list holds one shared reference on each element. An erased element is marked then unlinked, and the reference
+// of the list is released through the epoch_reclaimer, once no concurrent reader can reach it anymore.
+// The key of an element must not change while it is in the list, and an erased element must not be inserted again.
+template <typename IntrusiveT, typename KeyOfT, typename CompareT = std::less<key_of_result_t<IntrusiveT, KeyOfT>>>
+class concurrent_intrusive_ordered_list
+{
+public:
+    using key_type = key_of_result_t<IntrusiveT, KeyOfT>;
+    using value_type = IntrusiveT;
+    using size_type = std::size_t;
+    using key_compare = CompareT;
+    using reference = std::add_lvalue_reference_t<value_type>;
+    using const_reference = std::add_lvalue_reference_t<std::add_const_t<value_type>>;
+    using pointer = std::add_pointer_t<value_type>;
+    using const_pointer = std::add_pointer_t<std::add_const_t<value_type>>;
+    using value_siptr_type = shared_intrusive_ptr<value_type>;
+    using hook_type = ordered_list_hook_t<value_type>;
+
+    // Forward iterator holding a shared reference on the current element, hence valid whatever the concurrent
+    // modifications. Incrementing it from an element erased meanwhile goes to the first element of greater key.
+    // Elements inserted or erased during the traversal may be visited or not.
+    class iterator
+    {
+    public:
+        using value_type = IntrusiveT;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::add_lvalue_reference_t<value_type>;
+        using pointer = std::add_pointer_t<value_type>;
+        using iterator_category = std::forward_iterator_tag;
+
+        iterator() = default;
+
+        inline reference operator*() const noexcept { return *node_; }
+        inline pointer operator->() const noexcept { return node_.get(); }
+        inline pointer ptr() const noexcept { return node_.get(); }
+        inline const value_siptr_type& siptr() const noexcept { return node_; }
+
+        iterator& operator++()
+        {
+            epoch_guard guard;
+            const std::uintptr_t next = next_(node_.get()).load();
+            pointer node = is_marked_(next) ? list_->search_node_(list_->key_of_(*node_), true)
+                                            : first_unmarked_(node_of_(next));
+            node_ = value_siptr_type(node);
+            return *this;
+        }
+        inline iterator operator++(int)
+        {
+            iterator iter(*this);
+            ++(*this);
+            return iter;
+        }
+
+        inline bool operator==(const iterator& iter) const noexcept { return node_ == iter.node_; }
+
+    private:
+        inline iterator(const concurrent_intrusive_ordered_list* list, pointer node) : list_(list), node_(node) {}
+
+        const concurrent_intrusive_ordered_list* list_ = nullptr;
+        value_siptr_type node_;
+
+        friend class concurrent_intrusive_ordered_list;
+    };
+
+    concurrent_intrusive_ordered_list() = default;
+    explicit concurrent_intrusive_ordered_list(const key_compare& comp, const KeyOfT& key_of = KeyOfT())
+        : comp_(comp), key_of_(key_of)
+    {
+    }
+    concurrent_intrusive_ordered_list(const concurrent_intrusive_ordered_list&) = delete;
+    concurrent_intrusive_ordered_list& operator=(const concurrent_intrusive_ordered_list&) = delete;
+
+    // Must not run concurrently with any other operation on the list.
+    ~concurrent_intrusive_ordered_list()
+    {
+        pointer node = node_of_(head_.load(std::memory_order_acquire));
+        while (node)
+        {
+            const std::uintptr_t next = next_(node).load(std::memory_order_acquire);
+            pointer next_node = node_of_(next);
+            // A marked element has already been retired by the thread which erased it.
+            if (!is_marked_(next))
+                shared_intrusive_ptr_release(node);
+            node = next_node;
+        }
+    }
+
+    // Exact when the list is not being modified.
+    [[nodiscard]] inline size_type size() const noexcept { return size_.load(std::memory_order_relaxed); }
+    [[nodiscard]] inline bool empty() const noexcept { return size() == 0; }
+
+    iterator begin() const
+    {
+        epoch_guard guard;
+        return iterator(this, first_unmarked_(node_of_(head_.load())));
+    }
+    inline iterator end() const noexcept { return iterator(); }
+
+    // Returns false, leaving the list unchanged, if an element with an equivalent key is already in the list.
+    bool insert(value_siptr_type value);
+    template <class... ArgsT>
+    inline bool emplace(ArgsT&&... args)
+    {
+        return insert(make_shared_intrusive_ptr<value_type>(std::forward<ArgsT>(args)...));
+    }
+
+    value_siptr_type extract(const key_type& key);
+    inline bool erase(const key_type& key) { return extract(key) != nullptr; }
+
+    [[nodiscard]] value_siptr_type find(const key_type& key) const;
+    [[nodiscard]] bool contains(const key_type& key) const;
+    // First element whose key is not less than key.
+    [[nodiscard]] iterator lower_bound(const key_type& key) const;
+
+    // Visits the elements in key order. An element erased or inserted during the visit may be visited or not.
+    // The visited reference is only guaranteed to be valid during the call of function.
+    template <class FunctionT>
+    void for_each(FunctionT function) const;
+
+    inline key_compare key_comp() const { return comp_; }
+
+private:
+    using link_type = typename hook_type::link_type;
+
+    static constexpr std::uintptr_t mark_bit = 1;
+
+    inline static pointer node_of_(std::uintptr_t link) noexcept { return reinterpret_cast<pointer>(link & ~mark_bit); }
+    inline static std::uintptr_t link_of_(pointer node) noexcept { return reinterpret_cast<std::uintptr_t>(node); }
+    inline static bool is_marked_(std::uintptr_t link) noexcept { return (link & mark_bit) != 0; }
+    inline static link_type& next_(pointer node) noexcept { return static_cast<hook_type&>(*node).next(); }
+    inline bool less_(pointer node, const key_type& key) const { return comp_(key_of_(*node), key); }
+    inline bool equivalent_(pointer node, const key_type& key) const
+    {
+        return node && !comp_(key, key_of_(*node)) && !less_(node, key);
+    }
+    // node, or the first element after it which is not being erased.
+    inline static pointer first_unmarked_(pointer node) noexcept
+    {
+        while (node && is_marked_(next_(node).load()))
+            node = node_of_(next_(node).load());
+        return node;
+    }
+
+    // Finds the link preceding the first element not less than key, and this element, unlinking on its way the
+    // marked elements. Returns true if the element has a key equivalent to key.
+    bool find_(const key_type& key, link_type*& pred, pointer& curr);
+    // Same search without helping the erasures: marked elements are skipped. Used by the readers.
+    // Returns the first element whose key is greater than key if upper is true, not less than key otherwise.
+    pointer search_node_(const key_type& key, bool upper) const;
+
+    link_type head_ = 0;
+    std::atomic<size_type> size_ = 0;
+    [[no_unique_address]] key_compare comp_;
+    [[no_unique_address]] KeyOfT key_of_;
+};
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+bool concurrent_intrusive_ordered_list<IntrusiveT, KeyOfT, CompareT>::insert(value_siptr_type value)
+{
+    pointer node = value.get();
+    const key_type& key = key_of_(*node);
+    link_type* pred = nullptr;
+    pointer succ = nullptr;
+
+    epoch_guard guard;
+    for (;;)
+    {
+        if (find_(key, pred, succ))
+            return false;
+        next_(node).store(link_of_(succ), std::memory_order_relaxed);
+        std::uintptr_t expected = link_of_(succ);
+        if (pred->compare_exchange_strong(expected, link_of_(node)))
+            break;
+    }
+    shared_intrusive_ptr_add_ref(node);
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+typename concurrent_intrusive_ordered_list<IntrusiveT, KeyOfT, CompareT>::value_siptr_type
+concurrent_intrusive_ordered_list<IntrusiveT, KeyOfT, CompareT>::extract(const key_type& key)
+{
+    link_type* pred = nullptr;
+    pointer node = nullptr;
+
+    epoch_guard guard;
+    for (;;)
+    {
+        if (!find_(key, pred, node))
+            return nullptr;
+        std::uintptr_t next = next_(node).load();
+        while (!is_marked_(next))
+        {
+            if (!next_(node).compare_exchange_weak(next, next | mark_bit))
+                continue;
+            value_siptr_type value(node);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            // If the element cannot be unlinked directly, a new search unlinks it.
+            std::uintptr_t expected = link_of_(node);
+            if (!pred->compare_exchange_strong(expected, next))
+                find_(key, pred, node);
+            epoch_reclaimer::retire_shared(value.get());
+            return value;
+        }
+        // Marked by another thread: the search is done again, as an equivalent element may have been inserted since.
+    }
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+typename concurrent_intrusive_ordered_list<IntrusiveT, KeyOfT, CompareT>::value_siptr_type
+concurrent_intrusive_ordered_list<IntrusiveT, KeyOfT, CompareT>::find(const key_type& key) const
+{
+    epoch_guard guard;
+    pointer node = search_node_(key, false);
+    return equivalent_(node, key) ? value_siptr_type(node) : nullptr;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+bool concurrent_intrusive_ordered_list<IntrusiveT, KeyOfT, CompareT>::contains(const key_type& key) const
+{
+    epoch_guard guard;
+    return equivalent_(search_node_(key, false), key);
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+typename concurrent_intrusive_ordered_list<IntrusiveT, KeyOfT, CompareT>::iterator
+concurrent_intrusive_ordered_list<IntrusiveT, KeyOfT, CompareT>::lower_bound(const key_type& key) const
+{
+    epoch_guard guard;
+    return iterator(this, search_node_(key, false));
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+template <class FunctionT>
+void concurrent_intrusive_ordered_list<IntrusiveT, KeyOfT, CompareT>::for_each(FunctionT function) const
+{
+    epoch_guard guard;
+    for (pointer node = node_of_(head_.load()); node;)
+    {
+        const std::uintptr_t next = next_(node).load();
+        if (!is_marked_(next))
+            std::invoke(function, *node);
+        node = node_of_(next);
+    }
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+bool concurrent_intrusive_ordered_list<IntrusiveT, KeyOfT, CompareT>::find_(const key_type& key, link_type*& pred,
+                                                                            pointer& curr)
+{
+retry:
+    pred = &head_;
+    curr = node_of_(pred->load());
+    while (curr)
+    {
+        const std::uintptr_t next = next_(curr).load();
+        if (is_marked_(next))
+        {
+            std::uintptr_t expected = link_of_(curr);
+            if (!pred->compare_exchange_strong(expected, next & ~mark_bit))
+                goto retry;
+            curr = node_of_(next);
+        }
+        else if (less_(curr, key))
+        {
+            pred = &next_(curr);
+            curr = node_of_(next);
+        }
+        else
+            break;
+    }
+    return equivalent_(curr, key);
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+typename concurrent_intrusive_ordered_list<IntrusiveT, KeyOfT, CompareT>::pointer
+concurrent_intrusive_ordered_list<IntrusiveT, KeyOfT, CompareT>::search_node_(const key_type& key, bool upper) const
+{
+    pointer curr = node_of_(head_.load());
+    while (curr)
+    {
+        const std::uintptr_t next = next_(curr).load();
+        if (is_marked_(next) || less_(curr, key) || (upper && !comp_(key, key_of_(*curr))))
+            curr = node_of_(next);
+        else
+            break;
+    }
+    return curr;
+}
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Next link of a concurrent_intrusive_ordered_list element. The lowest bit of the link marks the element as being
+// erased: a marked link is never modified anymore.
+template <typename IntrusiveOrderedListNodeT>
+class concurrent_intrusive_ordered_list_hook
+{
+public:
+    using link_type = std::atomic<std::uintptr_t>;
+
+    concurrent_intrusive_ordered_list_hook() = default;
+    // A copied element is not linked in the list of the original one.
+    inline concurrent_intrusive_ordered_list_hook(const concurrent_intrusive_ordered_list_hook&) noexcept {}
+    inline concurrent_intrusive_ordered_list_hook& operator=(const concurrent_intrusive_ordered_list_hook&) noexcept
+    {
+        return *this;
+    }
+
+    inline const link_type& next() const noexcept { return next_; }
+    inline link_type& next() noexcept { return next_; }
+
+private:
+    link_type next_ = 0;
+};
+
+template <typename IntrusiveOrderedListNodeT>
+concurrent_intrusive_ordered_list_hook<IntrusiveOrderedListNodeT>*
+ordered_list_hook_base(const concurrent_intrusive_ordered_list_hook<IntrusiveOrderedListNodeT>*);
+
+template <typename IntrusiveT>
+using ordered_list_hook_t = std::remove_pointer_t<decltype(ordered_list_hook_base(std::declval<IntrusiveT*>()))>;
+
+} // namespace itru
+} // namespace arba
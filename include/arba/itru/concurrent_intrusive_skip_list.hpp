@@ -0,0 +1,360 @@
+#pragma once
+
+#include "concurrent_intrusive_skip_list_hook.hpp"
+#include "epoch_reclaimer.hpp"
+#include "key_of.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Lock-free ordered set of shared_intrusive_ptr threaded through the concurrent_intrusive_skip_list_hook embedded in
+// IntrusiveT. insert, erase and the lookups can be called concurrently; the lookups never write to shared memory.
+// The list holds one shared reference on each element. An erased element is marked then unlinked, and the reference
+// of the list is released through the epoch_reclaimer, once no concurrent reader can reach it anymore. An element
+// erased while its insertion still links its upper levels is retired by whichever of both operations ends last.
+// The key of an element must not change while it is in the list, and an erased element must not be inserted again.
+template <typename IntrusiveT, typename KeyOfT, typename CompareT = std::less<key_of_result_t<IntrusiveT, KeyOfT>>>
+class concurrent_intrusive_skip_list
+{
+public:
+    using key_type = key_of_result_t<IntrusiveT, KeyOfT>;
+    using value_type = IntrusiveT;
+    using size_type = std::size_t;
+    using key_compare = CompareT;
+    using reference = std::add_lvalue_reference_t<value_type>;
+    using const_reference = std::add_lvalue_reference_t<std::add_const_t<value_type>>;
+    using pointer = std::add_pointer_t<value_type>;
+    using const_pointer = std::add_pointer_t<std::add_const_t<value_type>>;
+    using value_siptr_type = shared_intrusive_ptr<value_type>;
+    using hook_type = skip_list_hook_t<value_type>;
+
+    static constexpr unsigned max_height = hook_type::max_tower_height;
+
+    concurrent_intrusive_skip_list() = default;
+    explicit concurrent_intrusive_skip_list(const key_compare& comp, const KeyOfT& key_of = KeyOfT())
+        : comp_(comp), key_of_(key_of)
+    {
+    }
+    concurrent_intrusive_skip_list(const concurrent_intrusive_skip_list&) = delete;
+    concurrent_intrusive_skip_list& operator=(const concurrent_intrusive_skip_list&) = delete;
+
+    // Must not run concurrently with any other operation on the list.
+    ~concurrent_intrusive_skip_list()
+    {
+        pointer node = node_of_(head_[0].load(std::memory_order_acquire));
+        while (node)
+        {
+            const std::uintptr_t next = tower_(node)[0].load(std::memory_order_acquire);
+            pointer next_node = node_of_(next);
+            // A marked element has already been retired by the thread which erased it.
+            if (!is_marked_(next))
+                shared_intrusive_ptr_release(node);
+            node = next_node;
+        }
+    }
+
+    // Exact when the list is not being modified.
+    [[nodiscard]] inline size_type size() const noexcept { return size_.load(std::memory_order_relaxed); }
+    [[nodiscard]] inline bool empty() const noexcept { return size() == 0; }
+
+    // Returns false, leaving the list unchanged, if an element with an equivalent key is already in the list.
+    bool insert(value_siptr_type value);
+    template <class... ArgsT>
+    inline bool emplace(ArgsT&&... args)
+    {
+        return insert(make_shared_intrusive_ptr<value_type>(std::forward<ArgsT>(args)...));
+    }
+
+    value_siptr_type extract(const key_type& key);
+    inline bool erase(const key_type& key) { return extract(key) != nullptr; }
+
+    [[nodiscard]] value_siptr_type find(const key_type& key) const;
+    [[nodiscard]] bool contains(const key_type& key) const;
+    // First element whose key is not less than key.
+    [[nodiscard]] value_siptr_type lower_bound(const key_type& key) const;
+
+    // Visits the elements in key order. An element erased or inserted during the visit may be visited or not.
+    // The visited reference is only guaranteed to be valid during the call of function.
+    template <class FunctionT>
+    void for_each(FunctionT function) const;
+    // Visits the elements whose key is in [first, last), in key order.
+    template <class FunctionT>
+    void for_each_in(const key_type& first, const key_type& last, FunctionT function) const;
+
+    inline key_compare key_comp() const { return comp_; }
+
+private:
+    using link_type = typename hook_type::link_type;
+    using tower_type = std::add_pointer_t<link_type>;
+
+    static constexpr std::uintptr_t mark_bit = 1;
+
+    inline static pointer node_of_(std::uintptr_t link) noexcept { return reinterpret_cast<pointer>(link & ~mark_bit); }
+    inline static std::uintptr_t link_of_(pointer node) noexcept { return reinterpret_cast<std::uintptr_t>(node); }
+    inline static bool is_marked_(std::uintptr_t link) noexcept { return (link & mark_bit) != 0; }
+    inline static hook_type& hook_(reference value) noexcept { return static_cast<hook_type&>(value); }
+    inline static tower_type tower_(pointer node) noexcept { return hook_(*node).tower(); }
+    inline bool less_(pointer node, const key_type& key) const { return comp_(key_of_(*node), key); }
+    inline bool equivalent_(pointer node, const key_type& key) const
+    {
+        return node && !comp_(key, key_of_(*node)) && !less_(node, key);
+    }
+
+    // Fills, for each level, the last tower before key and the first element not less than key, unlinking on its way
+    // the marked elements. Returns true if the element at level 0 has a key equivalent to key.
+    bool find_(const key_type& key, tower_type* preds, pointer* succs);
+    // Links the upper levels of node, inserted at level 0, until it is erased.
+    void link_upper_levels_(pointer node, const key_type& key, tower_type* preds, pointer* succs);
+    // Called by the insertion and by the erasure of node, once each has unlinked node if it is erased.
+    static void end_operation_(pointer node);
+    // Same search without helping the erasures: marked elements are skipped. Used by the readers.
+    pointer lower_bound_node_(const key_type& key) const;
+    static unsigned random_height_() noexcept;
+
+    std::array<link_type, max_height> head_{};
+    std::atomic<size_type> size_ = 0;
+    [[no_unique_address]] key_compare comp_;
+    [[no_unique_address]] KeyOfT key_of_;
+};
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+bool concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::insert(value_siptr_type value)
+{
+    pointer node = value.get();
+    const key_type& key = key_of_(*node);
+    const unsigned height = random_height_();
+    std::array<tower_type, max_height> preds;
+    std::array<pointer, max_height> succs;
+
+    epoch_guard guard;
+    for (;;)
+    {
+        if (find_(key, preds.data(), succs.data()))
+            return false;
+        // The hook may belong to an element already linked: it is written only once no duplicate was found.
+        hook_(*node).tower_height() = height;
+        hook_(*node).pending_operation_count().store(2, std::memory_order_relaxed);
+        for (unsigned level = 0; level < height; ++level)
+            tower_(node)[level].store(link_of_(succs[level]), std::memory_order_relaxed);
+        std::uintptr_t expected = link_of_(succs[0]);
+        if (preds[0][0].compare_exchange_strong(expected, link_of_(node)))
+            break;
+    }
+    shared_intrusive_ptr_add_ref(node);
+    size_.fetch_add(1, std::memory_order_relaxed);
+
+    link_upper_levels_(node, key, preds.data(), succs.data());
+    // If the element was erased while being linked, its eraser may have unlinked it before the last links were
+    // made: unlink it again before ending.
+    if (is_marked_(tower_(node)[0].load()))
+        find_(key, preds.data(), succs.data());
+    end_operation_(node);
+    return true;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+void concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::link_upper_levels_(pointer node,
+                                                                                      const key_type& key,
+                                                                                      tower_type* preds,
+                                                                                      pointer* succs)
+{
+    const unsigned height = hook_(*node).tower_height();
+    for (unsigned level = 1; level < height; ++level)
+    {
+        for (;;)
+        {
+            std::uintptr_t next = tower_(node)[level].load();
+            if (is_marked_(next))
+                return;
+            // Only an erasure marking the element can modify this link concurrently.
+            if (node_of_(next) != succs[level]
+                && !tower_(node)[level].compare_exchange_strong(next, link_of_(succs[level])))
+                return;
+            std::uintptr_t expected = link_of_(succs[level]);
+            if (preds[level][level].compare_exchange_strong(expected, link_of_(node)))
+                break;
+            if (!find_(key, preds, succs) || succs[0] != node)
+                return;
+        }
+    }
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+void concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::end_operation_(pointer node)
+{
+    if (hook_(*node).pending_operation_count().fetch_sub(1) == 1)
+        epoch_reclaimer::retire_shared(node);
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+typename concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::value_siptr_type
+concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::extract(const key_type& key)
+{
+    std::array<tower_type, max_height> preds;
+    std::array<pointer, max_height> succs;
+
+    epoch_guard guard;
+    if (!find_(key, preds.data(), succs.data()))
+        return nullptr;
+    pointer node = succs[0];
+    for (unsigned level = hook_(*node).tower_height() - 1; level > 0; --level)
+    {
+        std::uintptr_t next = tower_(node)[level].load();
+        while (!is_marked_(next) && !tower_(node)[level].compare_exchange_weak(next, next | mark_bit))
+        {
+        }
+    }
+    std::uintptr_t next = tower_(node)[0].load();
+    for (;;)
+    {
+        if (is_marked_(next))
+            return nullptr; // Erased by another thread.
+        if (tower_(node)[0].compare_exchange_weak(next, next | mark_bit))
+            break;
+    }
+    value_siptr_type value(node);
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    find_(key, preds.data(), succs.data());
+    end_operation_(node);
+    return value;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+typename concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::value_siptr_type
+concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::find(const key_type& key) const
+{
+    epoch_guard guard;
+    pointer node = lower_bound_node_(key);
+    return equivalent_(node, key) ? value_siptr_type(node) : nullptr;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+bool concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::contains(const key_type& key) const
+{
+    epoch_guard guard;
+    return equivalent_(lower_bound_node_(key), key);
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+typename concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::value_siptr_type
+concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::lower_bound(const key_type& key) const
+{
+    epoch_guard guard;
+    return value_siptr_type(lower_bound_node_(key));
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+template <class FunctionT>
+void concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::for_each(FunctionT function) const
+{
+    epoch_guard guard;
+    for (pointer node = node_of_(head_[0].load()); node;)
+    {
+        const std::uintptr_t next = tower_(node)[0].load();
+        if (!is_marked_(next))
+            std::invoke(function, *node);
+        node = node_of_(next);
+    }
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+template <class FunctionT>
+void concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::for_each_in(const key_type& first,
+                                                                               const key_type& last,
+                                                                               FunctionT function) const
+{
+    epoch_guard guard;
+    for (pointer node = lower_bound_node_(first); node && less_(node, last);)
+    {
+        const std::uintptr_t next = tower_(node)[0].load();
+        if (!is_marked_(next))
+            std::invoke(function, *node);
+        node = node_of_(next);
+    }
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+bool concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::find_(const key_type& key, tower_type* preds,
+                                                                         pointer* succs)
+{
+retry:
+    tower_type pred = head_.data();
+    pointer curr = nullptr;
+    for (unsigned level = max_height; level-- > 0;)
+    {
+        curr = node_of_(pred[level].load());
+        while (curr)
+        {
+            const std::uintptr_t next = tower_(curr)[level].load();
+            if (is_marked_(next))
+            {
+                std::uintptr_t expected = link_of_(curr);
+                if (!pred[level].compare_exchange_strong(expected, next & ~mark_bit))
+                    goto retry;
+                curr = node_of_(next);
+            }
+            else if (less_(curr, key))
+            {
+                pred = tower_(curr);
+                curr = node_of_(next);
+            }
+            else
+                break;
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return equivalent_(curr, key);
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+typename concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::pointer
+concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::lower_bound_node_(const key_type& key) const
+{
+    const link_type* pred = head_.data();
+    pointer curr = nullptr;
+    for (unsigned level = max_height; level-- > 0;)
+    {
+        curr = node_of_(pred[level].load());
+        while (curr)
+        {
+            const std::uintptr_t next = tower_(curr)[level].load();
+            if (is_marked_(next))
+                curr = node_of_(next);
+            else if (less_(curr, key))
+            {
+                pred = tower_(curr);
+                curr = node_of_(next);
+            }
+            else
+                break;
+        }
+    }
+    return curr;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename CompareT>
+unsigned concurrent_intrusive_skip_list<IntrusiveT, KeyOfT, CompareT>::random_height_() noexcept
+{
+    // xorshift64, seeded differently by each thread. A level is kept with probability 1/4.
+    thread_local std::uint64_t state = reinterpret_cast<std::uintptr_t>(&state) | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return std::min<unsigned>(1 + std::countr_zero(state) / 2, max_height);
+}
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Tower of next links of a concurrent_intrusive_skip_list element. Only the tower_height() lowest levels are used by
+// the element: its height is drawn when it is inserted. The lowest bit of a link marks the element as being erased.
+template <typename IntrusiveSkipListNodeT, unsigned max_height = 12>
+    requires(max_height > 0 && max_height <= 32)
+class concurrent_intrusive_skip_list_hook
+{
+public:
+    using link_type = std::atomic<std::uintptr_t>;
+
+    static constexpr unsigned max_tower_height = max_height;
+
+    concurrent_intrusive_skip_list_hook() = default;
+    // A copied element is not linked in the list of the original one.
+    inline concurrent_intrusive_skip_list_hook(const concurrent_intrusive_skip_list_hook&) noexcept {}
+    inline concurrent_intrusive_skip_list_hook& operator=(const concurrent_intrusive_skip_list_hook&) noexcept
+    {
+        return *this;
+    }
+
+    inline const link_type* tower() const noexcept { return tower_.data(); }
+    inline link_type* tower() noexcept { return tower_.data(); }
+    inline unsigned tower_height() const noexcept { return tower_height_; }
+    inline unsigned& tower_height() noexcept { return tower_height_; }
+    // Operations not finished yet among the insertion linking the element and the erasure unlinking it: the last
+    // one to finish retires the element.
+    inline std::atomic<unsigned>& pending_operation_count() noexcept { return pending_operation_count_; }
+
+private:
+    std::array<link_type, max_height> tower_{};
+    unsigned tower_height_ = 0;
+    std::atomic<unsigned> pending_operation_count_ = 0;
+};
+
+template <typename IntrusiveSkipListNodeT, unsigned max_height>
+concurrent_intrusive_skip_list_hook<IntrusiveSkipListNodeT, max_height>*
+skip_list_hook_base(const concurrent_intrusive_skip_list_hook<IntrusiveSkipListNodeT, max_height>*);
+
+template <typename IntrusiveT>
+using skip_list_hook_t = std::remove_pointer_t<decltype(skip_list_hook_base(std::declval<IntrusiveT*>()))>;
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "shared_intrusive_ptr.hpp"
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Copy-on-write pointer: copies share the same element, which is only readable through them. mutate() clones the
+// element unless the pointer is its unique owner, i.e. no other shared nor latent reference exists on it
+// (shared_intrusive_ptr_is_unique()). The element is cloned with its clone() member function if it has one
+// (returning a shared_intrusive_ptr, for polymorphic elements), with its copy constructor otherwise.
+template <typename ElementType>
+class cow_intrusive_ptr
+{
+public:
+    using element_type = ElementType;
+
+    cow_intrusive_ptr(std::nullptr_t = nullptr) {}
+    explicit cow_intrusive_ptr(shared_intrusive_ptr<element_type> siptr) : siptr_(std::move(siptr)) {}
+
+    inline const element_type* get() const noexcept { return siptr_.get(); }
+    inline const element_type& operator*() const noexcept { return *siptr_; }
+    inline const element_type* operator->() const noexcept { return siptr_.operator->(); }
+    inline operator bool() const { return static_cast<bool>(siptr_); }
+
+    inline std::size_t use_count() const noexcept { return siptr_ ? siptr_->use_count() : 0; }
+    inline bool unique() const noexcept { return siptr_ && shared_intrusive_ptr_is_unique(siptr_.get()); }
+
+    // Gives write access to the element, cloning it first if it is shared.
+    element_type& mutate();
+
+    inline void reset() noexcept { siptr_ = nullptr; }
+    inline void swap(cow_intrusive_ptr& other) { siptr_.swap(other.siptr_); }
+    inline auto operator<=>(const cow_intrusive_ptr&) const = default;
+
+private:
+    shared_intrusive_ptr<element_type> siptr_;
+};
+
+template <typename Type>
+Type& cow_intrusive_ptr<Type>::mutate()
+{
+    assert(siptr_);
+    if (!shared_intrusive_ptr_is_unique(siptr_.get()))
+    {
+        const Type& element = *siptr_;
+        if constexpr (requires { { element.clone() } -> std::convertible_to<shared_intrusive_ptr<Type>>; })
+            siptr_ = element.clone();
+        else
+            siptr_ = make_shared_intrusive_ptr<Type>(element);
+    }
+    return *siptr_;
+}
+
+template <class val_type, class... args_types>
+[[nodiscard]] inline cow_intrusive_ptr<val_type> make_cow_intrusive_ptr(args_types&&... args)
+{
+    return cow_intrusive_ptr<val_type>(make_shared_intrusive_ptr<val_type>(std::forward<args_types>(args)...));
+}
+
+} // namespace itru
+} // namespace arba
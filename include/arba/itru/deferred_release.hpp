@@ -0,0 +1,68 @@
+#pragma once
+
+#include "shared_intrusive_ptr.hpp"
+
+#include <type_traits>
+
+inline namespace arba
+{
+namespace itru
+{
+
+template <class NodeT>
+class deferred_release_hook;
+
+// Releases link, as its destructor does. When the destructor of a node releases its children through
+// deferred_release(), the children about to be destroyed are queued, then released one after the other by the
+// outermost call: whatever the depth of a structure, its destruction uses a bounded amount of stack.
+// The queue is chained through the deferred_release_hook of the nodes: deferring a release never allocates.
+template <class NodeT>
+    requires std::is_base_of_v<deferred_release_hook<NodeT>, NodeT>
+void deferred_release(shared_intrusive_ptr<NodeT>&& link) noexcept
+{
+    thread_local shared_intrusive_ptr<NodeT> pending_link;
+    thread_local bool releasing = false;
+    if (!link)
+        return;
+    if (releasing)
+    {
+        if (shared_intrusive_ptr_is_unique(link.get()))
+        {
+            static_cast<deferred_release_hook<NodeT>&>(*link).next_pending_ = std::move(pending_link);
+            pending_link = std::move(link);
+        }
+        else
+            link = nullptr;
+        return;
+    }
+    releasing = true;
+    link = nullptr;
+    while (pending_link)
+    {
+        shared_intrusive_ptr<NodeT> released_link = std::move(pending_link);
+        pending_link = std::move(static_cast<deferred_release_hook<NodeT>&>(*released_link).next_pending_);
+    }
+    releasing = false;
+}
+
+// Base of the nodes released through deferred_release(): links a node to the next one waiting for its release.
+template <class NodeT>
+class deferred_release_hook
+{
+protected:
+    deferred_release_hook() = default;
+    // A copied node is not queued.
+    inline deferred_release_hook(const deferred_release_hook&) noexcept {}
+    inline deferred_release_hook& operator=(const deferred_release_hook&) noexcept { return *this; }
+    ~deferred_release_hook() = default;
+
+private:
+    shared_intrusive_ptr<NodeT> next_pending_;
+
+    template <class OtherNodeT>
+        requires std::is_base_of_v<deferred_release_hook<OtherNodeT>, OtherNodeT>
+    friend void deferred_release(shared_intrusive_ptr<OtherNodeT>&& link) noexcept;
+};
+
+} // namespace itru
+} // namespace arba
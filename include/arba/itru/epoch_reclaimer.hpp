@@ -0,0 +1,200 @@
+#pragma once
+
+#include "intrusive_ref_counter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Epoch based reclamation for the concurrent intrusive containers.
+// A reader accesses a shared structure inside an epoch_guard. An element unlinked from the structure is retired:
+// it is reclaimed (its reference released, or its memory freed) once every guard which may still see it has ended.
+// The global epoch only advances when every active guard has observed the current one, hence an element retired at
+// epoch e is unreachable by any guard once the global epoch is e + 2.
+// The guarded loads reading the links of a structure must be sequentially consistent, so that they cannot be
+// performed before the announcement of the guard.
+class epoch_reclaimer
+{
+public:
+    using reclaim_function = void (*)(void*);
+
+    class guard;
+
+    static constexpr std::size_t collect_threshold = 64;
+
+    static void retire(void* ptr, reclaim_function reclaim);
+    // Releases the shared reference held on the element once no guard can reach it anymore.
+    template <class ElementType>
+    inline static void retire_shared(ElementType* ptr)
+    {
+        retire(ptr, [](void* element_ptr) { shared_intrusive_ptr_release(static_cast<ElementType*>(element_ptr)); });
+    }
+
+    // Tries to advance the global epoch, then reclaims what can be. Returns the number of reclaimed elements.
+    static std::size_t collect();
+    // Waits until every element retired before the call is reclaimed. Must not be called inside a guard.
+    static void synchronize();
+
+    inline static std::uint64_t epoch() noexcept { return global_epoch_.load(); }
+    static std::size_t retired_count();
+
+private:
+    struct alignas(64) thread_record
+    {
+        // (epoch << 1) | 1 while the owning thread is inside a guard, 0 otherwise.
+        std::atomic<std::uint64_t> state = 0;
+        std::atomic<bool> in_use = false;
+        thread_record* next = nullptr;
+        unsigned nesting = 0;
+    };
+
+    struct record_owner
+    {
+        thread_record* record;
+
+        record_owner() : record(acquire_record_()) {}
+        ~record_owner() { record->in_use.store(false); }
+    };
+
+    struct retired_element
+    {
+        void* ptr;
+        reclaim_function reclaim;
+        std::uint64_t epoch;
+    };
+
+    static thread_record* acquire_record_();
+    inline static thread_record& local_record_()
+    {
+        thread_local record_owner owner;
+        return *owner.record;
+    }
+    static bool try_advance_() noexcept;
+
+    inline static std::atomic<std::uint64_t> global_epoch_ = 1;
+    inline static std::atomic<thread_record*> records_ = nullptr;
+    inline static std::mutex retired_mutex_;
+    inline static std::vector<retired_element> retired_;
+    inline static std::size_t next_collect_count_ = collect_threshold;
+};
+
+class epoch_reclaimer::guard
+{
+public:
+    guard() : record_(local_record_())
+    {
+        if (record_.nesting++ == 0)
+            record_.state.store((global_epoch_.load() << 1) | 1);
+    }
+
+    guard(const guard&) = delete;
+    guard& operator=(const guard&) = delete;
+
+    ~guard()
+    {
+        if (--record_.nesting == 0)
+            record_.state.store(0);
+    }
+
+private:
+    thread_record& record_;
+};
+
+using epoch_guard = epoch_reclaimer::guard;
+
+inline void epoch_reclaimer::retire(void* ptr, reclaim_function reclaim)
+{
+    bool collect_needed = false;
+    {
+        std::lock_guard lock(retired_mutex_);
+        retired_.push_back(retired_element{ ptr, reclaim, global_epoch_.load() });
+        collect_needed = retired_.size() >= next_collect_count_;
+    }
+    if (collect_needed)
+        collect();
+}
+
+inline std::size_t epoch_reclaimer::collect()
+{
+    try_advance_();
+    std::vector<retired_element> reclaimable;
+    {
+        std::lock_guard lock(retired_mutex_);
+        const std::uint64_t epoch = global_epoch_.load();
+        auto first_kept = retired_.begin();
+        for (auto iter = retired_.begin(); iter != retired_.end(); ++iter)
+        {
+            if (iter->epoch + 2 <= epoch)
+                reclaimable.push_back(*iter);
+            else
+                *first_kept++ = *iter;
+        }
+        retired_.erase(first_kept, retired_.end());
+        // While a guard holds the epoch back, the elements kept are not scanned again at each retirement.
+        next_collect_count_ = std::max(collect_threshold, 2 * retired_.size());
+    }
+    // Reclaiming may retire other elements: it is done outside the lock.
+    for (const retired_element& element : reclaimable)
+        element.reclaim(element.ptr);
+    return reclaimable.size();
+}
+
+inline void epoch_reclaimer::synchronize()
+{
+    const std::uint64_t target_epoch = global_epoch_.load() + 2;
+    while (global_epoch_.load() < target_epoch)
+    {
+        if (!try_advance_())
+            std::this_thread::yield();
+    }
+    collect();
+}
+
+inline std::size_t epoch_reclaimer::retired_count()
+{
+    std::lock_guard lock(retired_mutex_);
+    return retired_.size();
+}
+
+inline epoch_reclaimer::thread_record* epoch_reclaimer::acquire_record_()
+{
+    for (thread_record* record = records_.load(); record; record = record->next)
+    {
+        bool in_use = false;
+        if (!record->in_use.load() && record->in_use.compare_exchange_strong(in_use, true))
+            return record;
+    }
+    // Records are never freed: they are reused by the threads created later.
+    thread_record* record = new thread_record();
+    record->in_use.store(true);
+    record->next = records_.load();
+    while (!records_.compare_exchange_weak(record->next, record))
+    {
+    }
+    return record;
+}
+
+inline bool epoch_reclaimer::try_advance_() noexcept
+{
+    std::uint64_t epoch = global_epoch_.load();
+    for (thread_record* record = records_.load(); record; record = record->next)
+    {
+        const std::uint64_t state = record->state.load();
+        if ((state & 1) && (state >> 1) != epoch)
+            return false;
+    }
+    return global_epoch_.compare_exchange_strong(epoch, epoch + 1);
+}
+
+} // namespace itru
+} // namespace arba
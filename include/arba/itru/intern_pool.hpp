@@ -0,0 +1,215 @@
+#pragma once
+
+#include "key_of.hpp"
+#include "policy/link_policy.hpp"
+#include "sharable_intrusive_unordered_set.hpp"
+#include "sharable_intrusive_unordered_set_hook.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Hook of the elements of an intern_pool: the pool indexes them through raw links and keeps them alive (in memory,
+// not in use) with a latent reference.
+template <typename IntrusiveT>
+using intern_pool_hook = sharable_intrusive_unordered_set_hook<IntrusiveT, raw_link_t>;
+
+// Hash-consing pool: intern(key, factory) returns the live element whose key is equivalent to key, or the element
+// created by factory. The pool only holds a latent reference on its elements, hence an element is dropped when its
+// last shared_intrusive_ptr goes away: its memory is released by the next sweep of its shard, run when the shard
+// size reaches twice the number of live elements found by its previous sweep.
+// The pool is split in shard_count shards, each one guarded by its own shared mutex: lookups of existing elements
+// only take the shared lock of their shard.
+template <typename IntrusiveT, typename KeyOfT, typename HashT = std::hash<key_of_result_t<IntrusiveT, KeyOfT>>,
+          typename KeyEqualT = std::equal_to<key_of_result_t<IntrusiveT, KeyOfT>>, std::size_t shard_count = 16>
+class intern_pool
+{
+    static_assert(std::has_single_bit(shard_count));
+
+public:
+    using key_type = key_of_result_t<IntrusiveT, KeyOfT>;
+    using value_type = IntrusiveT;
+    using size_type = std::size_t;
+    using hasher = HashT;
+    using key_equal = KeyEqualT;
+    using pointer = std::add_pointer_t<value_type>;
+    using value_siptr_type = shared_intrusive_ptr<value_type>;
+
+    static constexpr size_type min_sweep_threshold = 64;
+
+private:
+    using set_type = sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, raw_link_t>;
+
+    template <class KeyT>
+    static constexpr bool transparent_key_v =
+        std::is_same_v<KeyT, key_type> || requires {
+            typename HashT::is_transparent;
+            typename KeyEqualT::is_transparent;
+        };
+
+public:
+    intern_pool() = default;
+    explicit intern_pool(const HashT& hash, const KeyEqualT& key_eq = KeyEqualT(), const KeyOfT& key_of = KeyOfT())
+        : hash_function_(hash), key_equal_(key_eq), key_of_(key_of)
+    {
+        for (shard& pool_shard : shards_)
+            pool_shard.set = set_type(set_type::initial_bucket_count, hash, key_eq, key_of);
+    }
+    intern_pool(const intern_pool&) = delete;
+    intern_pool& operator=(const intern_pool&) = delete;
+    ~intern_pool();
+
+    // factory is called, under the lock of the shard, only if no live element is equivalent to key. It returns a
+    // value_siptr_type whose element has a key equivalent to key.
+    template <class KeyT, class FactoryT>
+        requires transparent_key_v<KeyT>
+    value_siptr_type intern(const KeyT& key, FactoryT&& factory)
+    {
+        shard& pool_shard = shard_of_(key);
+        {
+            std::shared_lock lock(pool_shard.mutex);
+            auto iter = pool_shard.set.find(key);
+            if (iter != pool_shard.set.end())
+            {
+                if (value_siptr_type value = value_siptr_type::try_lock_from(&*iter))
+                    return value;
+            }
+        }
+
+        std::unique_lock lock(pool_shard.mutex);
+        auto iter = pool_shard.set.find(key);
+        if (iter != pool_shard.set.end())
+        {
+            pointer element = &*iter;
+            if (value_siptr_type value = value_siptr_type::try_lock_from(element))
+                return value;
+            pool_shard.set.erase(iter);
+            weak_intrusive_ptr_release(element);
+        }
+        if (pool_shard.set.size() >= pool_shard.sweep_threshold)
+            sweep_(pool_shard);
+        value_siptr_type value = std::invoke(std::forward<FactoryT>(factory));
+        assert(value && key_equal_(key_of_(*value), key));
+        pool_shard.set.insert(value.get());
+        weak_intrusive_ptr_add_ref(value.get());
+        return value;
+    }
+
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    [[nodiscard]] value_siptr_type find(const KeyT& key) const
+    {
+        const shard& pool_shard = shard_of_(key);
+        std::shared_lock lock(pool_shard.mutex);
+        auto iter = pool_shard.set.find(key);
+        if (iter == pool_shard.set.end())
+            return nullptr;
+        return value_siptr_type::try_lock_from(const_cast<pointer>(&*iter));
+    }
+
+    // Number of indexed elements, the dropped ones not swept yet included.
+    [[nodiscard]] size_type size() const;
+    // Sweeps every shard. Returns the number of released elements.
+    size_type purge();
+
+private:
+    struct alignas(64) shard
+    {
+        mutable std::shared_mutex mutex;
+        set_type set;
+        size_type sweep_threshold = min_sweep_threshold;
+    };
+
+    // The low bits of the hash code select the shard, the shard set uses its high bits.
+    template <class KeyT>
+    inline shard& shard_of_(const KeyT& key) const
+    {
+        return const_cast<shard&>(shards_[hash_function_(key) & (shard_count - 1)]);
+    }
+    static size_type sweep_(shard& pool_shard);
+
+    std::array<shard, shard_count> shards_;
+    [[no_unique_address]] hasher hash_function_;
+    [[no_unique_address]] key_equal key_equal_;
+    [[no_unique_address]] KeyOfT key_of_;
+};
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT, std::size_t shard_count>
+intern_pool<IntrusiveT, KeyOfT, HashT, KeyEqualT, shard_count>::~intern_pool()
+{
+    std::vector<pointer> elements;
+    for (shard& pool_shard : shards_)
+    {
+        elements.clear();
+        for (value_type& element : pool_shard.set)
+            elements.push_back(&element);
+        pool_shard.set.clear();
+        for (pointer element : elements)
+            weak_intrusive_ptr_release(element);
+    }
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT, std::size_t shard_count>
+typename intern_pool<IntrusiveT, KeyOfT, HashT, KeyEqualT, shard_count>::size_type
+intern_pool<IntrusiveT, KeyOfT, HashT, KeyEqualT, shard_count>::size() const
+{
+    size_type count = 0;
+    for (const shard& pool_shard : shards_)
+    {
+        std::shared_lock lock(pool_shard.mutex);
+        count += pool_shard.set.size();
+    }
+    return count;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT, std::size_t shard_count>
+typename intern_pool<IntrusiveT, KeyOfT, HashT, KeyEqualT, shard_count>::size_type
+intern_pool<IntrusiveT, KeyOfT, HashT, KeyEqualT, shard_count>::purge()
+{
+    size_type count = 0;
+    for (shard& pool_shard : shards_)
+    {
+        std::unique_lock lock(pool_shard.mutex);
+        count += sweep_(pool_shard);
+    }
+    return count;
+}
+
+template <typename IntrusiveT, typename KeyOfT, typename HashT, typename KeyEqualT, std::size_t shard_count>
+typename intern_pool<IntrusiveT, KeyOfT, HashT, KeyEqualT, shard_count>::size_type
+intern_pool<IntrusiveT, KeyOfT, HashT, KeyEqualT, shard_count>::sweep_(shard& pool_shard)
+{
+    // A dropped element never comes back to life: its use count can be read without locking it.
+    size_type count = 0;
+    for (auto iter = pool_shard.set.begin(); iter != pool_shard.set.end();)
+    {
+        pointer element = &*iter;
+        if (weak_intrusive_ptr_use_count(element) == 0)
+        {
+            iter = pool_shard.set.erase(iter);
+            weak_intrusive_ptr_release(element);
+            ++count;
+        }
+        else
+            ++iter;
+    }
+    pool_shard.sweep_threshold = std::max(min_sweep_threshold, pool_shard.set.size() * 2);
+    return count;
+}
+
+} // namespace itru
+} // namespace arba
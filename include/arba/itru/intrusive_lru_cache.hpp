@@ -0,0 +1,216 @@
+#pragma once
+
+#include "intrusive_lru_cache_hook.hpp"
+#include "sharable_intrusive_list.hpp"
+#include "sharable_intrusive_unordered_set.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+struct lru_cache_stats
+{
+    std::size_t hit_count = 0;
+    std::size_t miss_count = 0;
+    std::size_t eviction_count = 0;
+};
+
+// Least recently used cache whose entries derive from intrusive_lru_cache_hook<IntrusiveT, KeyT>: the recency list
+// and the key index are threaded through the entries, so caching a value allocates nothing. The cache holds shared
+// references: an entry evicted while a caller still holds it stays alive until the caller drops it.
+// The capacity is bounded by a number of entries and by a total weight (each entry has a weight given when it is
+// put in the cache, 1 by default).
+template <typename KeyT, typename IntrusiveT, typename HashT = std::hash<KeyT>,
+          typename KeyEqualT = std::equal_to<KeyT>>
+class intrusive_lru_cache
+{
+    struct cache_key_of
+    {
+        inline const KeyT& operator()(const IntrusiveT& value) const noexcept { return value.cache_key(); }
+    };
+
+    using recency_list_type =
+        sharable_intrusive_list<IntrusiveT, IntrusiveT, base_list_hook_accessor<IntrusiveT, lru_cache_hook_tag>>;
+    using index_type = sharable_intrusive_unordered_set<IntrusiveT, cache_key_of, HashT, KeyEqualT>;
+
+public:
+    using key_type = KeyT;
+    using value_type = IntrusiveT;
+    using size_type = std::size_t;
+    using value_siptr_type = shared_intrusive_ptr<value_type>;
+
+    static constexpr size_type unlimited = std::numeric_limits<size_type>::max();
+
+public:
+    explicit intrusive_lru_cache(size_type max_size, size_type max_weight = unlimited);
+    intrusive_lru_cache(size_type max_size, size_type max_weight, IntrusiveT sentinel);
+
+    inline bool empty() const noexcept { return recency_list_.empty(); }
+    inline size_type size() const noexcept { return recency_list_.size(); }
+    inline size_type weight() const noexcept { return weight_; }
+    inline size_type max_size() const noexcept { return max_size_; }
+    inline size_type max_weight() const noexcept { return max_weight_; }
+    void set_max_size(size_type max_size);
+    void set_max_weight(size_type max_weight);
+
+    inline const lru_cache_stats& stats() const noexcept { return stats_; }
+    inline void reset_stats() noexcept { stats_ = lru_cache_stats(); }
+
+    // Looks the key up and marks the entry as the most recently used one. Hits and misses are counted.
+    value_siptr_type get(const key_type& key);
+    // Looks the key up without changing the recency order nor the statistics.
+    value_siptr_type peek(const key_type& key) const;
+    inline bool contains(const key_type& key) const { return index_.contains(key); }
+
+    // Caches the value as the most recently used entry (replacing the entry of the same key if any), then evicts
+    // the least recently used entries until the capacity is respected. If the hasher or an allocation throws, the
+    // value is not cached, and the replaced entry may be gone.
+    void put(const key_type& key, value_siptr_type value, size_type weight = 1);
+
+    template <class FactoryT>
+    value_siptr_type get_or_put(const key_type& key, FactoryT factory, size_type weight = 1);
+
+    bool erase(const key_type& key);
+    void clear();
+
+private:
+    value_siptr_type remove_(const key_type& key);
+    void evict_();
+
+private:
+    recency_list_type recency_list_;
+    index_type index_;
+    size_type weight_ = 0;
+    size_type max_size_;
+    size_type max_weight_;
+    lru_cache_stats stats_;
+};
+
+template <typename KeyT, typename IntrusiveT, typename HashT, typename KeyEqualT>
+intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::intrusive_lru_cache(size_type max_size,
+                                                                            size_type max_weight)
+    : max_size_(max_size), max_weight_(max_weight)
+{
+}
+
+template <typename KeyT, typename IntrusiveT, typename HashT, typename KeyEqualT>
+intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::intrusive_lru_cache(size_type max_size,
+                                                                            size_type max_weight,
+                                                                            IntrusiveT sentinel)
+    : recency_list_(std::move(sentinel)), max_size_(max_size), max_weight_(max_weight)
+{
+}
+
+template <typename KeyT, typename IntrusiveT, typename HashT, typename KeyEqualT>
+void intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::set_max_size(size_type max_size)
+{
+    max_size_ = max_size;
+    evict_();
+}
+
+template <typename KeyT, typename IntrusiveT, typename HashT, typename KeyEqualT>
+void intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::set_max_weight(size_type max_weight)
+{
+    max_weight_ = max_weight;
+    evict_();
+}
+
+template <typename KeyT, typename IntrusiveT, typename HashT, typename KeyEqualT>
+typename intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::value_siptr_type
+intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::get(const key_type& key)
+{
+    auto index_iter = index_.find(key);
+    if (index_iter == index_.end())
+    {
+        ++stats_.miss_count;
+        return nullptr;
+    }
+    ++stats_.hit_count;
+    typename recency_list_type::iterator iter(*index_iter);
+    if (iter != recency_list_.begin())
+        recency_list_.splice(recency_list_.begin(), recency_list_, iter, std::next(iter));
+    return value_siptr_type(iter.ptr());
+}
+
+template <typename KeyT, typename IntrusiveT, typename HashT, typename KeyEqualT>
+typename intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::value_siptr_type
+intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::peek(const key_type& key) const
+{
+    auto index_iter = index_.find(key);
+    return index_iter != index_.end() ? value_siptr_type(const_cast<value_type*>(index_iter.ptr())) : nullptr;
+}
+
+template <typename KeyT, typename IntrusiveT, typename HashT, typename KeyEqualT>
+void intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::put(const key_type& key, value_siptr_type value,
+                                                                 size_type weight)
+{
+    remove_(key);
+    value->cache_key() = key;
+    value->cache_weight() = weight;
+    // The entry is linked in the recency list and weighed only once indexed: the index insertion may throw.
+    index_.insert(value);
+    weight_ += weight;
+    recency_list_.push_front(std::move(value));
+    evict_();
+}
+
+template <typename KeyT, typename IntrusiveT, typename HashT, typename KeyEqualT>
+template <class FactoryT>
+typename intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::value_siptr_type
+intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::get_or_put(const key_type& key, FactoryT factory,
+                                                                   size_type weight)
+{
+    if (value_siptr_type value = get(key))
+        return value;
+    value_siptr_type value = factory();
+    put(key, value, weight);
+    return value;
+}
+
+template <typename KeyT, typename IntrusiveT, typename HashT, typename KeyEqualT>
+bool intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::erase(const key_type& key)
+{
+    return remove_(key) != nullptr;
+}
+
+template <typename KeyT, typename IntrusiveT, typename HashT, typename KeyEqualT>
+void intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::clear()
+{
+    index_.clear();
+    recency_list_.clear();
+    weight_ = 0;
+}
+
+template <typename KeyT, typename IntrusiveT, typename HashT, typename KeyEqualT>
+typename intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::value_siptr_type
+intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::remove_(const key_type& key)
+{
+    value_siptr_type value = index_.extract(key);
+    if (value)
+    {
+        recency_list_.erase(typename recency_list_type::iterator(*value));
+        weight_ -= value->cache_weight();
+    }
+    return value;
+}
+
+template <typename KeyT, typename IntrusiveT, typename HashT, typename KeyEqualT>
+void intrusive_lru_cache<KeyT, IntrusiveT, HashT, KeyEqualT>::evict_()
+{
+    while (!recency_list_.empty() && (recency_list_.size() > max_size_ || weight_ > max_weight_))
+    {
+        remove_(recency_list_.back().cache_key());
+        ++stats_.eviction_count;
+    }
+}
+
+} // namespace itru
+} // namespace arba
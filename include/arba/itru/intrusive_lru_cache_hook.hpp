@@ -0,0 +1,38 @@
+#pragma once
+
+#include "sharable_intrusive_list_hook.hpp"
+#include "sharable_intrusive_unordered_set_hook.hpp"
+
+#include <cstddef>
+
+inline namespace arba
+{
+namespace itru
+{
+
+struct lru_cache_hook_tag
+{
+};
+
+// An entry of intrusive_lru_cache is linked in the recency list and in the key index through the same node.
+// The recency list hook is tagged, so that the entry can still derive from a default sharable_intrusive_list_hook.
+template <typename IntrusiveCacheNodeT, typename KeyT>
+class intrusive_lru_cache_hook
+    : public sharable_intrusive_list_hook<IntrusiveCacheNodeT, shared_link_t, lru_cache_hook_tag>,
+      public sharable_intrusive_unordered_set_hook<IntrusiveCacheNodeT>
+{
+public:
+    using key_type = KeyT;
+
+    inline const KeyT& cache_key() const noexcept { return cache_key_; }
+    inline KeyT& cache_key() noexcept { return cache_key_; }
+    inline std::size_t cache_weight() const noexcept { return cache_weight_; }
+    inline std::size_t& cache_weight() noexcept { return cache_weight_; }
+
+private:
+    KeyT cache_key_{};
+    std::size_t cache_weight_ = 0;
+};
+
+} // namespace itru
+} // namespace arba
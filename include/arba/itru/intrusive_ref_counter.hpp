@@ -46,6 +46,11 @@ public:
 
     [[nodiscard]] inline unsigned int use_count() const noexcept { return ref_counter_.load(); }
 
+    [[nodiscard]] inline static bool is_unique(const intrusive_ref_counter* ptr) noexcept
+    {
+        return ptr->ref_counter_.load() == 1;
+    }
+
     inline static void increment_use_counter(intrusive_ref_counter* ptr) noexcept { ptr->ref_counter_.fetch_add(1); }
 
     [[nodiscard]] inline static bool decrement_use_counter(intrusive_ref_counter* ptr) noexcept
@@ -75,6 +80,11 @@ public:
 
     [[nodiscard]] inline unsigned int use_count() const noexcept { return ref_counter_; }
 
+    [[nodiscard]] inline static bool is_unique(const intrusive_ref_counter* ptr) noexcept
+    {
+        return ptr->ref_counter_ == 1;
+    }
+
     inline static void increment_use_counter(intrusive_ref_counter* ptr) noexcept { ++(ptr->ref_counter_); }
 
     [[nodiscard]] inline static bool decrement_use_counter(intrusive_ref_counter* ptr) noexcept
@@ -105,6 +115,12 @@ public:
 
     [[nodiscard]] inline unsigned int latent_count() const noexcept { return latent_counter_; }
 
+    // A latent reference can be locked at any time: the owner is unique only if there is none.
+    [[nodiscard]] inline static bool is_unique(const intrusive_ref_counters* ptr) noexcept
+    {
+        return ptr->use_count() == 1 && ptr->latent_counter_ == 0;
+    }
+
     [[nodiscard]] inline static bool decrement_use_counter(intrusive_ref_counters* ptr) noexcept
     {
         return intrusive_ref_counter<counter_bitsize, meta::thread_unsafe_t>::decrement_use_counter(ptr)
@@ -153,6 +169,12 @@ public:
         return (ref_counter_.load() & latent_count_mask) >> counter_bitsize;
     }
 
+    // Both counters are read at once: a latent reference could be locked between two separate reads.
+    [[nodiscard]] inline static bool is_unique(const intrusive_ref_counters* ptr) noexcept
+    {
+        return ptr->ref_counter_.load() == 1;
+    }
+
     inline static void increment_use_counter(intrusive_ref_counters* ptr) noexcept { ptr->ref_counter_.fetch_add(1); }
 
     [[nodiscard]] inline static bool decrement_use_counter(intrusive_ref_counters* ptr) noexcept
@@ -203,6 +225,13 @@ void shared_intrusive_ptr_release(ElementType* ptr) noexcept
         delete ptr;
 }
 
+template <class ElementType>
+    requires std::is_base_of_v<intrusive_type_base, ElementType>
+[[nodiscard]] bool shared_intrusive_ptr_is_unique(const ElementType* ptr) noexcept
+{
+    return ElementType::is_unique(ptr);
+}
+
 template <class ElementType>
     requires std::is_base_of_v<intrusive_type_base, ElementType>
 void weak_intrusive_ptr_add_ref(ElementType* ptr) noexcept
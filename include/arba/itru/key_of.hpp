@@ -0,0 +1,16 @@
+#pragma once
+
+#include <functional>
+#include <type_traits>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Type of the key extracted from an element by the KeyOfT function object of an associative intrusive container.
+template <typename IntrusiveT, typename KeyOfT>
+using key_of_result_t = std::remove_cvref_t<std::invoke_result_t<const KeyOfT&, const IntrusiveT&>>;
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "intrusive_ref_counter.hpp"
+#include "shared_bytes_view.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Expected access pattern of a range of a mapped_file, given to madvise().
+enum class access_advice : int
+{
+    normal = MADV_NORMAL,
+    sequential = MADV_SEQUENTIAL,
+    random = MADV_RANDOM,
+    will_need = MADV_WILLNEED,
+    dont_need = MADV_DONTNEED
+};
+
+struct mapped_file_options
+{
+    // Given to madvise() for the whole file once mapped.
+    access_advice advice = access_advice::normal;
+    // Maps the file at an address aligned on mapped_file::huge_page_size, and asks for transparent huge pages where
+    // the system supports them for files.
+    bool huge_page_aligned = false;
+};
+
+// Read-only file mapped in memory (mmap) with its counter: the mapping lives as long as a shared_intrusive_ptr or a
+// mapped_file_view refers to it, and is unmapped by the release of the last one.
+class mapped_file final : public intrusive_ref_counter<>
+{
+public:
+    static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+    // Maps the whole file path. Throws std::system_error if it cannot be opened or mapped.
+    [[nodiscard]] static shared_intrusive_ptr<mapped_file> open(const std::string& path,
+                                                                const mapped_file_options& options = {});
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+    inline ~mapped_file()
+    {
+        if (data_)
+            ::munmap(data_, size_);
+    }
+
+    // nullptr if the file is empty.
+    inline const std::byte* data() const noexcept { return data_; }
+    inline std::size_t size() const noexcept { return size_; }
+    inline std::span<const std::byte> bytes() const noexcept { return { data_, size_ }; }
+
+    // Gives advice for the pages holding [offset, offset + size). Returns false if madvise() fails.
+    bool advise(access_advice advice, std::size_t offset, std::size_t size) const noexcept;
+    inline bool advise(access_advice advice) const noexcept { return advise(advice, 0, size_); }
+
+private:
+    inline mapped_file(std::byte* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    static std::byte* map_(int fd, std::size_t size, bool huge_page_aligned);
+
+    std::byte* data_;
+    std::size_t size_;
+};
+
+// Read-only view on a range of bytes of a mapped_file, sharing the ownership of the mapping.
+class mapped_file_view : public shared_bytes_view<mapped_file, mapped_file_view>
+{
+public:
+    using shared_bytes_view::shared_bytes_view;
+
+    inline const shared_intrusive_ptr<mapped_file>& file() const noexcept { return owner_ptr_(); }
+
+    // View on [offset, offset + size) of this view.
+    [[nodiscard]] inline mapped_file_view subview(std::size_t offset, std::size_t size) const noexcept
+    {
+        return subrange_(offset, size);
+    }
+    [[nodiscard]] inline mapped_file_view subview(std::size_t offset) const noexcept { return subrange_(offset); }
+};
+
+inline shared_intrusive_ptr<mapped_file> mapped_file::open(const std::string& path, const mapped_file_options& options)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), "mapped_file: open failed.");
+    struct stat status;
+    if (::fstat(fd, &status) != 0)
+    {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "mapped_file: fstat failed.");
+    }
+    const std::size_t size = static_cast<std::size_t>(status.st_size);
+    std::byte* data = nullptr;
+    try
+    {
+        // An empty file cannot be mapped.
+        if (size > 0)
+            data = map_(fd, size, options.huge_page_aligned);
+    }
+    catch (...)
+    {
+        ::close(fd);
+        throw;
+    }
+    // The mapping stays valid once the descriptor is closed.
+    ::close(fd);
+
+    mapped_file* file = nullptr;
+    try
+    {
+        file = new mapped_file(data, size);
+    }
+    catch (...)
+    {
+        if (data)
+            ::munmap(data, size);
+        throw;
+    }
+    shared_intrusive_ptr<mapped_file> file_siptr(file);
+    if (options.advice != access_advice::normal)
+        file->advise(options.advice);
+    return file_siptr;
+}
+
+inline bool mapped_file::advise(access_advice advice, std::size_t offset, std::size_t size) const noexcept
+{
+    if (size == 0)
+        return true;
+    const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t page_offset = offset - offset % page_size;
+    return ::madvise(data_ + page_offset, size + offset - page_offset, static_cast<int>(advice)) == 0;
+}
+
+inline std::byte* mapped_file::map_(int fd, std::size_t size, bool huge_page_aligned)
+{
+    if (!huge_page_aligned)
+    {
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+            throw std::system_error(errno, std::generic_category(), "mapped_file: mmap failed.");
+        return static_cast<std::byte*>(data);
+    }
+
+    // Reserves enough address space to find an aligned address in it, maps the file there, then gives back the
+    // unused parts of the reservation.
+    const std::size_t reserved_size = size + huge_page_size;
+    void* reserved = ::mmap(nullptr, reserved_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED)
+        throw std::system_error(errno, std::generic_category(), "mapped_file: mmap failed.");
+    std::byte* reserved_begin = static_cast<std::byte*>(reserved);
+    std::byte* data = reinterpret_cast<std::byte*>(
+        (reinterpret_cast<std::uintptr_t>(reserved_begin) + huge_page_size - 1) & ~(huge_page_size - 1));
+    if (::mmap(data, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        const int error = errno;
+        ::munmap(reserved, reserved_size);
+        throw std::system_error(error, std::generic_category(), "mapped_file: mmap failed.");
+    }
+    const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::byte* data_end = data + (size + page_size - 1) / page_size * page_size;
+    if (data != reserved_begin)
+        ::munmap(reserved_begin, static_cast<std::size_t>(data - reserved_begin));
+    if (data_end != reserved_begin + reserved_size)
+        ::munmap(data_end, static_cast<std::size_t>(reserved_begin + reserved_size - data_end));
+#ifdef MADV_HUGEPAGE
+    // Only a hint: read-only file mappings get huge pages on some systems only.
+    ::madvise(data, size, MADV_HUGEPAGE);
+#endif
+    return data;
+}
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Pool of fixed-size node slots, carved out of a few large blocks. Each slot is preceded by a header pointing to
+// its block, so that a node can be given back to its arena from its address only: this is what the operator delete
+// of arena_node_base does, whoever releases the last reference on the node.
+// Slots are allocated and blocks are added by the owner of the arena only. Nodes can be deallocated from any
+// thread, and may outlive the arena: the blocks still holding nodes are released with their last node.
+class node_arena
+{
+    struct core;
+
+public:
+    struct block
+    {
+        core* owner;
+        std::byte* slots;
+        std::size_t slot_count;
+        std::size_t live_count = 0;
+        void* free_list = nullptr;
+    };
+
+    static constexpr std::size_t header_size = alignof(std::max_align_t);
+    static constexpr std::size_t min_block_slot_count = 64;
+
+    node_arena() = default;
+    node_arena(std::size_t node_size, std::size_t node_alignment) : core_(new core)
+    {
+        assert(node_alignment <= header_size);
+        core_->slot_stride = header_size + (node_size + header_size - 1) / header_size * header_size;
+    }
+    node_arena(const node_arena&) = delete;
+    node_arena& operator=(const node_arena&) = delete;
+    inline node_arena(node_arena&& other) noexcept : core_(std::exchange(other.core_, nullptr)) {}
+    inline node_arena& operator=(node_arena&& other) noexcept
+    {
+        std::swap(core_, other.core_);
+        return *this;
+    }
+    ~node_arena();
+
+    // Returns a slot of a block having one free, or of a new block.
+    [[nodiscard]] void* allocate();
+    // Returns a slot of the given block, which must have one free. The slots of a new block are handed out in
+    // address order.
+    [[nodiscard]] void* allocate(block& target);
+    // Adds a block of slot_count slots.
+    block& add_block(std::size_t slot_count);
+    // Releases the blocks without any live node. Returns the number of released blocks.
+    std::size_t release_empty_blocks();
+
+    // Gives the slot of node back to its arena, or to the heap if node was not allocated by an arena.
+    static void deallocate(void* node) noexcept;
+    // Allocates a node on the heap, with a header telling deallocate() it does not belong to an arena.
+    [[nodiscard]] static void* allocate_on_heap(std::size_t node_size);
+
+    [[nodiscard]] std::size_t node_count() const;
+    [[nodiscard]] std::size_t block_count() const;
+
+private:
+    struct core
+    {
+        std::size_t slot_stride = 0;
+        mutable std::mutex mutex;
+        std::vector<block*> blocks;
+        std::size_t allocation_hint = 0;
+        bool orphan = false;
+    };
+
+    inline static block*& header_(void* node) noexcept
+    {
+        return *reinterpret_cast<block**>(static_cast<std::byte*>(node) - header_size);
+    }
+    inline static void*& next_free_(void* node) noexcept { return *static_cast<void**>(node); }
+    static block* new_block_(core& arena_core, std::size_t slot_count);
+    inline static void delete_block_(block* arena_block) noexcept
+    {
+        ::operator delete(static_cast<void*>(arena_block));
+    }
+    static void* pop_free_(block& arena_block) noexcept;
+
+    core* core_ = nullptr;
+};
+
+// Base of the nodes which can be allocated by a node_arena: its operator delete gives the memory of a node back to
+// its arena. Nodes created with new (by make_shared_intrusive_ptr, for example) are allocated on the heap as usual.
+class arena_node_base
+{
+public:
+    inline static void* operator new(std::size_t size) { return node_arena::allocate_on_heap(size); }
+    inline static void* operator new(std::size_t, void* address) noexcept { return address; }
+    inline static void operator delete(void* node) noexcept { node_arena::deallocate(node); }
+    inline static void operator delete(void*, void*) noexcept {}
+};
+
+inline node_arena::~node_arena()
+{
+    if (!core_)
+        return;
+    std::unique_lock lock(core_->mutex);
+    core_->orphan = true;
+    std::erase_if(core_->blocks,
+                  [](block* arena_block)
+                  {
+                      if (arena_block->live_count > 0)
+                          return false;
+                      delete_block_(arena_block);
+                      return true;
+                  });
+    if (core_->blocks.empty())
+    {
+        lock.unlock();
+        delete core_;
+    }
+}
+
+inline void* node_arena::allocate()
+{
+    assert(core_);
+    std::lock_guard lock(core_->mutex);
+    std::vector<block*>& blocks = core_->blocks;
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+    {
+        const std::size_t index = (core_->allocation_hint + i) % blocks.size();
+        if (blocks[index]->free_list)
+        {
+            core_->allocation_hint = index;
+            return pop_free_(*blocks[index]);
+        }
+    }
+    std::size_t slot_count = min_block_slot_count;
+    for (const block* arena_block : blocks)
+        slot_count = std::max(slot_count, arena_block->slot_count);
+    block* arena_block = new_block_(*core_, slot_count * (blocks.empty() ? 1 : 2));
+    core_->allocation_hint = blocks.size();
+    blocks.push_back(arena_block);
+    return pop_free_(*arena_block);
+}
+
+inline void* node_arena::allocate(block& target)
+{
+    assert(core_ && target.owner == core_);
+    std::lock_guard lock(core_->mutex);
+    assert(target.free_list);
+    return pop_free_(target);
+}
+
+inline node_arena::block& node_arena::add_block(std::size_t slot_count)
+{
+    assert(core_ && slot_count > 0);
+    std::lock_guard lock(core_->mutex);
+    block* arena_block = new_block_(*core_, slot_count);
+    core_->blocks.push_back(arena_block);
+    return *arena_block;
+}
+
+inline std::size_t node_arena::release_empty_blocks()
+{
+    assert(core_);
+    std::lock_guard lock(core_->mutex);
+    const std::size_t count = std::erase_if(core_->blocks,
+                                            [](block* arena_block)
+                                            {
+                                                if (arena_block->live_count > 0)
+                                                    return false;
+                                                delete_block_(arena_block);
+                                                return true;
+                                            });
+    core_->allocation_hint = 0;
+    return count;
+}
+
+inline void node_arena::deallocate(void* node) noexcept
+{
+    if (!node)
+        return;
+    block* arena_block = header_(node);
+    if (!arena_block)
+    {
+        ::operator delete(static_cast<std::byte*>(node) - header_size);
+        return;
+    }
+    core* arena_core = arena_block->owner;
+    std::unique_lock lock(arena_core->mutex);
+    next_free_(node) = arena_block->free_list;
+    arena_block->free_list = node;
+    if (--arena_block->live_count == 0 && arena_core->orphan)
+    {
+        std::erase(arena_core->blocks, arena_block);
+        delete_block_(arena_block);
+        if (arena_core->blocks.empty())
+        {
+            lock.unlock();
+            delete arena_core;
+        }
+    }
+}
+
+inline void* node_arena::allocate_on_heap(std::size_t node_size)
+{
+    void* node = static_cast<std::byte*>(::operator new(header_size + node_size)) + header_size;
+    header_(node) = nullptr;
+    return node;
+}
+
+inline std::size_t node_arena::node_count() const
+{
+    if (!core_)
+        return 0;
+    std::lock_guard lock(core_->mutex);
+    std::size_t count = 0;
+    for (const block* arena_block : core_->blocks)
+        count += arena_block->live_count;
+    return count;
+}
+
+inline std::size_t node_arena::block_count() const
+{
+    if (!core_)
+        return 0;
+    std::lock_guard lock(core_->mutex);
+    return core_->blocks.size();
+}
+
+inline node_arena::block* node_arena::new_block_(core& arena_core, std::size_t slot_count)
+{
+    constexpr std::size_t block_header_size = (sizeof(block) + header_size - 1) / header_size * header_size;
+    std::byte* memory =
+        static_cast<std::byte*>(::operator new(block_header_size + slot_count * arena_core.slot_stride));
+    block* arena_block = new (memory) block{ .owner = &arena_core,
+                                             .slots = memory + block_header_size,
+                                             .slot_count = slot_count };
+    // The free list is built backwards: the slots are handed out in address order.
+    for (std::size_t i = slot_count; i-- > 0;)
+    {
+        void* node = arena_block->slots + i * arena_core.slot_stride + header_size;
+        header_(node) = arena_block;
+        next_free_(node) = arena_block->free_list;
+        arena_block->free_list = node;
+    }
+    return arena_block;
+}
+
+inline void* node_arena::pop_free_(block& arena_block) noexcept
+{
+    void* node = arena_block.free_list;
+    arena_block.free_list = next_free_(node);
+    ++arena_block.live_count;
+    return node;
+}
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "intrusive_ref_counter.hpp"
+#include "shared_segment.hpp"
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Releasing the last reference on an element of a shared_segment destroys it, and gives its memory back to the
+// segment, whichever process does it.
+template <class ElementType>
+    requires std::is_base_of_v<intrusive_type_base, ElementType>
+void offset_shared_intrusive_ptr_release(ElementType* ptr) noexcept
+{
+    if (ElementType::decrement_use_counter(ptr))
+    {
+        ptr->~ElementType();
+        shared_segment::deallocate(ptr);
+    }
+}
+
+// Shared pointer to an intrusive element allocated in a shared_segment. The pointed element is stored as an offset
+// relative to the address of the pointer itself: a pointer stored in a segment is valid in every process, whatever
+// the address at which the segment is mapped. The counter of the element must be thread safe, its atomic being
+// lock-free, hence usable from several processes.
+template <class Type>
+class offset_shared_intrusive_ptr
+{
+public:
+    using element_type = Type;
+
+    offset_shared_intrusive_ptr() noexcept = default;
+    inline offset_shared_intrusive_ptr(std::nullptr_t) noexcept {}
+    // pointer must be an element of a shared_segment.
+    explicit offset_shared_intrusive_ptr(element_type* pointer) noexcept;
+    offset_shared_intrusive_ptr(const offset_shared_intrusive_ptr& other) noexcept;
+    template <typename Up>
+        requires std::is_convertible_v<std::add_pointer_t<Up>, std::add_pointer_t<element_type>>
+    offset_shared_intrusive_ptr(const offset_shared_intrusive_ptr<Up>& other) noexcept;
+    offset_shared_intrusive_ptr(offset_shared_intrusive_ptr&& other) noexcept;
+    template <typename Up>
+        requires std::is_convertible_v<std::add_pointer_t<Up>, std::add_pointer_t<element_type>>
+    offset_shared_intrusive_ptr(offset_shared_intrusive_ptr<Up>&& other) noexcept;
+
+    ~offset_shared_intrusive_ptr();
+
+    offset_shared_intrusive_ptr& operator=(offset_shared_intrusive_ptr other) noexcept;
+
+    void reset() noexcept { *this = nullptr; }
+    inline void swap(offset_shared_intrusive_ptr& other) noexcept
+    {
+        element_type* pointer = get();
+        set_(other.get());
+        other.set_(pointer);
+    }
+
+    inline element_type* get() const noexcept
+    {
+        if (offset_ == null_offset)
+            return nullptr;
+        return reinterpret_cast<element_type*>(reinterpret_cast<std::intptr_t>(this) + offset_);
+    }
+    inline element_type& operator*() const noexcept { return *get(); }
+    inline element_type* operator->() const noexcept { return get(); }
+    inline explicit operator bool() const noexcept { return offset_ != null_offset; }
+
+    template <typename Up>
+    inline bool operator==(const offset_shared_intrusive_ptr<Up>& other) const noexcept
+    {
+        return get() == other.get();
+    }
+    inline bool operator==(std::nullptr_t) const noexcept { return offset_ == null_offset; }
+    template <typename Up>
+    inline std::strong_ordering operator<=>(const offset_shared_intrusive_ptr<Up>& other) const noexcept
+    {
+        return std::compare_three_way()(get(), other.get());
+    }
+
+private:
+    // An offset of 1 cannot reach an element: the pointer and the element are both aligned.
+    static constexpr std::intptr_t null_offset = 1;
+
+    inline void set_(element_type* pointer) noexcept
+    {
+        offset_ = pointer ? reinterpret_cast<std::intptr_t>(pointer) - reinterpret_cast<std::intptr_t>(this)
+                          : null_offset;
+    }
+
+    std::intptr_t offset_ = null_offset;
+
+    template <class OtherType>
+    friend class offset_shared_intrusive_ptr;
+};
+
+template <typename Type>
+inline offset_shared_intrusive_ptr<Type>::offset_shared_intrusive_ptr(element_type* pointer) noexcept
+{
+    set_(pointer);
+    if (pointer)
+        shared_intrusive_ptr_add_ref(pointer);
+}
+
+template <typename Type>
+inline offset_shared_intrusive_ptr<Type>::offset_shared_intrusive_ptr(
+    const offset_shared_intrusive_ptr& other) noexcept
+    : offset_shared_intrusive_ptr(other.get())
+{
+}
+
+template <typename Type>
+template <typename Up>
+    requires std::is_convertible_v<std::add_pointer_t<Up>, std::add_pointer_t<Type>>
+inline offset_shared_intrusive_ptr<Type>::offset_shared_intrusive_ptr(
+    const offset_shared_intrusive_ptr<Up>& other) noexcept
+    : offset_shared_intrusive_ptr(static_cast<element_type*>(other.get()))
+{
+}
+
+template <typename Type>
+inline offset_shared_intrusive_ptr<Type>::offset_shared_intrusive_ptr(offset_shared_intrusive_ptr&& other) noexcept
+{
+    set_(other.get());
+    other.set_(nullptr);
+}
+
+template <typename Type>
+template <typename Up>
+    requires std::is_convertible_v<std::add_pointer_t<Up>, std::add_pointer_t<Type>>
+inline offset_shared_intrusive_ptr<Type>::offset_shared_intrusive_ptr(
+    offset_shared_intrusive_ptr<Up>&& other) noexcept
+{
+    set_(static_cast<element_type*>(other.get()));
+    other.set_(nullptr);
+}
+
+template <typename Type>
+inline offset_shared_intrusive_ptr<Type>::~offset_shared_intrusive_ptr()
+{
+    if (element_type* pointer = get())
+        offset_shared_intrusive_ptr_release(pointer);
+}
+
+template <typename Type>
+inline offset_shared_intrusive_ptr<Type>&
+offset_shared_intrusive_ptr<Type>::operator=(offset_shared_intrusive_ptr other) noexcept
+{
+    swap(other);
+    return *this;
+}
+
+// Constructs an element in segment.
+template <typename Type, class... ArgsT>
+[[nodiscard]] offset_shared_intrusive_ptr<Type> make_offset_shared_intrusive_ptr(shared_segment& segment,
+                                                                                 ArgsT&&... args)
+{
+    static_assert(alignof(Type) <= shared_segment::block_alignment);
+    void* memory = segment.allocate(sizeof(Type));
+    try
+    {
+        return offset_shared_intrusive_ptr<Type>(new (memory) Type(std::forward<ArgsT>(args)...));
+    }
+    catch (...)
+    {
+        shared_segment::deallocate(memory);
+        throw;
+    }
+}
+
+// Root element of segment, which must have been set with the same Type.
+template <typename Type>
+[[nodiscard]] inline offset_shared_intrusive_ptr<Type> segment_root(const shared_segment& segment) noexcept
+{
+    return offset_shared_intrusive_ptr<Type>(static_cast<Type*>(segment.root()));
+}
+
+// The segment holds a shared reference on its root, released when the root is replaced. The previous root, if any,
+// must have been set with the same Type.
+template <typename Type>
+void set_segment_root(shared_segment& segment, const offset_shared_intrusive_ptr<Type>& root) noexcept
+{
+    if (Type* pointer = root.get())
+        shared_intrusive_ptr_add_ref(pointer);
+    if (void* previous_root = segment.exchange_root(root.get()))
+        offset_shared_intrusive_ptr_release(static_cast<Type*>(previous_root));
+}
+
+} // namespace itru
+} // namespace arba
+
+template <class value_type>
+struct std::hash<::arba::itru::offset_shared_intrusive_ptr<value_type>> : private std::hash<value_type*>
+{
+    std::size_t operator()(const ::arba::itru::offset_shared_intrusive_ptr<value_type>& ptr) const noexcept
+    {
+        return this->std::hash<value_type*>::operator()(ptr.get());
+    }
+};
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "policy/link_policy.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+inline namespace arba
+{
+namespace itru
+{
+
+struct parallel_options
+{
+    // 0: std::thread::hardware_concurrency().
+    unsigned thread_count = 0;
+    // 0: about four chunks per thread.
+    std::size_t chunk_size = 0;
+};
+
+// Boundaries of consecutive chunks of a list, found in one pass. They stay valid as long as no element is inserted
+// or erased, hence can be computed once then reused by several parallel algorithms.
+template <typename IteratorT>
+class list_chunks
+{
+public:
+    using iterator = IteratorT;
+
+    list_chunks() = default;
+    template <class ListT>
+    list_chunks(ListT& list, std::size_t chunk_size)
+    {
+        assert(chunk_size > 0);
+        boundaries_.reserve(list.size() / chunk_size + 2);
+        std::size_t index = 0;
+        for (iterator iter = list.begin(), end_iter = list.end(); iter != end_iter; ++iter, ++index)
+        {
+            if (index % chunk_size == 0)
+                boundaries_.push_back(iter);
+        }
+        boundaries_.push_back(list.end());
+        chunk_size_ = chunk_size;
+        element_count_ = index;
+    }
+
+    inline std::size_t size() const noexcept { return boundaries_.empty() ? 0 : boundaries_.size() - 1; }
+    inline std::size_t chunk_size() const noexcept { return chunk_size_; }
+    inline std::size_t element_count() const noexcept { return element_count_; }
+    inline iterator chunk_begin(std::size_t index) const noexcept { return boundaries_[index]; }
+    inline iterator chunk_end(std::size_t index) const noexcept { return boundaries_[index + 1]; }
+    // Position in the list of the first element of the chunk.
+    inline std::size_t chunk_offset(std::size_t index) const noexcept { return index * chunk_size_; }
+
+private:
+    std::vector<iterator> boundaries_;
+    std::size_t chunk_size_ = 0;
+    std::size_t element_count_ = 0;
+};
+
+template <class ListT>
+list_chunks(ListT&, std::size_t) -> list_chunks<decltype(std::declval<ListT&>().begin())>;
+
+namespace private_
+{
+inline unsigned thread_count(const parallel_options& options) noexcept
+{
+    return options.thread_count > 0 ? options.thread_count : std::max(1u, std::thread::hardware_concurrency());
+}
+
+template <class ListT>
+auto make_chunks(ListT& list, const parallel_options& options)
+{
+    std::size_t chunk_size = options.chunk_size;
+    if (chunk_size == 0)
+    {
+        const std::size_t chunk_count = std::size_t(thread_count(options)) * 4;
+        chunk_size = std::max<std::size_t>(1, (list.size() + chunk_count - 1) / chunk_count);
+    }
+    return list_chunks(list, chunk_size);
+}
+
+// Calls function(index) for each index in [0, count), on at most thread_count threads, the calling one included.
+// The first exception thrown by function is rethrown once every thread is done.
+template <class FunctionT>
+void run_parallel(std::size_t count, unsigned thread_count, FunctionT&& function)
+{
+    std::atomic<std::size_t> next_index = 0;
+    std::exception_ptr exception;
+    std::mutex exception_mutex;
+    auto worker = [&]
+    {
+        for (std::size_t index = next_index++; index < count; index = next_index++)
+        {
+            try
+            {
+                function(index);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(exception_mutex);
+                if (!exception)
+                    exception = std::current_exception();
+                next_index = count;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    const std::size_t worker_count = std::min<std::size_t>(thread_count, count);
+    try
+    {
+        threads.reserve(worker_count > 0 ? worker_count - 1 : 0);
+        for (std::size_t i = 1; i < worker_count; ++i)
+            threads.emplace_back(worker);
+    }
+    catch (...)
+    {
+        // A joinable std::thread must not be destroyed: the started workers are stopped then joined.
+        next_index = count;
+        for (std::thread& thread : threads)
+            thread.join();
+        throw;
+    }
+    worker();
+    for (std::thread& thread : threads)
+        thread.join();
+    if (exception)
+        std::rethrow_exception(exception);
+}
+} // namespace private_
+
+// Calls function on every element. Calls on different chunks run concurrently.
+template <class IteratorT, class FunctionT>
+void parallel_for_each(const list_chunks<IteratorT>& chunks, FunctionT function,
+                       const parallel_options& options = parallel_options())
+{
+    private_::run_parallel(chunks.size(), private_::thread_count(options),
+                           [&](std::size_t index)
+                           {
+                               for (IteratorT iter = chunks.chunk_begin(index), end_iter = chunks.chunk_end(index);
+                                    iter != end_iter; ++iter)
+                                   std::invoke(function, *iter);
+                           });
+}
+
+template <class ListT, class FunctionT>
+    requires requires(ListT& list) { list.begin(); list.size(); }
+void parallel_for_each(ListT& list, FunctionT function, const parallel_options& options = parallel_options())
+{
+    parallel_for_each(private_::make_chunks(list, options), std::move(function), options);
+}
+
+// Reduces the transformed elements, chunk by chunk then over the chunks in list order: reduce must be associative.
+template <class IteratorT, class ValueT, class ReduceT, class TransformT>
+ValueT parallel_transform_reduce(const list_chunks<IteratorT>& chunks, ValueT init, ReduceT reduce,
+                                 TransformT transform, const parallel_options& options = parallel_options())
+{
+    std::vector<std::optional<ValueT>> partials(chunks.size());
+    private_::run_parallel(chunks.size(), private_::thread_count(options),
+                           [&](std::size_t index)
+                           {
+                               IteratorT iter = chunks.chunk_begin(index);
+                               const IteratorT end_iter = chunks.chunk_end(index);
+                               ValueT partial = std::invoke(transform, *iter);
+                               for (++iter; iter != end_iter; ++iter)
+                                   partial = std::invoke(reduce, std::move(partial), std::invoke(transform, *iter));
+                               partials[index] = std::move(partial);
+                           });
+    for (std::optional<ValueT>& partial : partials)
+        init = std::invoke(reduce, std::move(init), std::move(*partial));
+    return init;
+}
+
+template <class ListT, class ValueT, class ReduceT, class TransformT>
+    requires requires(ListT& list) { list.begin(); list.size(); }
+ValueT parallel_transform_reduce(ListT& list, ValueT init, ReduceT reduce, TransformT transform,
+                                 const parallel_options& options = parallel_options())
+{
+    return parallel_transform_reduce(private_::make_chunks(list, options), std::move(init), std::move(reduce),
+                                     std::move(transform), options);
+}
+
+// Erases the elements satisfying predicate. The predicate is evaluated in parallel, then the matching elements are
+// unlinked in one pass by the calling thread. When the list owns its elements, the erased ones are kept alive while
+// unlinking, then their references are released in parallel, so that their destructors run neither under the
+// unlinking pass nor on a single thread. The links taken out of the list are the ones released: no counter is
+// touched while unlinking. Returns the number of erased elements.
+template <class ListT, class UnaryPredicate>
+typename ListT::size_type parallel_remove_if(ListT& list, UnaryPredicate predicate,
+                                             const parallel_options& options = parallel_options())
+{
+    using value_type = typename ListT::value_type;
+    constexpr bool owns_values = std::is_same_v<typename ListT::link_policy_type, shared_link_t>;
+
+    const auto chunks = private_::make_chunks(list, options);
+    const unsigned thread_count = private_::thread_count(options);
+    std::vector<std::uint8_t> erase_flags(chunks.element_count());
+    private_::run_parallel(chunks.size(), thread_count,
+                           [&](std::size_t index)
+                           {
+                               std::uint8_t* flag = erase_flags.data() + chunks.chunk_offset(index);
+                               for (auto iter = chunks.chunk_begin(index), end_iter = chunks.chunk_end(index);
+                                    iter != end_iter; ++iter, ++flag)
+                                   *flag = std::invoke(predicate, std::as_const(*iter)) ? 1 : 0;
+                           });
+
+    // Raw linked elements are not owned by the list: nothing to release.
+    std::conditional_t<owns_values, std::vector<shared_intrusive_ptr<value_type>>, std::nullptr_t> erased_values{};
+    if constexpr (owns_values)
+        erased_values.reserve(std::count(erase_flags.begin(), erase_flags.end(), std::uint8_t(1)));
+    typename ListT::size_type count = 0;
+    std::size_t position = 0;
+    for (auto iter = list.begin(), end_iter = list.end(); iter != end_iter; ++position)
+    {
+        if (erase_flags[position])
+        {
+            value_type& value = *iter++;
+            if constexpr (owns_values)
+                erased_values.push_back(list.extract(value));
+            else
+                list.unlink(value);
+            ++count;
+        }
+        else
+            ++iter;
+    }
+
+    if constexpr (owns_values)
+    {
+        const std::size_t release_chunk_size = std::max<std::size_t>(1, chunks.chunk_size());
+        private_::run_parallel((erased_values.size() + release_chunk_size - 1) / release_chunk_size, thread_count,
+                               [&](std::size_t index)
+                               {
+                                   const std::size_t first = index * release_chunk_size;
+                                   const std::size_t last = std::min(first + release_chunk_size, erased_values.size());
+                                   for (std::size_t i = first; i < last; ++i)
+                                       erased_values[i] = nullptr;
+                               });
+    }
+    return count;
+}
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,467 @@
+#pragma once
+
+#include "deferred_release.hpp"
+#include "intrusive_ref_counter.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+inline namespace arba
+{
+namespace itru
+{
+
+namespace private_
+{
+// Node of a hash array mapped trie. At each level, 5 bits of the hash code select a slot: a slot holds either an
+// entry, stored inline, or a child node (compressed by the datamap and nodemap bitmaps). Past the last bits of the
+// hash code, a node is a collision node: a plain array of entries.
+template <typename KeyT, typename ValueT>
+struct hamt_node : public intrusive_ref_counter<32>, public deferred_release_hook<hamt_node<KeyT, ValueT>>
+{
+    using entry_type = std::pair<KeyT, ValueT>;
+
+    hamt_node() = default;
+    hamt_node(const hamt_node& other)
+        : intrusive_ref_counter<32>(), deferred_release_hook<hamt_node>(), datamap(other.datamap),
+          nodemap(other.nodemap), entries(other.entries), children(other.children)
+    {
+    }
+    hamt_node& operator=(const hamt_node&) = delete;
+    ~hamt_node()
+    {
+        for (shared_intrusive_ptr<hamt_node>& child : children)
+            deferred_release(std::move(child));
+    }
+
+    std::uint32_t datamap = 0;
+    std::uint32_t nodemap = 0;
+    std::vector<entry_type> entries;
+    std::vector<shared_intrusive_ptr<hamt_node>> children;
+};
+} // namespace private_
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+class persistent_map_transient;
+
+// Immutable hash map with structural sharing: copying a map is O(1), and set() and erase() return a new version of
+// the map in O(log n), copying only the nodes along the path to the modified entry. The versions share the other
+// nodes, held by shared_intrusive_ptr with a compact counter.
+// A persistent_map_transient applies a batch of modifications in place: a node is copied only if another version
+// still references it, i.e. if it is not unique.
+template <typename KeyT, typename ValueT, typename HashT = std::hash<KeyT>, typename KeyEqualT = std::equal_to<KeyT>>
+class persistent_map
+{
+    using node_type = private_::hamt_node<KeyT, ValueT>;
+    using node_siptr = shared_intrusive_ptr<node_type>;
+
+public:
+    using key_type = KeyT;
+    using mapped_type = ValueT;
+    using value_type = typename node_type::entry_type;
+    using size_type = std::size_t;
+    using hasher = HashT;
+    using key_equal = KeyEqualT;
+    using transient_type = persistent_map_transient<KeyT, ValueT, HashT, KeyEqualT>;
+
+    static constexpr unsigned bits_per_level = 5;
+    static constexpr unsigned hash_bits = std::numeric_limits<std::size_t>::digits;
+    static constexpr unsigned max_depth = (hash_bits + bits_per_level - 1) / bits_per_level + 1;
+
+    class const_iterator
+    {
+    public:
+        using value_type = typename node_type::entry_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = const value_type&;
+        using pointer = const value_type*;
+        using iterator_category = std::forward_iterator_tag;
+
+        const_iterator() = default;
+
+        inline reference operator*() const noexcept { return *current_; }
+        inline pointer operator->() const noexcept { return current_; }
+        inline const_iterator& operator++() noexcept
+        {
+            advance_();
+            return *this;
+        }
+        inline const_iterator operator++(int) noexcept
+        {
+            const_iterator iter(*this);
+            advance_();
+            return iter;
+        }
+        inline bool operator==(const const_iterator& iter) const noexcept { return current_ == iter.current_; }
+
+    private:
+        struct frame
+        {
+            const node_type* node;
+            std::uint32_t entry_index;
+            std::uint32_t child_index;
+        };
+
+        explicit const_iterator(const node_type* root)
+        {
+            if (root)
+            {
+                stack_[depth_++] = frame{ root, 0, 0 };
+                advance_();
+            }
+        }
+
+        // Entries of a node first, then the entries of its children, depth first.
+        void advance_() noexcept
+        {
+            while (depth_ > 0)
+            {
+                frame& top = stack_[depth_ - 1];
+                if (top.entry_index < top.node->entries.size())
+                {
+                    current_ = &top.node->entries[top.entry_index++];
+                    return;
+                }
+                if (top.child_index < top.node->children.size())
+                {
+                    const node_type* child = top.node->children[top.child_index++].get();
+                    stack_[depth_++] = frame{ child, 0, 0 };
+                    continue;
+                }
+                --depth_;
+            }
+            current_ = nullptr;
+        }
+
+        std::array<frame, max_depth> stack_;
+        unsigned depth_ = 0;
+        const value_type* current_ = nullptr;
+
+        friend class persistent_map;
+    };
+    using iterator = const_iterator;
+
+    persistent_map() = default;
+
+    [[nodiscard]] inline size_type size() const noexcept { return size_; }
+    [[nodiscard]] inline bool empty() const noexcept { return size_ == 0; }
+
+    inline const_iterator begin() const noexcept { return const_iterator(root_.get()); }
+    inline const_iterator end() const noexcept { return const_iterator(); }
+
+    // Returns the value mapped to key, or nullptr.
+    [[nodiscard]] const mapped_type* find(const key_type& key) const;
+    [[nodiscard]] inline bool contains(const key_type& key) const { return find(key) != nullptr; }
+
+    // Returns a version of the map where key is mapped to value.
+    [[nodiscard]] persistent_map set(const key_type& key, mapped_type value) const&;
+    [[nodiscard]] persistent_map set(const key_type& key, mapped_type value) &&;
+    // Returns a version of the map without key.
+    [[nodiscard]] persistent_map erase(const key_type& key) const&;
+    [[nodiscard]] persistent_map erase(const key_type& key) &&;
+
+    [[nodiscard]] transient_type transient() const& { return transient_type(*this); }
+    [[nodiscard]] transient_type transient() && { return transient_type(std::move(*this)); }
+
+private:
+    // Returns the node of slot, replaced by a copy of it first if it is referenced elsewhere. slot is left unchanged
+    // if the copy throws.
+    inline static node_type& editable_(node_siptr& slot)
+    {
+        if (!shared_intrusive_ptr_is_unique(slot.get()))
+            slot = make_shared_intrusive_ptr<node_type>(*slot);
+        return *slot;
+    }
+    inline static std::uint32_t bit_(std::size_t hash, unsigned shift) noexcept
+    {
+        return std::uint32_t(1) << ((hash >> shift) & 31);
+    }
+    inline static std::size_t index_(std::uint32_t bitmap, std::uint32_t bit) noexcept
+    {
+        return std::popcount(bitmap & (bit - 1));
+    }
+
+    // The modifications below apply in place to the unique nodes, and copy the other ones. Each node is modified only
+    // once nothing can throw anymore: if the hasher, key_equal or an allocation throws, the map is left unchanged.
+    bool set_(const key_type& key, mapped_type&& value);
+    bool erase_(const key_type& key);
+    void set_(node_siptr& slot, std::size_t hash, unsigned shift, const key_type& key, mapped_type&& value,
+              bool& inserted);
+    static node_siptr merge_(value_type&& entry, std::size_t entry_hash, value_type&& new_entry,
+                             std::size_t new_hash, unsigned shift);
+    void erase_(node_siptr& slot, std::size_t hash, unsigned shift, const key_type& key);
+
+    node_siptr root_;
+    size_type size_ = 0;
+    [[no_unique_address]] hasher hash_function_;
+    [[no_unique_address]] key_equal key_equal_;
+
+    friend class persistent_map_transient<KeyT, ValueT, HashT, KeyEqualT>;
+};
+
+// Mutable view of a persistent_map, for batch modifications: the nodes it is the only one to reference are modified
+// in place. persistent() returns the current version, which the next modifications of the transient leave intact.
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+class persistent_map_transient
+{
+public:
+    using map_type = persistent_map<KeyT, ValueT, HashT, KeyEqualT>;
+    using key_type = typename map_type::key_type;
+    using mapped_type = typename map_type::mapped_type;
+    using size_type = typename map_type::size_type;
+
+    explicit persistent_map_transient(map_type map) : map_(std::move(map)) {}
+
+    [[nodiscard]] inline size_type size() const noexcept { return map_.size(); }
+    [[nodiscard]] inline bool empty() const noexcept { return map_.empty(); }
+    [[nodiscard]] inline const mapped_type* find(const key_type& key) const { return map_.find(key); }
+    [[nodiscard]] inline bool contains(const key_type& key) const { return map_.contains(key); }
+
+    // Returns true if key was inserted, false if its value was replaced.
+    inline bool set(const key_type& key, mapped_type value) { return map_.set_(key, std::move(value)); }
+    // Returns true if key was erased.
+    inline bool erase(const key_type& key) { return map_.erase_(key); }
+
+    [[nodiscard]] inline map_type persistent() const& { return map_; }
+    [[nodiscard]] inline map_type persistent() && { return std::move(map_); }
+
+private:
+    map_type map_;
+};
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+const ValueT* persistent_map<KeyT, ValueT, HashT, KeyEqualT>::find(const key_type& key) const
+{
+    const std::size_t hash = hash_function_(key);
+    const node_type* node = root_.get();
+    for (unsigned shift = 0; node; shift += bits_per_level)
+    {
+        if (shift >= hash_bits)
+        {
+            for (const value_type& entry : node->entries)
+            {
+                if (key_equal_(entry.first, key))
+                    return &entry.second;
+            }
+            return nullptr;
+        }
+        const std::uint32_t bit = bit_(hash, shift);
+        if (node->datamap & bit)
+        {
+            const value_type& entry = node->entries[index_(node->datamap, bit)];
+            return key_equal_(entry.first, key) ? &entry.second : nullptr;
+        }
+        if (!(node->nodemap & bit))
+            return nullptr;
+        node = node->children[index_(node->nodemap, bit)].get();
+    }
+    return nullptr;
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+persistent_map<KeyT, ValueT, HashT, KeyEqualT>
+persistent_map<KeyT, ValueT, HashT, KeyEqualT>::set(const key_type& key, mapped_type value) const&
+{
+    persistent_map map(*this);
+    map.set_(key, std::move(value));
+    return map;
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+persistent_map<KeyT, ValueT, HashT, KeyEqualT>
+persistent_map<KeyT, ValueT, HashT, KeyEqualT>::set(const key_type& key, mapped_type value) &&
+{
+    set_(key, std::move(value));
+    return std::move(*this);
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+persistent_map<KeyT, ValueT, HashT, KeyEqualT>
+persistent_map<KeyT, ValueT, HashT, KeyEqualT>::erase(const key_type& key) const&
+{
+    persistent_map map(*this);
+    map.erase_(key);
+    return map;
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+persistent_map<KeyT, ValueT, HashT, KeyEqualT>
+persistent_map<KeyT, ValueT, HashT, KeyEqualT>::erase(const key_type& key) &&
+{
+    erase_(key);
+    return std::move(*this);
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+bool persistent_map<KeyT, ValueT, HashT, KeyEqualT>::set_(const key_type& key, mapped_type&& value)
+{
+    const std::size_t hash = hash_function_(key);
+    bool inserted = false;
+    if (root_)
+        set_(root_, hash, 0, key, std::move(value), inserted);
+    else
+    {
+        node_siptr root = make_shared_intrusive_ptr<node_type>();
+        set_(root, hash, 0, key, std::move(value), inserted);
+        root_ = std::move(root);
+    }
+    size_ += inserted ? 1 : 0;
+    return inserted;
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+bool persistent_map<KeyT, ValueT, HashT, KeyEqualT>::erase_(const key_type& key)
+{
+    // Looked up first: erasing a missing key copies nothing.
+    if (!contains(key))
+        return false;
+    erase_(root_, hash_function_(key), 0, key);
+    --size_;
+    return true;
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+void persistent_map<KeyT, ValueT, HashT, KeyEqualT>::set_(node_siptr& slot, std::size_t hash, unsigned shift,
+                                                          const key_type& key, mapped_type&& value, bool& inserted)
+{
+    node_type& node = editable_(slot);
+    if (shift >= hash_bits)
+    {
+        for (value_type& entry : node.entries)
+        {
+            if (key_equal_(entry.first, key))
+            {
+                entry.second = std::move(value);
+                return;
+            }
+        }
+        node.entries.emplace_back(key, std::move(value));
+        inserted = true;
+        return;
+    }
+
+    const std::uint32_t bit = bit_(hash, shift);
+    if (node.datamap & bit)
+    {
+        const std::size_t index = index_(node.datamap, bit);
+        if (key_equal_(node.entries[index].first, key))
+        {
+            node.entries[index].second = std::move(value);
+            return;
+        }
+        // Two keys share this slot: they are pushed down in a new child, built before the entry leaves this node.
+        const std::size_t entry_hash = hash_function_(node.entries[index].first);
+        node.children.reserve(node.children.size() + 1);
+        node_siptr child = merge_(std::move(node.entries[index]), entry_hash, value_type(key, std::move(value)), hash,
+                                  shift + bits_per_level);
+        node.entries.erase(node.entries.begin() + index);
+        node.datamap &= ~bit;
+        node.children.insert(node.children.begin() + index_(node.nodemap, bit), std::move(child));
+        node.nodemap |= bit;
+        inserted = true;
+    }
+    else if (node.nodemap & bit)
+        set_(node.children[index_(node.nodemap, bit)], hash, shift + bits_per_level, key, std::move(value), inserted);
+    else
+    {
+        node.entries.emplace(node.entries.begin() + index_(node.datamap, bit), key, std::move(value));
+        node.datamap |= bit;
+        inserted = true;
+    }
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+typename persistent_map<KeyT, ValueT, HashT, KeyEqualT>::node_siptr
+persistent_map<KeyT, ValueT, HashT, KeyEqualT>::merge_(value_type&& entry, std::size_t entry_hash,
+                                                       value_type&& new_entry, std::size_t new_hash, unsigned shift)
+{
+    // The entries are moved only once the capacity they are moved into is allocated.
+    node_siptr node = make_shared_intrusive_ptr<node_type>();
+    if (shift >= hash_bits)
+    {
+        node->entries.reserve(2);
+        node->entries.push_back(std::move(entry));
+        node->entries.push_back(std::move(new_entry));
+        return node;
+    }
+    const std::uint32_t entry_bit = bit_(entry_hash, shift);
+    const std::uint32_t bit = bit_(new_hash, shift);
+    if (entry_bit == bit)
+    {
+        node->children.reserve(1);
+        node->children.push_back(
+            merge_(std::move(entry), entry_hash, std::move(new_entry), new_hash, shift + bits_per_level));
+        node->nodemap = bit;
+        return node;
+    }
+    node->entries.reserve(2);
+    if (entry_bit < bit)
+    {
+        node->entries.push_back(std::move(entry));
+        node->entries.push_back(std::move(new_entry));
+    }
+    else
+    {
+        node->entries.push_back(std::move(new_entry));
+        node->entries.push_back(std::move(entry));
+    }
+    node->datamap = entry_bit | bit;
+    return node;
+}
+
+template <typename KeyT, typename ValueT, typename HashT, typename KeyEqualT>
+void persistent_map<KeyT, ValueT, HashT, KeyEqualT>::erase_(node_siptr& slot, std::size_t hash, unsigned shift,
+                                                            const key_type& key)
+{
+    // The key is known to be present.
+    node_type& node = editable_(slot);
+    if (shift >= hash_bits)
+    {
+        for (auto iter = node.entries.begin(); iter != node.entries.end(); ++iter)
+        {
+            if (key_equal_(iter->first, key))
+            {
+                node.entries.erase(iter);
+                break;
+            }
+        }
+    }
+    else if (const std::uint32_t bit = bit_(hash, shift); node.datamap & bit)
+    {
+        node.entries.erase(node.entries.begin() + index_(node.datamap, bit));
+        node.datamap &= ~bit;
+    }
+    else
+    {
+        const std::size_t child_index = index_(node.nodemap, bit);
+        node_siptr& child = node.children[child_index];
+        // A child left with a single entry is inlined: the trie stays canonical. Room for it is made beforehand.
+        if (child->entries.size() + child->children.size() <= 2)
+            node.entries.reserve(node.entries.size() + 1);
+        erase_(child, hash, shift + bits_per_level, key);
+        if (!child || (child->children.empty() && child->entries.size() == 1))
+        {
+            if (child)
+            {
+                node.entries.insert(node.entries.begin() + index_(node.datamap, bit),
+                                    std::move(child->entries.front()));
+                node.datamap |= bit;
+            }
+            node.children.erase(node.children.begin() + child_index);
+            node.nodemap &= ~bit;
+        }
+    }
+    if (node.entries.empty() && node.children.empty())
+        slot = nullptr;
+}
+
+} // namespace itru
+} // namespace arba
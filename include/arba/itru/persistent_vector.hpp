@@ -0,0 +1,385 @@
+#pragma once
+
+#include "deferred_release.hpp"
+#include "intrusive_ref_counter.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+inline namespace arba
+{
+namespace itru
+{
+
+namespace private_
+{
+// Node of a radix trie: an inner node holds up to 32 children, a leaf up to 32 values.
+template <typename ValueT>
+struct radix_node : public intrusive_ref_counter<32>, public deferred_release_hook<radix_node<ValueT>>
+{
+    radix_node() = default;
+    radix_node(const radix_node& other)
+        : intrusive_ref_counter<32>(), deferred_release_hook<radix_node>(), children(other.children),
+          values(other.values)
+    {
+    }
+    radix_node& operator=(const radix_node&) = delete;
+    ~radix_node()
+    {
+        for (shared_intrusive_ptr<radix_node>& child : children)
+            deferred_release(std::move(child));
+    }
+
+    std::vector<shared_intrusive_ptr<radix_node>> children;
+    std::vector<ValueT> values;
+};
+} // namespace private_
+
+template <typename ValueT>
+class persistent_vector_transient;
+
+// Immutable vector with structural sharing: copying a vector is O(1), and push_back(), pop_back() and set() return a
+// new version of the vector in O(log32 n), copying only the nodes along the path to the modified element. The
+// elements are stored in the leaves of a 32-way radix trie, but for the last ones, which stay in a tail leaf.
+// A persistent_vector_transient applies a batch of modifications in place: a node is copied only if another version
+// still references it, i.e. if it is not unique.
+template <typename ValueT>
+class persistent_vector
+{
+    using node_type = private_::radix_node<ValueT>;
+    using node_siptr = shared_intrusive_ptr<node_type>;
+
+public:
+    using value_type = ValueT;
+    using size_type = std::size_t;
+    using const_reference = const value_type&;
+    using transient_type = persistent_vector_transient<ValueT>;
+
+    static constexpr unsigned bits_per_level = 5;
+    static constexpr size_type node_capacity = size_type(1) << bits_per_level;
+
+    class const_iterator
+    {
+    public:
+        using value_type = ValueT;
+        using difference_type = std::ptrdiff_t;
+        using reference = const value_type&;
+        using pointer = const value_type*;
+        using iterator_category = std::forward_iterator_tag;
+
+        const_iterator() = default;
+
+        inline reference operator*() const noexcept { return leaf_[index_ % node_capacity]; }
+        inline pointer operator->() const noexcept { return &**this; }
+        inline const_iterator& operator++() noexcept
+        {
+            // The leaf is looked up once every node_capacity elements.
+            if (++index_ % node_capacity == 0 && index_ < vector_->size())
+                leaf_ = vector_->leaf_values_(index_);
+            return *this;
+        }
+        inline const_iterator operator++(int) noexcept
+        {
+            const_iterator iter(*this);
+            ++(*this);
+            return iter;
+        }
+        inline bool operator==(const const_iterator& iter) const noexcept { return index_ == iter.index_; }
+
+    private:
+        const_iterator(const persistent_vector* vector, size_type index)
+            : vector_(vector), leaf_(index < vector->size() ? vector->leaf_values_(index) : nullptr), index_(index)
+        {
+        }
+
+        const persistent_vector* vector_ = nullptr;
+        const value_type* leaf_ = nullptr;
+        size_type index_ = 0;
+
+        friend class persistent_vector;
+    };
+    using iterator = const_iterator;
+
+    persistent_vector() = default;
+
+    [[nodiscard]] inline size_type size() const noexcept { return size_; }
+    [[nodiscard]] inline bool empty() const noexcept { return size_ == 0; }
+
+    inline const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    inline const_iterator end() const noexcept { return const_iterator(this, size_); }
+
+    [[nodiscard]] inline const_reference operator[](size_type index) const noexcept
+    {
+        assert(index < size_);
+        return leaf_values_(index)[index % node_capacity];
+    }
+    [[nodiscard]] inline const_reference front() const noexcept { return (*this)[0]; }
+    [[nodiscard]] inline const_reference back() const noexcept { return (*this)[size_ - 1]; }
+
+    // Returns a version of the vector with value appended.
+    [[nodiscard]] persistent_vector push_back(value_type value) const&;
+    [[nodiscard]] persistent_vector push_back(value_type value) &&;
+    // Returns a version of the vector without its last element. The vector must not be empty.
+    [[nodiscard]] persistent_vector pop_back() const&;
+    [[nodiscard]] persistent_vector pop_back() &&;
+    // Returns a version of the vector where the element at index is value.
+    [[nodiscard]] persistent_vector set(size_type index, value_type value) const&;
+    [[nodiscard]] persistent_vector set(size_type index, value_type value) &&;
+
+    [[nodiscard]] transient_type transient() const& { return transient_type(*this); }
+    [[nodiscard]] transient_type transient() && { return transient_type(std::move(*this)); }
+
+private:
+    // Returns the node of slot, replaced by a copy of it first if it is referenced elsewhere. slot is left unchanged
+    // if the copy throws.
+    inline static node_type& editable_(node_siptr& slot)
+    {
+        if (!shared_intrusive_ptr_is_unique(slot.get()))
+            slot = make_shared_intrusive_ptr<node_type>(*slot);
+        return *slot;
+    }
+    // Index of the first element of the tail.
+    inline size_type tail_offset_() const noexcept
+    {
+        return size_ < node_capacity ? 0 : ((size_ - 1) >> bits_per_level) << bits_per_level;
+    }
+    const value_type* leaf_values_(size_type index) const noexcept;
+
+    // The modifications below apply in place to the unique nodes, and copy the other ones. Each node is modified only
+    // once nothing can throw anymore: if an allocation throws, the vector is left unchanged.
+    void push_back_(value_type&& value);
+    void pop_back_();
+    void set_(size_type index, value_type&& value);
+    void push_tail_(node_siptr& slot, unsigned shift, const node_siptr& leaf);
+    static node_siptr new_path_(unsigned shift, node_siptr leaf);
+    static void pop_tail_(node_siptr& slot, unsigned shift, node_siptr& leaf);
+
+    node_siptr root_;
+    node_siptr tail_;
+    size_type size_ = 0;
+    unsigned shift_ = bits_per_level;
+
+    friend class persistent_vector_transient<ValueT>;
+};
+
+// Mutable view of a persistent_vector, for batch modifications: the nodes it is the only one to reference are
+// modified in place. persistent() returns the current version, which the next modifications of the transient leave
+// intact.
+template <typename ValueT>
+class persistent_vector_transient
+{
+public:
+    using vector_type = persistent_vector<ValueT>;
+    using value_type = typename vector_type::value_type;
+    using size_type = typename vector_type::size_type;
+    using const_reference = typename vector_type::const_reference;
+
+    explicit persistent_vector_transient(vector_type vector) : vector_(std::move(vector)) {}
+
+    [[nodiscard]] inline size_type size() const noexcept { return vector_.size(); }
+    [[nodiscard]] inline bool empty() const noexcept { return vector_.empty(); }
+    [[nodiscard]] inline const_reference operator[](size_type index) const noexcept { return vector_[index]; }
+
+    inline void push_back(value_type value) { vector_.push_back_(std::move(value)); }
+    inline void pop_back() { vector_.pop_back_(); }
+    inline void set(size_type index, value_type value) { vector_.set_(index, std::move(value)); }
+
+    [[nodiscard]] inline vector_type persistent() const& { return vector_; }
+    [[nodiscard]] inline vector_type persistent() && { return std::move(vector_); }
+
+private:
+    vector_type vector_;
+};
+
+template <typename ValueT>
+const ValueT* persistent_vector<ValueT>::leaf_values_(size_type index) const noexcept
+{
+    if (index >= tail_offset_())
+        return tail_->values.data();
+    const node_type* node = root_.get();
+    for (unsigned shift = shift_; shift > 0; shift -= bits_per_level)
+        node = node->children[(index >> shift) & (node_capacity - 1)].get();
+    return node->values.data();
+}
+
+template <typename ValueT>
+persistent_vector<ValueT> persistent_vector<ValueT>::push_back(value_type value) const&
+{
+    persistent_vector vector(*this);
+    vector.push_back_(std::move(value));
+    return vector;
+}
+
+template <typename ValueT>
+persistent_vector<ValueT> persistent_vector<ValueT>::push_back(value_type value) &&
+{
+    push_back_(std::move(value));
+    return std::move(*this);
+}
+
+template <typename ValueT>
+persistent_vector<ValueT> persistent_vector<ValueT>::pop_back() const&
+{
+    persistent_vector vector(*this);
+    vector.pop_back_();
+    return vector;
+}
+
+template <typename ValueT>
+persistent_vector<ValueT> persistent_vector<ValueT>::pop_back() &&
+{
+    pop_back_();
+    return std::move(*this);
+}
+
+template <typename ValueT>
+persistent_vector<ValueT> persistent_vector<ValueT>::set(size_type index, value_type value) const&
+{
+    persistent_vector vector(*this);
+    vector.set_(index, std::move(value));
+    return vector;
+}
+
+template <typename ValueT>
+persistent_vector<ValueT> persistent_vector<ValueT>::set(size_type index, value_type value) &&
+{
+    set_(index, std::move(value));
+    return std::move(*this);
+}
+
+template <typename ValueT>
+void persistent_vector<ValueT>::push_back_(value_type&& value)
+{
+    if (!tail_ || tail_->values.size() < node_capacity)
+    {
+        node_type& tail = tail_ ? editable_(tail_) : *(tail_ = make_shared_intrusive_ptr<node_type>());
+        if (tail.values.empty())
+            tail.values.reserve(node_capacity);
+        tail.values.push_back(std::move(value));
+        ++size_;
+        return;
+    }
+    // The full tail moves into the trie, which grows by one level when its root is full. The new tail is built first,
+    // and tail_ is replaced only once the trie references the full tail.
+    node_siptr tail = make_shared_intrusive_ptr<node_type>();
+    tail->values.reserve(node_capacity);
+    tail->values.push_back(std::move(value));
+    if (!root_)
+    {
+        node_siptr root = make_shared_intrusive_ptr<node_type>();
+        root->children.push_back(tail_);
+        root_ = std::move(root);
+    }
+    else if (((size_ - node_capacity) >> bits_per_level) >= (size_type(1) << shift_))
+    {
+        node_siptr path = new_path_(shift_, tail_);
+        node_siptr root = make_shared_intrusive_ptr<node_type>();
+        root->children.reserve(2);
+        root->children.push_back(root_);
+        root->children.push_back(std::move(path));
+        root_ = std::move(root);
+        shift_ += bits_per_level;
+    }
+    else
+        push_tail_(root_, shift_, tail_);
+    tail_ = std::move(tail);
+    ++size_;
+}
+
+template <typename ValueT>
+void persistent_vector<ValueT>::pop_back_()
+{
+    assert(size_ > 0);
+    if (size_ == 1)
+    {
+        tail_ = nullptr;
+        size_ = 0;
+        return;
+    }
+    if (tail_->values.size() > 1)
+    {
+        editable_(tail_).values.pop_back();
+        --size_;
+        return;
+    }
+    // The tail empties: the last leaf of the trie becomes the tail.
+    node_siptr leaf;
+    pop_tail_(root_, shift_, leaf);
+    tail_ = std::move(leaf);
+    --size_;
+    if (shift_ > bits_per_level && root_->children.size() == 1)
+    {
+        node_siptr child = std::move(root_->children.front());
+        root_ = std::move(child);
+        shift_ -= bits_per_level;
+    }
+}
+
+template <typename ValueT>
+void persistent_vector<ValueT>::set_(size_type index, value_type&& value)
+{
+    assert(index < size_);
+    if (index >= tail_offset_())
+    {
+        editable_(tail_).values[index % node_capacity] = std::move(value);
+        return;
+    }
+    node_type* node = &editable_(root_);
+    for (unsigned shift = shift_; shift > 0; shift -= bits_per_level)
+        node = &editable_(node->children[(index >> shift) & (node_capacity - 1)]);
+    node->values[index % node_capacity] = std::move(value);
+}
+
+template <typename ValueT>
+void persistent_vector<ValueT>::push_tail_(node_siptr& slot, unsigned shift, const node_siptr& leaf)
+{
+    // leaf becomes the last leaf of the trie, i.e. holds the elements from size_ - node_capacity.
+    node_type& node = editable_(slot);
+    const size_type child_index = ((size_ - node_capacity) >> shift) & (node_capacity - 1);
+    if (shift == bits_per_level)
+        node.children.push_back(leaf);
+    else if (child_index < node.children.size())
+        push_tail_(node.children[child_index], shift - bits_per_level, leaf);
+    else
+        node.children.push_back(new_path_(shift - bits_per_level, leaf));
+}
+
+template <typename ValueT>
+typename persistent_vector<ValueT>::node_siptr persistent_vector<ValueT>::new_path_(unsigned shift, node_siptr leaf)
+{
+    for (; shift > 0; shift -= bits_per_level)
+    {
+        node_siptr node = make_shared_intrusive_ptr<node_type>();
+        node->children.push_back(std::move(leaf));
+        leaf = std::move(node);
+    }
+    return leaf;
+}
+
+template <typename ValueT>
+void persistent_vector<ValueT>::pop_tail_(node_siptr& slot, unsigned shift, node_siptr& leaf)
+{
+    // Moves the last leaf of the trie into leaf. The nodes are copied on the way down, and modified on the way up.
+    node_type& node = editable_(slot);
+    if (shift > bits_per_level)
+    {
+        node_siptr& child = node.children.back();
+        pop_tail_(child, shift - bits_per_level, leaf);
+        if (!child)
+            node.children.pop_back();
+    }
+    else
+    {
+        leaf = std::move(node.children.back());
+        node.children.pop_back();
+    }
+    if (node.children.empty())
+        slot = nullptr;
+}
+
+} // namespace itru
+} // namespace arba
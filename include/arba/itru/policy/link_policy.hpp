@@ -0,0 +1,47 @@
+#pragma once
+
+#include <arba/itru/shared_intrusive_ptr.hpp>
+
+#include <type_traits>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// The link to the next node owns it (shared_intrusive_ptr): the list keeps its nodes alive.
+struct shared_link_t
+{
+};
+
+// The link to the next node is a raw pointer: nodes are owned elsewhere, the list only indexes them.
+struct raw_link_t
+{
+};
+
+template <class PolicyT>
+concept LinkPolicy = std::is_same_v<PolicyT, shared_link_t> || std::is_same_v<PolicyT, raw_link_t>;
+
+template <class NodeT, LinkPolicy lk_policy>
+struct link_traits;
+
+template <class NodeT>
+struct link_traits<NodeT, shared_link_t>
+{
+    using link_type = shared_intrusive_ptr<NodeT>;
+
+    inline static NodeT* address(const link_type& link) noexcept { return link.get(); }
+    inline static link_type make_link(NodeT* ptr) noexcept { return link_type(ptr); }
+};
+
+template <class NodeT>
+struct link_traits<NodeT, raw_link_t>
+{
+    using link_type = NodeT*;
+
+    inline static NodeT* address(link_type link) noexcept { return link; }
+    inline static link_type make_link(NodeT* ptr) noexcept { return ptr; }
+};
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,26 @@
+#pragma once
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <xmmintrin.h>
+#endif
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Hints the processor to bring the cache line of address into the cache, for a read. Has no observable effect:
+// address may be null or dangling.
+inline void prefetch(const void* address) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "policy/link_policy.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Pairing heap node: a node owns its first child and its next sibling, previous() is the previous sibling or,
+// for a first child, the parent.
+template <typename IntrusiveHeapNodeT, LinkPolicy lk_policy = shared_link_t>
+class sharable_intrusive_heap_hook
+{
+public:
+    using link_policy_type = lk_policy;
+    using link_traits_type = link_traits<IntrusiveHeapNodeT, lk_policy>;
+    using link_type = typename link_traits_type::link_type;
+
+    inline IntrusiveHeapNodeT* previous() const noexcept { return previous_; }
+    inline IntrusiveHeapNodeT*& previous() noexcept { return previous_; }
+    inline const link_type& first_child() const noexcept { return first_child_; }
+    inline link_type& first_child() noexcept { return first_child_; }
+    inline IntrusiveHeapNodeT* first_child_pointer() const noexcept { return link_traits_type::address(first_child_); }
+    inline const link_type& next_sibling() const noexcept { return next_sibling_; }
+    inline link_type& next_sibling() noexcept { return next_sibling_; }
+    inline IntrusiveHeapNodeT* next_sibling_pointer() const noexcept
+    {
+        return link_traits_type::address(next_sibling_);
+    }
+
+private:
+    IntrusiveHeapNodeT* previous_ = nullptr;
+    link_type first_child_ = nullptr;
+    link_type next_sibling_ = nullptr;
+};
+
+template <typename IntrusiveHeapNodeT, LinkPolicy lk_policy>
+sharable_intrusive_heap_hook<IntrusiveHeapNodeT, lk_policy>*
+heap_hook_base(const sharable_intrusive_heap_hook<IntrusiveHeapNodeT, lk_policy>*);
+
+template <typename IntrusiveT>
+using heap_hook_t = std::remove_pointer_t<decltype(heap_hook_base(std::declval<IntrusiveT*>()))>;
+
+} // namespace itru
+} // namespace arba
@@ -1,13 +1,22 @@
 #pragma once
 
+#include "policy/link_policy.hpp"
+#include "prefetch.hpp"
+#include "sharable_intrusive_list_hook.hpp"
 #include "shared_intrusive_ptr.hpp"
 
+#include <array>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+
 inline namespace arba
 {
 namespace itru
 {
 
-template <typename IntrusiveT>
+template <typename IntrusiveT, typename HookAccessorT = base_list_hook_accessor<std::remove_const_t<IntrusiveT>>>
 class sharable_intrusive_list_iterator
 {
 public:
@@ -20,7 +29,7 @@ public:
     explicit sharable_intrusive_list_iterator(IntrusiveT& node_ref) : pointer_(&node_ref) {}
 
     inline sharable_intrusive_list_iterator(
-        sharable_intrusive_list_iterator<std::remove_const_t<IntrusiveT>> const& iter)
+        sharable_intrusive_list_iterator<std::remove_const_t<IntrusiveT>, HookAccessorT> const& iter)
         : pointer_(iter.ptr())
     {
     }
@@ -29,7 +38,7 @@ public:
 
     sharable_intrusive_list_iterator& operator++() noexcept
     {
-        pointer_ = pointer_->next().get();
+        pointer_ = HookAccessorT::hook(*pointer_).next_pointer();
         return *this;
     }
     sharable_intrusive_list_iterator operator++(int) noexcept
@@ -40,7 +49,7 @@ public:
     }
     sharable_intrusive_list_iterator& operator--() noexcept
     {
-        pointer_ = pointer_->previous();
+        pointer_ = HookAccessorT::hook(*pointer_).previous();
         return *this;
     }
     sharable_intrusive_list_iterator operator--(int) noexcept
@@ -67,7 +76,8 @@ private:
     pointer pointer_;
 };
 
-template <typename IntrusiveT, typename SentinelT = IntrusiveT>
+template <typename IntrusiveT, typename SentinelT = IntrusiveT,
+          typename HookAccessorT = base_list_hook_accessor<IntrusiveT>>
 class sharable_intrusive_list
 {
 public:
@@ -77,17 +87,27 @@ public:
     using const_reference = std::add_lvalue_reference_t<std::add_const_t<value_type>>;
     using pointer = std::add_pointer_t<value_type>;
     using const_pointer = std::add_pointer_t<std::add_const_t<value_type>>;
-    using iterator = sharable_intrusive_list_iterator<value_type>;
-    using const_iterator = sharable_intrusive_list_iterator<const value_type>;
+    using iterator = sharable_intrusive_list_iterator<value_type, HookAccessorT>;
+    using const_iterator = sharable_intrusive_list_iterator<const value_type, HookAccessorT>;
     using difference_type = std::ptrdiff_t;
     using value_siptr_type = shared_intrusive_ptr<value_type>;
+    using hook_accessor_type = HookAccessorT;
+    using hook_type = typename HookAccessorT::hook_type;
+    using link_policy_type = typename hook_type::link_policy_type;
+    using link_traits_type = link_traits<value_type, link_policy_type>;
+    using value_link_type = typename link_traits_type::link_type;
+
+    static constexpr bool owns_values = std::is_same_v<link_policy_type, shared_link_t>;
+    static constexpr size_type default_prefetch_distance = 8;
 
 public:
     sharable_intrusive_list();
     explicit sharable_intrusive_list(SentinelT sentinel);
+    sharable_intrusive_list(sharable_intrusive_list&& other);
+    ~sharable_intrusive_list();
 
-    inline const_iterator begin() const noexcept { return const_iterator(*sentinel_.next()); }
-    inline iterator begin() noexcept { return iterator(*sentinel_.next()); }
+    inline const_iterator begin() const noexcept { return const_iterator(*hook_(sentinel_).next_pointer()); }
+    inline iterator begin() noexcept { return iterator(*hook_(sentinel_).next_pointer()); }
     inline const_iterator cbegin() const noexcept { return begin(); }
 
     inline const_iterator end() const noexcept { return const_iterator(sentinel_); }
@@ -97,27 +117,30 @@ public:
     inline bool empty() const noexcept { return size_ == 0; }
     inline std::size_t size() const noexcept { return size_; }
 
-    inline const_reference front() const noexcept { return *sentinel_.next(); }
-    inline reference front() noexcept { return *sentinel_.next(); }
+    inline const_reference front() const noexcept { return *hook_(sentinel_).next_pointer(); }
+    inline reference front() noexcept { return *hook_(sentinel_).next_pointer(); }
 
-    inline const_reference back() const noexcept { return *sentinel_.previous(); }
-    inline reference back() noexcept { return *sentinel_.previous(); }
+    inline const_reference back() const noexcept { return *hook_(sentinel_).previous(); }
+    inline reference back() noexcept { return *hook_(sentinel_).previous(); }
 
-    void push_front(value_siptr_type value_siptr);
-    void push_back(value_siptr_type value_siptr);
-    const_iterator insert(const_iterator iter, value_siptr_type value_siptr);
+    void push_front(value_link_type value_link);
+    void push_back(value_link_type value_link);
+    const_iterator insert(const_iterator iter, value_link_type value_link);
 
     template <class... ArgsT>
+        requires owns_values
     inline void emplace_front(ArgsT&&... args)
     {
         push_front(make_shared_intrusive_ptr<value_type>(std::forward<ArgsT>(args)...));
     }
     template <class... ArgsT>
+        requires owns_values
     inline void emplace_back(ArgsT&&... args)
     {
         push_back(make_shared_intrusive_ptr<value_type>(std::forward<ArgsT>(args)...));
     }
     template <class... ArgsT>
+        requires owns_values
     inline const_iterator emplace(const_iterator iter, ArgsT&&... args)
     {
         return insert(iter, make_shared_intrusive_ptr<value_type>(std::forward<ArgsT>(args)...));
@@ -126,6 +149,18 @@ public:
     void pop_front();
     void pop_back();
     iterator erase(iterator iter);
+    // Unlinks value, which must be in this list, through the hook selected by HookAccessorT.
+    inline void unlink(reference value)
+    {
+        unhook_(value);
+        --size_;
+    }
+    // Unlinks value, which must be in this list, and gives back the link the list held on it: no counter is touched.
+    inline value_link_type extract(reference value)
+    {
+        --size_;
+        return unhook_(value);
+    }
 
     void clear();
     void swap(sharable_intrusive_list& other);
@@ -138,136 +173,206 @@ public:
     template <class UnaryPredicate>
     size_type remove_if(UnaryPredicate predicate);
 
+    // Calls function on each element, in order, while a look-ahead cursor walks prefetch_distance hops ahead and
+    // prefetches the nodes it reaches: the cache misses of the look-ahead overlap with the work done by function on
+    // the current elements. function must not erase elements.
+    template <class FunctionT>
+    inline void for_each(FunctionT function, size_type prefetch_distance = default_prefetch_distance)
+    {
+        for_each_(begin(), end(), function, prefetch_distance);
+    }
+    template <class FunctionT>
+    inline void for_each(FunctionT function, size_type prefetch_distance = default_prefetch_distance) const
+    {
+        for_each_(begin(), end(), function, prefetch_distance);
+    }
+
+    inline size_type unique() { return unique(std::equal_to<>()); }
+    template <class BinaryPredicate>
+    size_type unique(BinaryPredicate predicate);
+
+    // The following operations relink the nodes in place: the ownership chain is moved, never copied,
+    // hence no counter is touched and nothing is allocated.
+    // If the comparison throws, sort and merge leave all the nodes (those of other included) in this list, in an
+    // unspecified order.
+
+    void reverse() noexcept;
+
+    inline void sort() { sort(std::less<>()); }
+    template <class Compare>
+    void sort(Compare comp);
+
+    inline void merge(sharable_intrusive_list& other) { merge(other, std::less<>()); }
+    inline void merge(sharable_intrusive_list&& other) { merge(other, std::less<>()); }
+    template <class Compare>
+    void merge(sharable_intrusive_list& other, Compare comp);
+    template <class Compare>
+    inline void merge(sharable_intrusive_list&& other, Compare comp)
+    {
+        merge(other, comp);
+    }
+
 private:
+    template <class IteratorT, class FunctionT>
+    static void for_each_(IteratorT iter, IteratorT end_iter, FunctionT& function, size_type prefetch_distance);
+
     void splice_(iterator iter, sharable_intrusive_list& other, iterator first, iterator last, std::size_t size);
 
-    static void hook_after_(value_type& list_value_ref, value_siptr_type&& value_siptr);
-    static void unhook_(value_type& list_value_ref);
+    value_link_type detach_chain_(value_link_type& sentinel_link) noexcept;
+    void attach_chain_(value_link_type&& head_link, value_link_type&& sentinel_link) noexcept;
+    // Merges the chain rhs_link into the chain lhs_link. If comp throws, lhs_link is left with all the nodes.
+    template <class Compare>
+    static void merge_chains_(value_link_type& lhs_link, value_link_type& rhs_link, Compare& comp);
+    static value_link_type& chain_end_(value_link_type& chain_link) noexcept;
+
+    void init_sentinel_();
+
+    inline static hook_type& hook_(value_type& value) noexcept { return HookAccessorT::hook(value); }
+    inline static const hook_type& hook_(const value_type& value) noexcept { return HookAccessorT::hook(value); }
+
+    static void hook_after_(value_type& list_value_ref, value_link_type&& value_link);
+    // Returns the link which held list_value_ref.
+    static value_link_type unhook_(value_type& list_value_ref);
 
 private:
     SentinelT sentinel_;
     size_type size_ = 0;
 };
 
-template <class IntrusiveT, typename SentinelT>
-sharable_intrusive_list<IntrusiveT, SentinelT>::sharable_intrusive_list()
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::sharable_intrusive_list()
 {
-    shared_intrusive_ptr_add_ref(&sentinel_);
-    sentinel_.previous() = &sentinel_;
-    sentinel_.next() = value_siptr_type(&sentinel_);
+    init_sentinel_();
 }
 
-template <class IntrusiveT, typename SentinelT>
-sharable_intrusive_list<IntrusiveT, SentinelT>::sharable_intrusive_list(SentinelT sentinel)
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::sharable_intrusive_list(SentinelT sentinel)
     : sentinel_(std::move(sentinel))
 {
-    shared_intrusive_ptr_add_ref(&sentinel_);
-    sentinel_.previous() = &sentinel_;
-    sentinel_.next() = value_siptr_type(&sentinel_);
+    init_sentinel_();
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::push_front(value_siptr_type value_siptr)
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::sharable_intrusive_list(sharable_intrusive_list&& other)
 {
-    hook_after_(sentinel_, std::move(value_siptr));
+    init_sentinel_();
+    splice(end(), other);
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::~sharable_intrusive_list()
+{
+    clear();
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::push_front(value_link_type value_link)
+{
+    hook_after_(sentinel_, std::move(value_link));
     ++size_;
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::push_back(value_siptr_type value_siptr)
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::push_back(value_link_type value_link)
 {
-    hook_after_(*sentinel_.previous(), std::move(value_siptr));
+    hook_after_(*hook_(sentinel_).previous(), std::move(value_link));
     ++size_;
 }
 
-template <class IntrusiveT, typename SentinelT>
-typename sharable_intrusive_list<IntrusiveT, SentinelT>::const_iterator
-sharable_intrusive_list<IntrusiveT, SentinelT>::insert(const_iterator iter, value_siptr_type value_siptr)
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+typename sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::const_iterator
+sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::insert(const_iterator iter, value_link_type value_link)
 {
-    const_iterator res_iter(*value_siptr);
-    hook_after_(*iter->previous(), std::move(value_siptr));
+    const_iterator res_iter(*link_traits_type::address(value_link));
+    hook_after_(*hook_(*iter).previous(), std::move(value_link));
     ++size_;
     return res_iter;
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::pop_front()
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::pop_front()
 {
-    unhook_(*sentinel_.next());
+    unhook_(*hook_(sentinel_).next_pointer());
     --size_;
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::pop_back()
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::pop_back()
 {
-    unhook_(*sentinel_.previous());
+    unhook_(*hook_(sentinel_).previous());
     --size_;
 }
 
-template <class IntrusiveT, typename SentinelT>
-typename sharable_intrusive_list<IntrusiveT, SentinelT>::iterator
-sharable_intrusive_list<IntrusiveT, SentinelT>::erase(iterator iter)
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+typename sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::iterator
+sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::erase(iterator iter)
 {
-    iterator res_iter(*iter->next());
+    iterator res_iter(*hook_(*iter).next_pointer());
     unhook_(*iter);
     --size_;
     return res_iter;
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::clear()
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::clear()
 {
-    value_siptr_type& sentinel_next = sentinel_.next();
-    for (value_type* first_value = sentinel_next.get(); first_value != &sentinel_; first_value = sentinel_next.get())
+    value_link_type& sentinel_next = hook_(sentinel_).next();
+    for (value_type* first_value = link_traits_type::address(sentinel_next); first_value != &sentinel_;
+         first_value = link_traits_type::address(sentinel_next))
     {
-        first_value->previous() = nullptr;
-        sentinel_next = std::move(first_value->next());
+        hook_(*first_value).previous() = nullptr;
+        sentinel_next = std::exchange(hook_(*first_value).next(), nullptr);
     }
-    sentinel_.previous() = &sentinel_;
+    hook_(sentinel_).previous() = &sentinel_;
     size_ = 0;
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::swap(sharable_intrusive_list& other)
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::swap(sharable_intrusive_list& other)
 {
-    sentinel_.next().swap(other.sentinel_.next());
-    std::swap(sentinel_.previous(), other.sentinel_.previous());
-    std::swap(size_, other.size_);
+    iterator other_first = other.empty() ? end() : other.begin();
+    size_type size = size_;
+    splice_(end(), other, other.begin(), other.end(), other.size_);
+    other.splice_(other.end(), *this, begin(), other_first, size);
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::splice(iterator iter, sharable_intrusive_list& other)
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::splice(iterator iter,
+                                                                       sharable_intrusive_list& other)
 {
     splice_(iter, other, other.begin(), other.end(), other.size());
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::splice(iterator iter, sharable_intrusive_list&& other)
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::splice(iterator iter,
+                                                                       sharable_intrusive_list&& other)
 {
     splice_(iter, other, other.begin(), other.end(), other.size());
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::splice(iterator iter, sharable_intrusive_list& other, iterator it)
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::splice(iterator iter,
+                                                                       sharable_intrusive_list& other, iterator it)
 {
-    value_siptr_type aux_siptr = it.make_intrusive_shared();
+    value_link_type aux_link = link_traits_type::make_link(it.ptr());
     unhook_(*it);
-    hook_after_(*iter->previous(), std::move(aux_siptr));
+    hook_after_(*hook_(*iter).previous(), std::move(aux_link));
     ++size_;
     --other.size_;
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::splice(iterator iter, sharable_intrusive_list& other,
-                                                            iterator first, iterator last)
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::splice(iterator iter,
+                                                                       sharable_intrusive_list& other,
+                                                                       iterator first, iterator last)
 {
     splice_(iter, other, first, last, std::distance(first, last));
 }
 
-template <class IntrusiveT, typename SentinelT>
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
 template <class UnaryPredicate>
-typename sharable_intrusive_list<IntrusiveT, SentinelT>::size_type
-sharable_intrusive_list<IntrusiveT, SentinelT>::remove_if(UnaryPredicate predicate)
+typename sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::size_type
+sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::remove_if(UnaryPredicate predicate)
 {
     size_type count = 0;
     for (auto iter = begin(), end_iter = end(); iter != end_iter;)
@@ -283,41 +388,255 @@ sharable_intrusive_list<IntrusiveT, SentinelT>::remove_if(UnaryPredicate predica
     return count;
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::splice_(iterator iter, sharable_intrusive_list& other,
-                                                             iterator first, iterator last, std::size_t size)
-{
-    pointer iter_previous = iter->previous();
-    pointer first_previous = first->previous();
-    pointer last_previous = last->previous();
-    iter->previous() = last_previous;
-    last->previous() = first_previous;
-    first->previous() = last_previous;
-    value_siptr_type iter_siptr = std::move(iter_previous->next());
-    iter_previous->next() = std::move(first_previous->next());
-    first_previous->next() = std::move(last_previous->next());
-    last_previous->next() = std::move(iter_siptr);
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+template <class IteratorT, class FunctionT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::for_each_(IteratorT iter, IteratorT end_iter,
+                                                                          FunctionT& function,
+                                                                          size_type prefetch_distance)
+{
+    IteratorT ahead_iter = iter;
+    for (size_type i = 0; i < prefetch_distance && ahead_iter != end_iter; ++i)
+        prefetch((++ahead_iter).ptr());
+    for (; ahead_iter != end_iter; ++iter)
+    {
+        prefetch((++ahead_iter).ptr());
+        function(*iter);
+    }
+    for (; iter != end_iter; ++iter)
+        function(*iter);
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+template <class BinaryPredicate>
+typename sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::size_type
+sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::unique(BinaryPredicate predicate)
+{
+    size_type count = 0;
+    if (empty())
+        return count;
+    for (auto previous_iter = begin(), iter = std::next(previous_iter), end_iter = end(); iter != end_iter;)
+    {
+        if (predicate(*previous_iter, *iter))
+        {
+            iter = erase(iter);
+            ++count;
+        }
+        else
+            previous_iter = iter++;
+    }
+    return count;
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::reverse() noexcept
+{
+    value_link_type sentinel_link = nullptr;
+    value_link_type head_link = detach_chain_(sentinel_link);
+    value_link_type reversed_link = nullptr;
+    while (head_link)
+    {
+        hook_type& head_hook = hook_(*link_traits_type::address(head_link));
+        value_link_type next_link = std::exchange(head_hook.next(), nullptr);
+        head_hook.next() = std::move(reversed_link);
+        reversed_link = std::move(head_link);
+        head_link = std::move(next_link);
+    }
+    attach_chain_(std::move(reversed_link), std::move(sentinel_link));
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+template <class Compare>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::sort(Compare comp)
+{
+    // Bottom-up merge sort: runs[i] is either empty or a sorted chain of 2^i nodes.
+    value_link_type sentinel_link = nullptr;
+    value_link_type head_link = detach_chain_(sentinel_link);
+    std::array<value_link_type, std::numeric_limits<size_type>::digits> runs{};
+    std::size_t run_count = 0;
+    value_link_type carry_link = nullptr;
+    value_link_type sorted_link = nullptr;
+    try
+    {
+        while (head_link)
+        {
+            carry_link = std::exchange(head_link, nullptr);
+            head_link = std::exchange(hook_(*link_traits_type::address(carry_link)).next(), nullptr);
+            std::size_t level = 0;
+            for (; level < run_count && runs[level]; ++level)
+            {
+                merge_chains_(runs[level], carry_link, comp);
+                carry_link = std::exchange(runs[level], nullptr);
+            }
+            runs[level] = std::exchange(carry_link, nullptr);
+            if (level == run_count)
+                ++run_count;
+        }
+        for (std::size_t level = 0; level < run_count; ++level)
+        {
+            if (runs[level])
+            {
+                merge_chains_(runs[level], sorted_link, comp);
+                sorted_link = std::exchange(runs[level], nullptr);
+            }
+        }
+    }
+    catch (...)
+    {
+        // Gives all the chains back to the list.
+        for (std::size_t level = 0; level < run_count; ++level)
+            chain_end_(sorted_link) = std::exchange(runs[level], nullptr);
+        chain_end_(sorted_link) = std::exchange(carry_link, nullptr);
+        chain_end_(sorted_link) = std::exchange(head_link, nullptr);
+        attach_chain_(std::move(sorted_link), std::move(sentinel_link));
+        throw;
+    }
+    attach_chain_(std::move(sorted_link), std::move(sentinel_link));
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+template <class Compare>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::merge(sharable_intrusive_list& other, Compare comp)
+{
+    if (&other == this || other.empty())
+        return;
+    value_link_type sentinel_link = nullptr;
+    value_link_type head_link = detach_chain_(sentinel_link);
+    value_link_type other_sentinel_link = nullptr;
+    value_link_type other_head_link = other.detach_chain_(other_sentinel_link);
+    other.attach_chain_(nullptr, std::move(other_sentinel_link));
+    size_ += std::exchange(other.size_, 0);
+    try
+    {
+        merge_chains_(head_link, other_head_link, comp);
+    }
+    catch (...)
+    {
+        attach_chain_(std::move(head_link), std::move(sentinel_link));
+        throw;
+    }
+    attach_chain_(std::move(head_link), std::move(sentinel_link));
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::splice_(iterator iter,
+                                                                        sharable_intrusive_list& other,
+                                                                        iterator first, iterator last,
+                                                                        std::size_t size)
+{
+    if (first == last)
+        return;
+    pointer iter_previous = hook_(*iter).previous();
+    pointer first_previous = hook_(*first).previous();
+    pointer last_previous = hook_(*last).previous();
+    hook_(*iter).previous() = last_previous;
+    hook_(*last).previous() = first_previous;
+    hook_(*first).previous() = iter_previous;
+    value_link_type iter_link = std::exchange(hook_(*iter_previous).next(), nullptr);
+    hook_(*iter_previous).next() = std::exchange(hook_(*first_previous).next(), nullptr);
+    hook_(*first_previous).next() = std::exchange(hook_(*last_previous).next(), nullptr);
+    hook_(*last_previous).next() = std::move(iter_link);
     size_ += size;
     other.size_ -= size;
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::hook_after_(value_type& list_value_ref,
-                                                                 value_siptr_type&& value_siptr)
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+typename sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::value_link_type
+sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::detach_chain_(value_link_type& sentinel_link) noexcept
+{
+    sentinel_link = std::exchange(hook_(*hook_(sentinel_).previous()).next(), nullptr);
+    hook_(sentinel_).previous() = &sentinel_;
+    return std::exchange(hook_(sentinel_).next(), nullptr);
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::attach_chain_(value_link_type&& head_link,
+                                                                              value_link_type&& sentinel_link) noexcept
+{
+    pointer previous = &sentinel_;
+    if (head_link)
+    {
+        hook_(sentinel_).next() = std::move(head_link);
+        for (pointer node = hook_(sentinel_).next_pointer(); node; node = hook_(*node).next_pointer())
+        {
+            hook_(*node).previous() = previous;
+            previous = node;
+        }
+    }
+    hook_(*previous).next() = std::move(sentinel_link);
+    hook_(sentinel_).previous() = previous;
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+template <class Compare>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::merge_chains_(value_link_type& lhs_link,
+                                                                              value_link_type& rhs_link,
+                                                                              Compare& comp)
+{
+    value_link_type head_link = nullptr;
+    value_link_type* tail_link = &head_link;
+    try
+    {
+        while (lhs_link && rhs_link)
+        {
+            value_link_type& taken_link =
+                comp(*link_traits_type::address(rhs_link), *link_traits_type::address(lhs_link)) ? rhs_link : lhs_link;
+            *tail_link = std::exchange(taken_link, nullptr);
+            tail_link = &hook_(*link_traits_type::address(*tail_link)).next();
+            taken_link = std::exchange(*tail_link, nullptr);
+        }
+    }
+    catch (...)
+    {
+        // Raw links are copied by std::move: every handoff must clear its source to keep the chain acyclic.
+        *tail_link = std::exchange(lhs_link, nullptr);
+        chain_end_(*tail_link) = std::exchange(rhs_link, nullptr);
+        lhs_link = std::exchange(head_link, nullptr);
+        throw;
+    }
+    *tail_link = lhs_link ? std::exchange(lhs_link, nullptr) : std::exchange(rhs_link, nullptr);
+    lhs_link = std::exchange(head_link, nullptr);
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+typename sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::value_link_type&
+sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::chain_end_(value_link_type& chain_link) noexcept
+{
+    value_link_type* end_link = &chain_link;
+    while (*end_link)
+        end_link = &hook_(*link_traits_type::address(*end_link)).next();
+    return *end_link;
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::hook_after_(value_type& list_value_ref,
+                                                                            value_link_type&& value_link)
+{
+    value_type* value_ptr = link_traits_type::address(value_link);
+    hook_(*value_ptr).previous() = &list_value_ref;
+    hook_(*hook_(list_value_ref).next_pointer()).previous() = value_ptr;
+    hook_(*value_ptr).next() = std::exchange(hook_(list_value_ref).next(), nullptr);
+    hook_(list_value_ref).next() = std::move(value_link);
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::init_sentinel_()
 {
-    value_siptr->previous() = &list_value_ref;
-    list_value_ref.next()->previous() = value_siptr.get();
-    value_siptr->next() = std::move(list_value_ref.next());
-    list_value_ref.next() = std::move(value_siptr);
+    if constexpr (owns_values)
+        shared_intrusive_ptr_add_ref(&sentinel_);
+    hook_(sentinel_).previous() = &sentinel_;
+    hook_(sentinel_).next() = link_traits_type::make_link(&sentinel_);
 }
 
-template <class IntrusiveT, typename SentinelT>
-void sharable_intrusive_list<IntrusiveT, SentinelT>::unhook_(value_type& vref)
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+typename sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::value_link_type
+sharable_intrusive_list<IntrusiveT, SentinelT, HookAccessorT>::unhook_(value_type& vref)
 {
-    IntrusiveT* previous = vref.previous();
-    vref.next()->previous() = previous;
-    vref.previous() = nullptr;
-    previous->next() = std::move(vref.next());
+    IntrusiveT* previous = hook_(vref).previous();
+    hook_(*hook_(vref).next_pointer()).previous() = previous;
+    hook_(vref).previous() = nullptr;
+    value_link_type value_link = std::exchange(hook_(*previous).next(), nullptr);
+    hook_(*previous).next() = std::exchange(hook_(vref).next(), nullptr);
+    return value_link;
 }
 
 } // namespace itru
@@ -1,31 +1,80 @@
 #pragma once
 
+#include "policy/link_policy.hpp"
 #include "shared_intrusive_ptr.hpp"
 
+#include <type_traits>
+#include <utility>
+
 inline namespace arba
 {
 namespace itru
 {
 
-template <typename IntrusiveListNodeT>
+struct default_hook_tag
+{
+};
+
+// A node deriving from several hooks with different tags can be linked in as many lists at the same time.
+template <typename IntrusiveListNodeT, LinkPolicy lk_policy = shared_link_t, typename TagT = default_hook_tag>
 class sharable_intrusive_list_hook
 {
 public:
+    using link_policy_type = lk_policy;
+    using link_traits_type = link_traits<IntrusiveListNodeT, lk_policy>;
+    using link_type = typename link_traits_type::link_type;
+    using tag_type = TagT;
+
     inline IntrusiveListNodeT* previous() const noexcept { return previous_; }
     inline IntrusiveListNodeT*& previous() noexcept { return previous_; }
-    inline const shared_intrusive_ptr<IntrusiveListNodeT>& next() const noexcept { return next_; }
-    inline shared_intrusive_ptr<IntrusiveListNodeT>& next() noexcept { return next_; }
+    inline const link_type& next() const noexcept { return next_; }
+    inline link_type& next() noexcept { return next_; }
+    inline IntrusiveListNodeT* next_pointer() const noexcept { return link_traits_type::address(next_); }
+    // Only for a base hook: a node linked through a member hook is unlinked by its list (see
+    // sharable_intrusive_list::unlink()).
     void unhook()
+        requires std::is_base_of_v<sharable_intrusive_list_hook, IntrusiveListNodeT>
     {
-        next_->previous() = previous_;
-        IntrusiveListNodeT* previous = previous_;
-        previous_ = nullptr;
-        previous->next_ = std::move(std::move(next_));
+        hook_of_(link_traits_type::address(next_)).previous_ = previous_;
+        IntrusiveListNodeT* previous = std::exchange(previous_, nullptr);
+        hook_of_(previous).next_ = std::exchange(next_, nullptr);
     }
 
 private:
+    inline static sharable_intrusive_list_hook& hook_of_(IntrusiveListNodeT* node) noexcept
+    {
+        return static_cast<sharable_intrusive_list_hook&>(*node);
+    }
+
     IntrusiveListNodeT* previous_ = nullptr;
-    shared_intrusive_ptr<IntrusiveListNodeT> next_;
+    link_type next_ = nullptr;
+};
+
+template <typename TagT, typename IntrusiveListNodeT, LinkPolicy lk_policy>
+sharable_intrusive_list_hook<IntrusiveListNodeT, lk_policy, TagT>*
+list_hook_base(const sharable_intrusive_list_hook<IntrusiveListNodeT, lk_policy, TagT>*);
+
+template <typename IntrusiveT, typename TagT = default_hook_tag>
+using list_hook_t = std::remove_pointer_t<decltype(list_hook_base<TagT>(std::declval<IntrusiveT*>()))>;
+
+// Hook accessors tell sharable_intrusive_list which hook of its nodes it is threaded through.
+
+template <typename IntrusiveT, typename TagT = default_hook_tag>
+struct base_list_hook_accessor
+{
+    using hook_type = list_hook_t<IntrusiveT, TagT>;
+
+    inline static hook_type& hook(IntrusiveT& value) noexcept { return value; }
+    inline static const hook_type& hook(const IntrusiveT& value) noexcept { return value; }
+};
+
+template <typename IntrusiveT, typename HookT, HookT IntrusiveT::*hook_member>
+struct member_list_hook_accessor
+{
+    using hook_type = HookT;
+
+    inline static hook_type& hook(IntrusiveT& value) noexcept { return value.*hook_member; }
+    inline static const hook_type& hook(const IntrusiveT& value) noexcept { return value.*hook_member; }
 };
 
 } // namespace itru
@@ -0,0 +1,357 @@
+#pragma once
+
+#include "policy/link_policy.hpp"
+#include "sharable_intrusive_heap_hook.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Pairing heap threaded through the sharable_intrusive_heap_hook embedded in IntrusiveT. As for
+// std::priority_queue, top() is the greatest element according to CompareT.
+// push, promote and merge are O(1); pop, erase and update are amortised O(log n). Only the element is needed to
+// erase it or to update its position: no lookup is done.
+// If a comparison throws, the heap is left as it was before the call.
+template <typename IntrusiveT, typename CompareT = std::less<IntrusiveT>>
+class sharable_intrusive_pairing_heap
+{
+public:
+    using value_type = IntrusiveT;
+    using size_type = std::size_t;
+    using value_compare = CompareT;
+    using reference = std::add_lvalue_reference_t<value_type>;
+    using const_reference = std::add_lvalue_reference_t<std::add_const_t<value_type>>;
+    using pointer = std::add_pointer_t<value_type>;
+    using const_pointer = std::add_pointer_t<std::add_const_t<value_type>>;
+    using value_siptr_type = shared_intrusive_ptr<value_type>;
+    using hook_type = heap_hook_t<IntrusiveT>;
+    using link_policy_type = typename hook_type::link_policy_type;
+    using link_traits_type = link_traits<value_type, link_policy_type>;
+    using value_link_type = typename link_traits_type::link_type;
+
+    static constexpr bool owns_values = std::is_same_v<link_policy_type, shared_link_t>;
+
+public:
+    sharable_intrusive_pairing_heap() = default;
+    explicit sharable_intrusive_pairing_heap(const CompareT& comp);
+    sharable_intrusive_pairing_heap(sharable_intrusive_pairing_heap&& other) noexcept;
+    sharable_intrusive_pairing_heap& operator=(sharable_intrusive_pairing_heap&& other) noexcept;
+    ~sharable_intrusive_pairing_heap();
+
+    inline bool empty() const noexcept { return size_ == 0; }
+    inline size_type size() const noexcept { return size_; }
+    inline value_compare value_comp() const { return comp_; }
+
+    inline const_reference top() const noexcept { return *link_traits_type::address(root_); }
+    inline reference top() noexcept { return *link_traits_type::address(root_); }
+
+    void push(value_link_type value_link);
+
+    template <class... ArgsT>
+        requires owns_values
+    inline void emplace(ArgsT&&... args)
+    {
+        push(make_shared_intrusive_ptr<value_type>(std::forward<ArgsT>(args)...));
+    }
+
+    inline void pop() { extract_top(); }
+    value_link_type extract_top();
+
+    // The element must be in this heap.
+    inline void erase(reference value) { extract(value); }
+    value_link_type extract(reference value);
+    // To call once the element compares greater than before (decrease-key of a min-heap).
+    void promote(reference value);
+    // To call once the element has changed in any way.
+    void update(reference value);
+
+    void merge(sharable_intrusive_pairing_heap& other);
+    inline void merge(sharable_intrusive_pairing_heap&& other) { merge(other); }
+
+    void clear() noexcept;
+    void swap(sharable_intrusive_pairing_heap& other) noexcept;
+
+private:
+    inline static hook_type& hook_(value_type& value) noexcept { return value; }
+    inline static pointer address_(const value_link_type& link) noexcept { return link_traits_type::address(link); }
+
+    // Compares before modifying anything: if the comparison throws, both links are left untouched. Otherwise, both
+    // are cleared, even raw ones.
+    value_link_type meld_(value_link_type&& lhs_link, value_link_type&& rhs_link);
+    static value_link_type link_child_(value_link_type&& parent_link, value_link_type&& child_link) noexcept;
+    // Melds the children of parent into one tree. If a comparison throws, they are given back to parent.
+    value_link_type merge_pairs_(value_type& parent);
+    static void append_siblings_(value_link_type& chain_link, value_link_type&& siblings_link) noexcept;
+    // Puts tree_link in the place of value, and returns the link to value.
+    static value_link_type replace_(value_type& value, value_link_type&& tree_link) noexcept;
+    inline static value_link_type detach_(value_type& value) noexcept { return replace_(value, nullptr); }
+
+private:
+    value_link_type root_ = nullptr;
+    size_type size_ = 0;
+    [[no_unique_address]] CompareT comp_;
+};
+
+template <class IntrusiveT, class CompareT>
+sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::sharable_intrusive_pairing_heap(const CompareT& comp)
+    : comp_(comp)
+{
+}
+
+template <class IntrusiveT, class CompareT>
+sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::sharable_intrusive_pairing_heap(
+    sharable_intrusive_pairing_heap&& other) noexcept
+    : root_(std::exchange(other.root_, nullptr)), size_(std::exchange(other.size_, 0)), comp_(std::move(other.comp_))
+{
+}
+
+template <class IntrusiveT, class CompareT>
+sharable_intrusive_pairing_heap<IntrusiveT, CompareT>&
+sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::operator=(sharable_intrusive_pairing_heap&& other) noexcept
+{
+    sharable_intrusive_pairing_heap aux(std::move(other));
+    swap(aux);
+    return *this;
+}
+
+template <class IntrusiveT, class CompareT>
+sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::~sharable_intrusive_pairing_heap()
+{
+    clear();
+}
+
+template <class IntrusiveT, class CompareT>
+void sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::push(value_link_type value_link)
+{
+    root_ = meld_(std::move(root_), std::move(value_link));
+    ++size_;
+}
+
+template <class IntrusiveT, class CompareT>
+typename sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::value_link_type
+sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::extract_top()
+{
+    value_link_type children_link = merge_pairs_(*address_(root_));
+    value_link_type top_link = std::exchange(root_, std::exchange(children_link, nullptr));
+    --size_;
+    return top_link;
+}
+
+template <class IntrusiveT, class CompareT>
+typename sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::value_link_type
+sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::extract(reference value)
+{
+    if (&value == address_(root_))
+        return extract_top();
+    // The children of value are not greater than value, hence than its parent: they can take its place.
+    value_link_type children_link = merge_pairs_(value);
+    value_link_type value_link = replace_(value, std::exchange(children_link, nullptr));
+    --size_;
+    return value_link;
+}
+
+template <class IntrusiveT, class CompareT>
+void sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::promote(reference value)
+{
+    if (&value == address_(root_))
+        return;
+    const bool value_wins = comp_(*address_(root_), value);
+    value_link_type value_link = detach_(value);
+    root_ = value_wins ? link_child_(std::move(value_link), std::exchange(root_, nullptr))
+                       : link_child_(std::exchange(root_, nullptr), std::move(value_link));
+}
+
+template <class IntrusiveT, class CompareT>
+void sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::update(reference value)
+{
+    value_link_type children_link = merge_pairs_(value);
+    const bool is_top = &value == address_(root_);
+    bool value_wins = true;
+    try
+    {
+        if (pointer rival = is_top ? address_(children_link) : address_(root_))
+            value_wins = comp_(*rival, value);
+    }
+    catch (...)
+    {
+        if (children_link)
+            hook_(*address_(children_link)).previous() = &value;
+        hook_(value).first_child() = std::exchange(children_link, nullptr);
+        throw;
+    }
+    value_link_type value_link = is_top ? std::exchange(root_, std::exchange(children_link, nullptr))
+                                        : replace_(value, std::exchange(children_link, nullptr));
+    if (!root_)
+        root_ = std::move(value_link);
+    else
+        root_ = value_wins ? link_child_(std::move(value_link), std::exchange(root_, nullptr))
+                           : link_child_(std::exchange(root_, nullptr), std::move(value_link));
+}
+
+template <class IntrusiveT, class CompareT>
+void sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::merge(sharable_intrusive_pairing_heap& other)
+{
+    if (&other == this)
+        return;
+    root_ = meld_(std::move(root_), std::move(other.root_));
+    size_ += std::exchange(other.size_, 0);
+}
+
+// The heap is unfolded while it is destroyed: the first child of the root becomes the new root, followed by the old
+// root in the sibling chain. No recursion, whatever the shape of the heap.
+template <class IntrusiveT, class CompareT>
+void sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::clear() noexcept
+{
+    while (pointer node = address_(root_))
+    {
+        if (pointer child = hook_(*node).first_child_pointer())
+        {
+            value_link_type child_link = std::exchange(hook_(*node).first_child(), nullptr);
+            hook_(*node).first_child() = std::exchange(hook_(*child).next_sibling(), nullptr);
+            hook_(*child).next_sibling() = std::exchange(root_, nullptr);
+            root_ = std::move(child_link);
+        }
+        else
+        {
+            value_link_type next_link = std::exchange(hook_(*node).next_sibling(), nullptr);
+            hook_(*node).previous() = nullptr;
+            root_ = std::move(next_link);
+        }
+    }
+    size_ = 0;
+}
+
+template <class IntrusiveT, class CompareT>
+void sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::swap(sharable_intrusive_pairing_heap& other) noexcept
+{
+    using std::swap;
+    swap(root_, other.root_);
+    swap(size_, other.size_);
+    swap(comp_, other.comp_);
+}
+
+template <class IntrusiveT, class CompareT>
+typename sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::value_link_type
+sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::meld_(value_link_type&& lhs_link, value_link_type&& rhs_link)
+{
+    if (!lhs_link)
+        return std::exchange(rhs_link, nullptr);
+    if (!rhs_link)
+        return std::exchange(lhs_link, nullptr);
+    if (comp_(*address_(lhs_link), *address_(rhs_link)))
+        return link_child_(std::move(rhs_link), std::move(lhs_link));
+    return link_child_(std::move(lhs_link), std::move(rhs_link));
+}
+
+template <class IntrusiveT, class CompareT>
+typename sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::value_link_type
+sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::link_child_(value_link_type&& parent_link,
+                                                                  value_link_type&& child_link) noexcept
+{
+    hook_type& parent_hook = hook_(*address_(parent_link));
+    hook_type& child_hook = hook_(*address_(child_link));
+    child_hook.next_sibling() = std::exchange(parent_hook.first_child(), nullptr);
+    if (pointer next = child_hook.next_sibling_pointer())
+        hook_(*next).previous() = address_(child_link);
+    child_hook.previous() = address_(parent_link);
+    parent_hook.first_child() = std::exchange(child_link, nullptr);
+    parent_hook.previous() = nullptr;
+    return std::exchange(parent_link, nullptr);
+}
+
+// Two-pass pairing: siblings are melded by pairs from left to right, then the pairs are melded from right to left.
+template <class IntrusiveT, class CompareT>
+typename sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::value_link_type
+sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::merge_pairs_(value_type& parent)
+{
+    value_link_type first_link = std::exchange(hook_(parent).first_child(), nullptr);
+    value_link_type lhs_link = nullptr;
+    value_link_type rhs_link = nullptr;
+    value_link_type pairs_link = nullptr;
+    value_link_type result_link = nullptr;
+    try
+    {
+        while (first_link)
+        {
+            lhs_link = std::exchange(first_link, nullptr);
+            rhs_link = std::exchange(hook_(*address_(lhs_link)).next_sibling(), nullptr);
+            if (rhs_link)
+                first_link = std::exchange(hook_(*address_(rhs_link)).next_sibling(), nullptr);
+            value_link_type pair_link = meld_(std::move(lhs_link), std::move(rhs_link));
+            hook_(*address_(pair_link)).next_sibling() = std::exchange(pairs_link, nullptr);
+            pairs_link = std::exchange(pair_link, nullptr);
+        }
+        while (pairs_link)
+        {
+            lhs_link = std::exchange(pairs_link, nullptr);
+            pairs_link = std::exchange(hook_(*address_(lhs_link)).next_sibling(), nullptr);
+            result_link = meld_(std::move(result_link), std::move(lhs_link));
+        }
+    }
+    catch (...)
+    {
+        // Every pending tree is still heap-ordered below parent: they become its children again.
+        append_siblings_(result_link, std::exchange(pairs_link, nullptr));
+        append_siblings_(result_link, std::exchange(lhs_link, nullptr));
+        append_siblings_(result_link, std::exchange(rhs_link, nullptr));
+        append_siblings_(result_link, std::exchange(first_link, nullptr));
+        pointer previous = &parent;
+        for (pointer node = address_(result_link); node; node = hook_(*node).next_sibling_pointer())
+        {
+            hook_(*node).previous() = previous;
+            previous = node;
+        }
+        hook_(parent).first_child() = std::exchange(result_link, nullptr);
+        throw;
+    }
+    if (result_link)
+        hook_(*address_(result_link)).previous() = nullptr;
+    return result_link;
+}
+
+template <class IntrusiveT, class CompareT>
+void sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::append_siblings_(value_link_type& chain_link,
+                                                                            value_link_type&& siblings_link) noexcept
+{
+    value_link_type* end_link = &chain_link;
+    while (*end_link)
+        end_link = &hook_(*address_(*end_link)).next_sibling();
+    *end_link = std::exchange(siblings_link, nullptr);
+}
+
+template <class IntrusiveT, class CompareT>
+typename sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::value_link_type
+sharable_intrusive_pairing_heap<IntrusiveT, CompareT>::replace_(value_type& value, value_link_type&& tree_link) noexcept
+{
+    hook_type& value_hook = hook_(value);
+    hook_type& previous_hook = hook_(*value_hook.previous());
+    value_link_type& link =
+        previous_hook.first_child_pointer() == &value ? previous_hook.first_child() : previous_hook.next_sibling();
+    value_link_type value_link = std::exchange(link, nullptr);
+    value_link_type next_link = std::exchange(value_hook.next_sibling(), nullptr);
+    if (pointer tree = address_(tree_link))
+    {
+        hook_(*tree).previous() = value_hook.previous();
+        hook_(*tree).next_sibling() = std::exchange(next_link, nullptr);
+        link = std::exchange(tree_link, nullptr);
+        if (pointer next = hook_(*tree).next_sibling_pointer())
+            hook_(*next).previous() = tree;
+    }
+    else
+    {
+        link = std::exchange(next_link, nullptr);
+        if (pointer next = address_(link))
+            hook_(*next).previous() = value_hook.previous();
+    }
+    value_hook.previous() = nullptr;
+    return value_link;
+}
+
+} // namespace itru
+} // namespace arba
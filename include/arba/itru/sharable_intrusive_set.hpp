@@ -0,0 +1,711 @@
+#pragma once
+
+#include "key_of.hpp"
+#include "policy/link_policy.hpp"
+#include "sharable_intrusive_set_hook.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Red-black tree threaded through the sharable_intrusive_set_hook embedded in IntrusiveT: a node owns its left and
+// right children (under the shared link policy) and knows its parent, hence rotations only move links around and
+// an element can be unlinked without any lookup.
+template <typename IntrusiveT, typename KeyOfT, typename CompareT = std::less<key_of_result_t<IntrusiveT, KeyOfT>>,
+          LinkPolicy lk_policy = set_hook_link_policy_t<IntrusiveT>>
+class sharable_intrusive_set
+{
+public:
+    using key_type = key_of_result_t<IntrusiveT, KeyOfT>;
+    using value_type = IntrusiveT;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = CompareT;
+    using reference = std::add_lvalue_reference_t<value_type>;
+    using const_reference = std::add_lvalue_reference_t<std::add_const_t<value_type>>;
+    using pointer = std::add_pointer_t<value_type>;
+    using const_pointer = std::add_pointer_t<std::add_const_t<value_type>>;
+    using value_siptr_type = shared_intrusive_ptr<value_type>;
+    using link_policy_type = lk_policy;
+    using link_traits_type = link_traits<value_type, lk_policy>;
+    using value_link_type = typename link_traits_type::link_type;
+
+    static constexpr bool owns_values = std::is_same_v<lk_policy, shared_link_t>;
+
+private:
+    template <typename ValueT>
+    class iterator_
+    {
+    public:
+        using value_type = ValueT;
+        using pointer = std::add_pointer_t<ValueT>;
+        using reference = std::add_lvalue_reference_t<ValueT>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        iterator_() = default;
+
+        inline iterator_(const iterator_<std::remove_const_t<ValueT>>& iter) : set_(iter.set_), pointer_(iter.pointer_)
+        {
+        }
+
+        inline iterator_& operator=(const iterator_& iter) = default;
+
+        iterator_& operator++() noexcept
+        {
+            pointer_ = next_node_(const_cast<std::remove_const_t<ValueT>*>(pointer_));
+            return *this;
+        }
+        iterator_ operator++(int) noexcept
+        {
+            iterator_ iter(*this);
+            ++(*this);
+            return iter;
+        }
+        iterator_& operator--() noexcept
+        {
+            pointer_ = pointer_ ? previous_node_(const_cast<std::remove_const_t<ValueT>*>(pointer_))
+                               : max_node_(set_->root_pointer_());
+            return *this;
+        }
+        iterator_ operator--(int) noexcept
+        {
+            iterator_ iter(*this);
+            --(*this);
+            return iter;
+        }
+
+        reference operator*() const noexcept { return *pointer_; }
+        pointer operator->() const noexcept { return pointer_; }
+
+        inline pointer ptr() const noexcept { return pointer_; }
+
+        inline bool operator==(const iterator_& other) const noexcept { return pointer_ == other.pointer_; }
+
+    private:
+        iterator_(const sharable_intrusive_set* set, pointer ptr) noexcept : set_(set), pointer_(ptr) {}
+
+        const sharable_intrusive_set* set_ = nullptr;
+        pointer pointer_ = nullptr;
+
+        friend class sharable_intrusive_set;
+        template <typename OtherValueT>
+        friend class iterator_;
+    };
+
+public:
+    using iterator = iterator_<value_type>;
+    using const_iterator = iterator_<const value_type>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    template <class KeyT>
+    static constexpr bool transparent_key_v = requires { typename CompareT::is_transparent; }
+                                              && !std::is_convertible_v<const KeyT&, const_iterator>
+                                              && !std::is_convertible_v<const KeyT&, iterator>;
+
+public:
+    sharable_intrusive_set() = default;
+    explicit sharable_intrusive_set(const CompareT& comp, const KeyOfT& key_of = KeyOfT());
+    sharable_intrusive_set(sharable_intrusive_set&& other) noexcept;
+    sharable_intrusive_set& operator=(sharable_intrusive_set&& other) noexcept;
+    ~sharable_intrusive_set();
+
+    inline const_iterator begin() const noexcept { return const_iterator(this, leftmost_); }
+    inline iterator begin() noexcept { return iterator(this, leftmost_); }
+    inline const_iterator cbegin() const noexcept { return begin(); }
+
+    inline const_iterator end() const noexcept { return const_iterator(this, nullptr); }
+    inline iterator end() noexcept { return iterator(this, nullptr); }
+    inline const_iterator cend() const noexcept { return end(); }
+
+    inline const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    inline reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    inline const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    inline reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    inline bool empty() const noexcept { return size_ == 0; }
+    inline size_type size() const noexcept { return size_; }
+    inline key_compare key_comp() const { return comp_; }
+
+    std::pair<iterator, bool> insert(value_link_type value_link);
+
+    template <class... ArgsT>
+        requires owns_values
+    inline std::pair<iterator, bool> emplace(ArgsT&&... args)
+    {
+        return insert(make_shared_intrusive_ptr<value_type>(std::forward<ArgsT>(args)...));
+    }
+
+    inline iterator find(const key_type& key) { return iterator(this, find_node_(key)); }
+    inline const_iterator find(const key_type& key) const { return const_iterator(this, find_node_(key)); }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline iterator find(const KeyT& key)
+    {
+        return iterator(this, find_node_(key));
+    }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline const_iterator find(const KeyT& key) const
+    {
+        return const_iterator(this, find_node_(key));
+    }
+
+    inline bool contains(const key_type& key) const { return find_node_(key) != nullptr; }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline bool contains(const KeyT& key) const
+    {
+        return find_node_(key) != nullptr;
+    }
+
+    inline size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline size_type count(const KeyT& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    inline iterator lower_bound(const key_type& key) { return iterator(this, lower_bound_node_(key)); }
+    inline const_iterator lower_bound(const key_type& key) const
+    {
+        return const_iterator(this, lower_bound_node_(key));
+    }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline iterator lower_bound(const KeyT& key)
+    {
+        return iterator(this, lower_bound_node_(key));
+    }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline const_iterator lower_bound(const KeyT& key) const
+    {
+        return const_iterator(this, lower_bound_node_(key));
+    }
+
+    inline iterator upper_bound(const key_type& key) { return iterator(this, upper_bound_node_(key)); }
+    inline const_iterator upper_bound(const key_type& key) const
+    {
+        return const_iterator(this, upper_bound_node_(key));
+    }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline iterator upper_bound(const KeyT& key)
+    {
+        return iterator(this, upper_bound_node_(key));
+    }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline const_iterator upper_bound(const KeyT& key) const
+    {
+        return const_iterator(this, upper_bound_node_(key));
+    }
+
+    inline iterator iterator_to(reference value) noexcept { return iterator(this, &value); }
+    inline const_iterator iterator_to(const_reference value) const noexcept
+    {
+        return const_iterator(this, &value);
+    }
+
+    iterator erase(const_iterator iter);
+    inline size_type erase(const key_type& key) { return extract_(key) ? 1 : 0; }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline size_type erase(const KeyT& key)
+    {
+        return extract_(key) ? 1 : 0;
+    }
+
+    inline value_link_type extract(const key_type& key) { return extract_(key); }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline value_link_type extract(const KeyT& key)
+    {
+        return extract_(key);
+    }
+
+    // Unlinks an element of this set without looking it up: the rebalancing costs amortised O(1) rotations and
+    // recolorings. The link owning the element is handed back to the caller.
+    inline value_link_type unlink(reference value) noexcept { return unlink_node_(&value); }
+
+    void clear() noexcept;
+    void swap(sharable_intrusive_set& other) noexcept;
+
+private:
+    inline static pointer address_(const value_link_type& link) noexcept { return link_traits_type::address(link); }
+    inline pointer root_pointer_() const noexcept { return address_(root_); }
+    inline static bool is_red_(const_pointer node) noexcept { return node && node->red(); }
+
+    static pointer min_node_(pointer node) noexcept;
+    static pointer max_node_(pointer node) noexcept;
+    static pointer next_node_(pointer node) noexcept;
+    static pointer previous_node_(pointer node) noexcept;
+
+    template <class KeyT>
+    pointer find_node_(const KeyT& key) const;
+    template <class KeyT>
+    pointer lower_bound_node_(const KeyT& key) const;
+    template <class KeyT>
+    pointer upper_bound_node_(const KeyT& key) const;
+    template <class KeyT>
+    value_link_type extract_(const KeyT& key);
+
+    value_link_type& link_of_(pointer node) noexcept;
+    void rotate_left_(pointer node) noexcept;
+    void rotate_right_(pointer node) noexcept;
+    void insert_fixup_(pointer node) noexcept;
+    void erase_fixup_(pointer node, pointer parent) noexcept;
+    value_link_type unlink_node_(pointer node) noexcept;
+
+private:
+    value_link_type root_ = nullptr;
+    pointer leftmost_ = nullptr;
+    size_type size_ = 0;
+    [[no_unique_address]] CompareT comp_;
+    [[no_unique_address]] KeyOfT key_of_;
+};
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::sharable_intrusive_set(const CompareT& comp,
+                                                                                        const KeyOfT& key_of)
+    : comp_(comp), key_of_(key_of)
+{
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::sharable_intrusive_set(
+    sharable_intrusive_set&& other) noexcept
+    : root_(std::exchange(other.root_, nullptr)), leftmost_(std::exchange(other.leftmost_, nullptr)),
+      size_(std::exchange(other.size_, 0)), comp_(std::move(other.comp_)), key_of_(std::move(other.key_of_))
+{
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>&
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::operator=(sharable_intrusive_set&& other) noexcept
+{
+    sharable_intrusive_set aux(std::move(other));
+    swap(aux);
+    return *this;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::~sharable_intrusive_set()
+{
+    clear();
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+std::pair<typename sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::iterator, bool>
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::insert(value_link_type value_link)
+{
+    pointer value_ptr = address_(value_link);
+    pointer parent = nullptr;
+    value_link_type* link = &root_;
+    bool is_leftmost = true;
+    while (pointer node = address_(*link))
+    {
+        parent = node;
+        if (comp_(key_of_(*value_ptr), key_of_(*node)))
+            link = &node->left();
+        else if (comp_(key_of_(*node), key_of_(*value_ptr)))
+        {
+            link = &node->right();
+            is_leftmost = false;
+        }
+        else
+            return { iterator(this, node), false };
+    }
+
+    value_ptr->parent() = parent;
+    value_ptr->red() = true;
+    *link = std::move(value_link);
+    if (is_leftmost)
+        leftmost_ = value_ptr;
+    ++size_;
+    insert_fixup_(value_ptr);
+    return { iterator(this, value_ptr), true };
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+typename sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::iterator
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::erase(const_iterator iter)
+{
+    pointer node = const_cast<pointer>(iter.ptr());
+    pointer next = next_node_(node);
+    unlink_node_(node);
+    return iterator(this, next);
+}
+
+// The tree is flattened by right rotations while it is destroyed: no recursion, whatever its shape.
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+void sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::clear() noexcept
+{
+    while (pointer node = address_(root_))
+    {
+        if (pointer left = node->left_pointer())
+        {
+            value_link_type left_link = std::exchange(node->left(), nullptr);
+            node->left() = std::exchange(left->right(), nullptr);
+            left->right() = std::exchange(root_, nullptr);
+            root_ = std::move(left_link);
+        }
+        else
+        {
+            value_link_type right_link = std::exchange(node->right(), nullptr);
+            node->parent() = nullptr;
+            node->red() = false;
+            root_ = std::move(right_link);
+        }
+    }
+    leftmost_ = nullptr;
+    size_ = 0;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+void sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::swap(sharable_intrusive_set& other) noexcept
+{
+    using std::swap;
+    swap(root_, other.root_);
+    swap(leftmost_, other.leftmost_);
+    swap(size_, other.size_);
+    swap(comp_, other.comp_);
+    swap(key_of_, other.key_of_);
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+typename sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::pointer
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::min_node_(pointer node) noexcept
+{
+    if (node)
+        while (pointer left = node->left_pointer())
+            node = left;
+    return node;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+typename sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::pointer
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::max_node_(pointer node) noexcept
+{
+    if (node)
+        while (pointer right = node->right_pointer())
+            node = right;
+    return node;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+typename sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::pointer
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::next_node_(pointer node) noexcept
+{
+    if (pointer right = node->right_pointer())
+        return min_node_(right);
+    pointer parent = node->parent();
+    while (parent && node == parent->right_pointer())
+    {
+        node = parent;
+        parent = parent->parent();
+    }
+    return parent;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+typename sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::pointer
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::previous_node_(pointer node) noexcept
+{
+    if (pointer left = node->left_pointer())
+        return max_node_(left);
+    pointer parent = node->parent();
+    while (parent && node == parent->left_pointer())
+    {
+        node = parent;
+        parent = parent->parent();
+    }
+    return parent;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+template <class KeyT>
+typename sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::pointer
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::find_node_(const KeyT& key) const
+{
+    pointer node = lower_bound_node_(key);
+    return node && !comp_(key, key_of_(*node)) ? node : nullptr;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+template <class KeyT>
+typename sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::pointer
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::lower_bound_node_(const KeyT& key) const
+{
+    pointer result = nullptr;
+    for (pointer node = root_pointer_(); node;)
+    {
+        if (!comp_(key_of_(*node), key))
+        {
+            result = node;
+            node = node->left_pointer();
+        }
+        else
+            node = node->right_pointer();
+    }
+    return result;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+template <class KeyT>
+typename sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::pointer
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::upper_bound_node_(const KeyT& key) const
+{
+    pointer result = nullptr;
+    for (pointer node = root_pointer_(); node;)
+    {
+        if (comp_(key, key_of_(*node)))
+        {
+            result = node;
+            node = node->left_pointer();
+        }
+        else
+            node = node->right_pointer();
+    }
+    return result;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+template <class KeyT>
+typename sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::value_link_type
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::extract_(const KeyT& key)
+{
+    pointer node = find_node_(key);
+    return node ? unlink_node_(node) : value_link_type(nullptr);
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+typename sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::value_link_type&
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::link_of_(pointer node) noexcept
+{
+    pointer parent = node->parent();
+    if (!parent)
+        return root_;
+    return parent->left_pointer() == node ? parent->left() : parent->right();
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+void sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::rotate_left_(pointer node) noexcept
+{
+    value_link_type& node_link = link_of_(node);
+    value_link_type right_link = std::exchange(node->right(), nullptr);
+    pointer right = address_(right_link);
+    node->right() = std::exchange(right->left(), nullptr);
+    if (pointer moved = node->right_pointer())
+        moved->parent() = node;
+    right->parent() = node->parent();
+    right->left() = std::exchange(node_link, std::move(right_link));
+    node->parent() = right;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+void sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::rotate_right_(pointer node) noexcept
+{
+    value_link_type& node_link = link_of_(node);
+    value_link_type left_link = std::exchange(node->left(), nullptr);
+    pointer left = address_(left_link);
+    node->left() = std::exchange(left->right(), nullptr);
+    if (pointer moved = node->left_pointer())
+        moved->parent() = node;
+    left->parent() = node->parent();
+    left->right() = std::exchange(node_link, std::move(left_link));
+    node->parent() = left;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+void sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::insert_fixup_(pointer node) noexcept
+{
+    while (is_red_(node->parent()))
+    {
+        pointer parent = node->parent();
+        pointer grand_parent = parent->parent();
+        if (parent == grand_parent->left_pointer())
+        {
+            pointer uncle = grand_parent->right_pointer();
+            if (is_red_(uncle))
+            {
+                parent->red() = false;
+                uncle->red() = false;
+                grand_parent->red() = true;
+                node = grand_parent;
+                continue;
+            }
+            if (node == parent->right_pointer())
+            {
+                rotate_left_(parent);
+                std::swap(node, parent);
+            }
+            parent->red() = false;
+            grand_parent->red() = true;
+            rotate_right_(grand_parent);
+        }
+        else
+        {
+            pointer uncle = grand_parent->left_pointer();
+            if (is_red_(uncle))
+            {
+                parent->red() = false;
+                uncle->red() = false;
+                grand_parent->red() = true;
+                node = grand_parent;
+                continue;
+            }
+            if (node == parent->left_pointer())
+            {
+                rotate_right_(parent);
+                std::swap(node, parent);
+            }
+            parent->red() = false;
+            grand_parent->red() = true;
+            rotate_left_(grand_parent);
+        }
+    }
+    root_pointer_()->red() = false;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+typename sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::value_link_type
+sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::unlink_node_(pointer node) noexcept
+{
+    if (node == leftmost_)
+        leftmost_ = next_node_(node);
+
+    value_link_type& node_link = link_of_(node);
+    value_link_type removed_link = std::exchange(node_link, nullptr);
+    pointer child = nullptr;
+    pointer child_parent = nullptr;
+    bool removed_red = node->red();
+    if (!node->left_pointer() || !node->right_pointer())
+    {
+        node_link = std::exchange(node->left_pointer() ? node->left() : node->right(), nullptr);
+        child = address_(node_link);
+        child_parent = node->parent();
+        if (child)
+            child->parent() = child_parent;
+    }
+    else
+    {
+        // The successor takes the place (and the color) of the removed node.
+        pointer successor = min_node_(node->right_pointer());
+        removed_red = successor->red();
+        child = successor->right_pointer();
+        value_link_type successor_link = nullptr;
+        if (successor->parent() == node)
+        {
+            successor_link = std::exchange(node->right(), nullptr);
+            child_parent = successor;
+        }
+        else
+        {
+            child_parent = successor->parent();
+            successor_link = std::exchange(child_parent->left(), nullptr);
+            child_parent->left() = std::exchange(successor->right(), nullptr);
+            if (child)
+                child->parent() = child_parent;
+            successor->right() = std::exchange(node->right(), nullptr);
+            successor->right_pointer()->parent() = successor;
+        }
+        successor->left() = std::exchange(node->left(), nullptr);
+        successor->left_pointer()->parent() = successor;
+        successor->parent() = node->parent();
+        successor->red() = node->red();
+        node_link = std::move(successor_link);
+    }
+    node->parent() = nullptr;
+    node->red() = false;
+    --size_;
+
+    if (!removed_red)
+        erase_fixup_(child, child_parent);
+    return removed_link;
+}
+
+template <class IntrusiveT, class KeyOfT, class CompareT, LinkPolicy lk_policy>
+void sharable_intrusive_set<IntrusiveT, KeyOfT, CompareT, lk_policy>::erase_fixup_(pointer node,
+                                                                                   pointer parent) noexcept
+{
+    while (parent && !is_red_(node))
+    {
+        if (node == parent->left_pointer())
+        {
+            pointer sibling = parent->right_pointer();
+            if (sibling->red())
+            {
+                sibling->red() = false;
+                parent->red() = true;
+                rotate_left_(parent);
+                sibling = parent->right_pointer();
+            }
+            if (!is_red_(sibling->left_pointer()) && !is_red_(sibling->right_pointer()))
+            {
+                sibling->red() = true;
+                node = parent;
+                parent = node->parent();
+                continue;
+            }
+            if (!is_red_(sibling->right_pointer()))
+            {
+                sibling->left_pointer()->red() = false;
+                sibling->red() = true;
+                rotate_right_(sibling);
+                sibling = parent->right_pointer();
+            }
+            sibling->red() = parent->red();
+            parent->red() = false;
+            sibling->right_pointer()->red() = false;
+            rotate_left_(parent);
+        }
+        else
+        {
+            pointer sibling = parent->left_pointer();
+            if (sibling->red())
+            {
+                sibling->red() = false;
+                parent->red() = true;
+                rotate_right_(parent);
+                sibling = parent->left_pointer();
+            }
+            if (!is_red_(sibling->left_pointer()) && !is_red_(sibling->right_pointer()))
+            {
+                sibling->red() = true;
+                node = parent;
+                parent = node->parent();
+                continue;
+            }
+            if (!is_red_(sibling->left_pointer()))
+            {
+                sibling->right_pointer()->red() = false;
+                sibling->red() = true;
+                rotate_left_(sibling);
+                sibling = parent->left_pointer();
+            }
+            sibling->red() = parent->red();
+            parent->red() = false;
+            sibling->left_pointer()->red() = false;
+            rotate_right_(parent);
+        }
+        node = root_pointer_();
+        break;
+    }
+    if (node)
+        node->red() = false;
+}
+
+} // namespace itru
+} // namespace arba
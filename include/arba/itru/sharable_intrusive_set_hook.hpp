@@ -0,0 +1,46 @@
+#pragma once
+
+#include "policy/link_policy.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+template <typename IntrusiveTreeNodeT, LinkPolicy lk_policy = shared_link_t>
+class sharable_intrusive_set_hook
+{
+public:
+    using link_policy_type = lk_policy;
+    using link_traits_type = link_traits<IntrusiveTreeNodeT, lk_policy>;
+    using link_type = typename link_traits_type::link_type;
+
+    inline IntrusiveTreeNodeT* parent() const noexcept { return parent_; }
+    inline IntrusiveTreeNodeT*& parent() noexcept { return parent_; }
+    inline const link_type& left() const noexcept { return left_; }
+    inline link_type& left() noexcept { return left_; }
+    inline const link_type& right() const noexcept { return right_; }
+    inline link_type& right() noexcept { return right_; }
+    inline IntrusiveTreeNodeT* left_pointer() const noexcept { return link_traits_type::address(left_); }
+    inline IntrusiveTreeNodeT* right_pointer() const noexcept { return link_traits_type::address(right_); }
+    inline bool red() const noexcept { return red_; }
+    inline bool& red() noexcept { return red_; }
+
+private:
+    IntrusiveTreeNodeT* parent_ = nullptr;
+    link_type left_ = nullptr;
+    link_type right_ = nullptr;
+    bool red_ = false;
+};
+
+template <typename IntrusiveTreeNodeT, LinkPolicy lk_policy>
+lk_policy set_hook_link_policy(const sharable_intrusive_set_hook<IntrusiveTreeNodeT, lk_policy>*);
+
+template <typename IntrusiveT>
+using set_hook_link_policy_t = decltype(set_hook_link_policy(std::declval<IntrusiveT*>()));
+
+} // namespace itru
+} // namespace arba
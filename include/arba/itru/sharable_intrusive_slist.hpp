@@ -0,0 +1,292 @@
+#pragma once
+
+#include "policy/link_policy.hpp"
+#include "sharable_intrusive_slist_hook.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <cassert>
+#include <iterator>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+template <typename IntrusiveT, typename HookAccessorT = base_slist_hook_accessor<std::remove_const_t<IntrusiveT>>>
+class sharable_intrusive_slist_iterator
+{
+public:
+    using value_type = IntrusiveT;
+    using pointer = std::add_pointer_t<IntrusiveT>;
+    using reference = std::add_lvalue_reference_t<IntrusiveT>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    sharable_intrusive_slist_iterator() = default;
+    explicit sharable_intrusive_slist_iterator(pointer node_ptr) : pointer_(node_ptr) {}
+
+    inline sharable_intrusive_slist_iterator(
+        sharable_intrusive_slist_iterator<std::remove_const_t<IntrusiveT>, HookAccessorT> const& iter)
+        : pointer_(iter.ptr())
+    {
+    }
+
+    inline sharable_intrusive_slist_iterator& operator=(sharable_intrusive_slist_iterator const& iter) = default;
+
+    sharable_intrusive_slist_iterator& operator++() noexcept
+    {
+        pointer_ = HookAccessorT::hook(*pointer_).next_pointer();
+        return *this;
+    }
+    sharable_intrusive_slist_iterator operator++(int) noexcept
+    {
+        sharable_intrusive_slist_iterator iter(*this);
+        ++(*this);
+        return iter;
+    }
+
+    reference operator*() const noexcept { return *pointer_; }
+    pointer operator->() const noexcept { return pointer_; }
+
+    inline pointer ptr() const noexcept { return pointer_; }
+    inline shared_intrusive_ptr<value_type> make_intrusive_shared() const noexcept
+    {
+        return shared_intrusive_ptr<value_type>(pointer_);
+    }
+
+    auto operator<=>(const sharable_intrusive_slist_iterator&) const noexcept = default;
+
+private:
+    pointer pointer_ = nullptr;
+};
+
+// Singly linked list: its hook holds one link, to the next node. The last node links to nothing, the list keeps a
+// pointer to it for push_back(). As with std::forward_list, the insertions and erasures take place after a position,
+// the position before the first node being before_begin(), a sentinel node owned by the list.
+template <typename IntrusiveT, typename SentinelT = IntrusiveT,
+          typename HookAccessorT = base_slist_hook_accessor<IntrusiveT>>
+class sharable_intrusive_slist
+{
+public:
+    using value_type = IntrusiveT;
+    using size_type = std::size_t;
+    using reference = std::add_lvalue_reference_t<value_type>;
+    using const_reference = std::add_lvalue_reference_t<std::add_const_t<value_type>>;
+    using pointer = std::add_pointer_t<value_type>;
+    using const_pointer = std::add_pointer_t<std::add_const_t<value_type>>;
+    using iterator = sharable_intrusive_slist_iterator<value_type, HookAccessorT>;
+    using const_iterator = sharable_intrusive_slist_iterator<const value_type, HookAccessorT>;
+    using difference_type = std::ptrdiff_t;
+    using value_siptr_type = shared_intrusive_ptr<value_type>;
+    using hook_accessor_type = HookAccessorT;
+    using hook_type = typename HookAccessorT::hook_type;
+    using link_policy_type = typename hook_type::link_policy_type;
+    using link_traits_type = link_traits<value_type, link_policy_type>;
+    using value_link_type = typename link_traits_type::link_type;
+
+    static constexpr bool owns_values = std::is_same_v<link_policy_type, shared_link_t>;
+
+public:
+    sharable_intrusive_slist() = default;
+    explicit sharable_intrusive_slist(SentinelT sentinel) : sentinel_(std::move(sentinel)) {}
+    sharable_intrusive_slist(sharable_intrusive_slist&& other) { splice_after(before_begin(), other); }
+    ~sharable_intrusive_slist() { clear(); }
+
+    inline const_iterator before_begin() const noexcept { return const_iterator(&sentinel_); }
+    inline iterator before_begin() noexcept { return iterator(&sentinel_); }
+    inline const_iterator cbefore_begin() const noexcept { return before_begin(); }
+
+    inline const_iterator begin() const noexcept { return const_iterator(hook_(sentinel_).next_pointer()); }
+    inline iterator begin() noexcept { return iterator(hook_(sentinel_).next_pointer()); }
+    inline const_iterator cbegin() const noexcept { return begin(); }
+
+    inline const_iterator end() const noexcept { return const_iterator(); }
+    inline iterator end() noexcept { return iterator(); }
+    inline const_iterator cend() const noexcept { return end(); }
+
+    inline bool empty() const noexcept { return size_ == 0; }
+    inline std::size_t size() const noexcept { return size_; }
+
+    inline const_reference front() const noexcept { return *begin(); }
+    inline reference front() noexcept { return *begin(); }
+
+    inline const_reference back() const noexcept { return *tail_(); }
+    inline reference back() noexcept { return *tail_(); }
+
+    inline void push_front(value_link_type value_link) { insert_after(before_begin(), std::move(value_link)); }
+    inline void push_back(value_link_type value_link) { insert_after(iterator(tail_()), std::move(value_link)); }
+    iterator insert_after(const_iterator iter, value_link_type value_link);
+
+    template <class... ArgsT>
+        requires owns_values
+    inline void emplace_front(ArgsT&&... args)
+    {
+        push_front(make_shared_intrusive_ptr<value_type>(std::forward<ArgsT>(args)...));
+    }
+    template <class... ArgsT>
+        requires owns_values
+    inline void emplace_back(ArgsT&&... args)
+    {
+        push_back(make_shared_intrusive_ptr<value_type>(std::forward<ArgsT>(args)...));
+    }
+    template <class... ArgsT>
+        requires owns_values
+    inline iterator emplace_after(const_iterator iter, ArgsT&&... args)
+    {
+        return insert_after(iter, make_shared_intrusive_ptr<value_type>(std::forward<ArgsT>(args)...));
+    }
+
+    inline void pop_front() { erase_after(before_begin()); }
+    // Erases the node following iter. Returns an iterator to the node following the erased one.
+    iterator erase_after(const_iterator iter);
+
+    void clear();
+    void swap(sharable_intrusive_slist& other);
+
+    // Moves the nodes of other after iter.
+    void splice_after(const_iterator iter, sharable_intrusive_slist& other);
+    inline void splice_after(const_iterator iter, sharable_intrusive_slist&& other) { splice_after(iter, other); }
+    // Moves the node of other following before_it after iter.
+    void splice_after(const_iterator iter, sharable_intrusive_slist& other, const_iterator before_it);
+
+    template <class UnaryPredicate>
+    size_type remove_if(UnaryPredicate predicate);
+
+    // Relinks the nodes in place: no counter is touched.
+    void reverse() noexcept;
+
+private:
+    inline static hook_type& hook_(value_type& value) noexcept { return HookAccessorT::hook(value); }
+    inline static const hook_type& hook_(const value_type& value) noexcept { return HookAccessorT::hook(value); }
+    inline pointer tail_() const noexcept { return tail_ptr_ ? tail_ptr_ : const_cast<pointer>(&sentinel_); }
+
+    SentinelT sentinel_;
+    // Last node, null when the list is empty.
+    pointer tail_ptr_ = nullptr;
+    size_type size_ = 0;
+};
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+typename sharable_intrusive_slist<IntrusiveT, SentinelT, HookAccessorT>::iterator
+sharable_intrusive_slist<IntrusiveT, SentinelT, HookAccessorT>::insert_after(const_iterator iter,
+                                                                             value_link_type value_link)
+{
+    pointer previous = const_cast<pointer>(iter.ptr());
+    pointer value_ptr = link_traits_type::address(value_link);
+    assert(value_ptr && !hook_(*value_ptr).next_pointer());
+    hook_(*value_ptr).next() = std::exchange(hook_(*previous).next(), nullptr);
+    hook_(*previous).next() = std::move(value_link);
+    if (previous == tail_())
+        tail_ptr_ = value_ptr;
+    ++size_;
+    return iterator(value_ptr);
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+typename sharable_intrusive_slist<IntrusiveT, SentinelT, HookAccessorT>::iterator
+sharable_intrusive_slist<IntrusiveT, SentinelT, HookAccessorT>::erase_after(const_iterator iter)
+{
+    pointer previous = const_cast<pointer>(iter.ptr());
+    pointer erased = hook_(*previous).next_pointer();
+    assert(erased);
+    if (erased == tail_ptr_)
+        tail_ptr_ = previous != &sentinel_ ? previous : nullptr;
+    // The erased node is released once unlinked.
+    [[maybe_unused]] value_link_type erased_link =
+        std::exchange(hook_(*previous).next(), std::exchange(hook_(*erased).next(), nullptr));
+    --size_;
+    return iterator(hook_(*previous).next_pointer());
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_slist<IntrusiveT, SentinelT, HookAccessorT>::clear()
+{
+    // The nodes are unlinked one by one: releasing the head would otherwise release the whole chain recursively.
+    value_link_type& sentinel_next = hook_(sentinel_).next();
+    for (pointer first_value = link_traits_type::address(sentinel_next); first_value;
+         first_value = link_traits_type::address(sentinel_next))
+        sentinel_next = std::exchange(hook_(*first_value).next(), nullptr);
+    tail_ptr_ = nullptr;
+    size_ = 0;
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_slist<IntrusiveT, SentinelT, HookAccessorT>::swap(sharable_intrusive_slist& other)
+{
+    std::swap(hook_(sentinel_).next(), hook_(other.sentinel_).next());
+    std::swap(tail_ptr_, other.tail_ptr_);
+    std::swap(size_, other.size_);
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_slist<IntrusiveT, SentinelT, HookAccessorT>::splice_after(const_iterator iter,
+                                                                                  sharable_intrusive_slist& other)
+{
+    if (other.empty() || &other == this)
+        return;
+    pointer previous = const_cast<pointer>(iter.ptr());
+    pointer other_tail = other.tail_ptr_;
+    hook_(*other_tail).next() = std::exchange(hook_(*previous).next(), nullptr);
+    hook_(*previous).next() = std::exchange(hook_(other.sentinel_).next(), nullptr);
+    if (previous == tail_())
+        tail_ptr_ = other_tail;
+    size_ += std::exchange(other.size_, 0);
+    other.tail_ptr_ = nullptr;
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_slist<IntrusiveT, SentinelT, HookAccessorT>::splice_after(const_iterator iter,
+                                                                                  sharable_intrusive_slist& other,
+                                                                                  const_iterator before_it)
+{
+    pointer other_previous = const_cast<pointer>(before_it.ptr());
+    pointer moved = hook_(*other_previous).next_pointer();
+    if (moved == iter.ptr() || other_previous == iter.ptr())
+        return;
+    if (moved == other.tail_ptr_)
+        other.tail_ptr_ = other_previous != &other.sentinel_ ? other_previous : nullptr;
+    value_link_type moved_link =
+        std::exchange(hook_(*other_previous).next(), std::exchange(hook_(*moved).next(), nullptr));
+    --other.size_;
+    insert_after(iter, std::move(moved_link));
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+template <class UnaryPredicate>
+typename sharable_intrusive_slist<IntrusiveT, SentinelT, HookAccessorT>::size_type
+sharable_intrusive_slist<IntrusiveT, SentinelT, HookAccessorT>::remove_if(UnaryPredicate predicate)
+{
+    size_type count = 0;
+    for (iterator previous_iter = before_begin(), iter = begin(), end_iter = end(); iter != end_iter;)
+    {
+        if (predicate(*iter))
+        {
+            iter = erase_after(previous_iter);
+            ++count;
+        }
+        else
+            previous_iter = iter++;
+    }
+    return count;
+}
+
+template <class IntrusiveT, typename SentinelT, typename HookAccessorT>
+void sharable_intrusive_slist<IntrusiveT, SentinelT, HookAccessorT>::reverse() noexcept
+{
+    value_link_type head_link = std::exchange(hook_(sentinel_).next(), nullptr);
+    tail_ptr_ = link_traits_type::address(head_link);
+    value_link_type reversed_link = nullptr;
+    while (head_link)
+    {
+        hook_type& head_hook = hook_(*link_traits_type::address(head_link));
+        value_link_type next_link = std::exchange(head_hook.next(), nullptr);
+        head_hook.next() = std::move(reversed_link);
+        reversed_link = std::move(head_link);
+        head_link = std::move(next_link);
+    }
+    hook_(sentinel_).next() = std::move(reversed_link);
+}
+
+} // namespace itru
+} // namespace arba
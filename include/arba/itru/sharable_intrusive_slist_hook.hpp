@@ -0,0 +1,50 @@
+#pragma once
+
+#include "policy/link_policy.hpp"
+#include "sharable_intrusive_list_hook.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Hook of sharable_intrusive_slist: one link, to the next node.
+template <typename IntrusiveSlistNodeT, LinkPolicy lk_policy = shared_link_t, typename TagT = default_hook_tag>
+class sharable_intrusive_slist_hook
+{
+public:
+    using link_policy_type = lk_policy;
+    using link_traits_type = link_traits<IntrusiveSlistNodeT, lk_policy>;
+    using link_type = typename link_traits_type::link_type;
+    using tag_type = TagT;
+
+    inline const link_type& next() const noexcept { return next_; }
+    inline link_type& next() noexcept { return next_; }
+    inline IntrusiveSlistNodeT* next_pointer() const noexcept { return link_traits_type::address(next_); }
+
+private:
+    link_type next_ = nullptr;
+};
+
+template <typename TagT, typename IntrusiveSlistNodeT, LinkPolicy lk_policy>
+sharable_intrusive_slist_hook<IntrusiveSlistNodeT, lk_policy, TagT>*
+slist_hook_base(const sharable_intrusive_slist_hook<IntrusiveSlistNodeT, lk_policy, TagT>*);
+
+template <typename IntrusiveT, typename TagT = default_hook_tag>
+using slist_hook_t = std::remove_pointer_t<decltype(slist_hook_base<TagT>(std::declval<IntrusiveT*>()))>;
+
+template <typename IntrusiveT, typename TagT = default_hook_tag>
+struct base_slist_hook_accessor
+{
+    using hook_type = slist_hook_t<IntrusiveT, TagT>;
+
+    inline static hook_type& hook(IntrusiveT& value) noexcept { return value; }
+    inline static const hook_type& hook(const IntrusiveT& value) noexcept { return value; }
+};
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "sharable_intrusive_tree_hook.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <cassert>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+template <typename IntrusiveT>
+sharable_intrusive_tree_hook<IntrusiveT>* tree_hook_base(const sharable_intrusive_tree_hook<IntrusiveT>*);
+
+template <typename IntrusiveT>
+using tree_hook_t = std::remove_pointer_t<decltype(tree_hook_base(std::declval<IntrusiveT*>()))>;
+
+// Pre-order traversal of a subtree, following the parent and sibling links: no stack is needed.
+template <typename IntrusiveT>
+class tree_preorder_iterator
+{
+public:
+    using value_type = IntrusiveT;
+    using pointer = IntrusiveT*;
+    using reference = IntrusiveT&;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    tree_preorder_iterator() = default;
+    inline tree_preorder_iterator(pointer node, pointer root) : pointer_(node), root_(root) {}
+
+    tree_preorder_iterator& operator++() noexcept
+    {
+        using hook_type = tree_hook_t<std::remove_const_t<IntrusiveT>>;
+        if (const hook_type& hook = *pointer_; hook.has_children())
+        {
+            pointer_ = hook.first_child().get();
+            return *this;
+        }
+        while (pointer_ != root_ && !static_cast<const hook_type&>(*pointer_).next_sibling())
+            pointer_ = static_cast<const hook_type&>(*pointer_).parent();
+        pointer_ = pointer_ != root_ ? static_cast<const hook_type&>(*pointer_).next_sibling() : nullptr;
+        return *this;
+    }
+    tree_preorder_iterator operator++(int) noexcept
+    {
+        tree_preorder_iterator iter(*this);
+        ++(*this);
+        return iter;
+    }
+
+    inline reference operator*() const noexcept { return *pointer_; }
+    inline pointer operator->() const noexcept { return pointer_; }
+    inline pointer ptr() const noexcept { return pointer_; }
+
+    inline bool operator==(const tree_preorder_iterator& iter) const noexcept { return pointer_ == iter.pointer_; }
+
+private:
+    pointer pointer_ = nullptr;
+    pointer root_ = nullptr;
+};
+
+// Post-order traversal of a subtree: the children of a node are visited before it, which is the order in which a
+// subtree can be taken apart. No stack is needed either.
+template <typename IntrusiveT>
+class tree_postorder_iterator
+{
+public:
+    using value_type = IntrusiveT;
+    using pointer = IntrusiveT*;
+    using reference = IntrusiveT&;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    tree_postorder_iterator() = default;
+    inline tree_postorder_iterator(pointer node, pointer root) : pointer_(node), root_(root) {}
+
+    // First node of the post-order traversal of the subtree of node: its leftmost leaf.
+    inline static pointer first(pointer node) noexcept
+    {
+        while (static_cast<const hook_type&>(*node).has_children())
+            node = static_cast<const hook_type&>(*node).first_child().get();
+        return node;
+    }
+
+    tree_postorder_iterator& operator++() noexcept
+    {
+        if (pointer_ == root_)
+            pointer_ = nullptr;
+        else if (pointer next = static_cast<const hook_type&>(*pointer_).next_sibling())
+            pointer_ = first(next);
+        else
+            pointer_ = static_cast<const hook_type&>(*pointer_).parent();
+        return *this;
+    }
+    tree_postorder_iterator operator++(int) noexcept
+    {
+        tree_postorder_iterator iter(*this);
+        ++(*this);
+        return iter;
+    }
+
+    inline reference operator*() const noexcept { return *pointer_; }
+    inline pointer operator->() const noexcept { return pointer_; }
+    inline pointer ptr() const noexcept { return pointer_; }
+
+    inline bool operator==(const tree_postorder_iterator& iter) const noexcept { return pointer_ == iter.pointer_; }
+
+private:
+    using hook_type = tree_hook_t<std::remove_const_t<IntrusiveT>>;
+
+    pointer pointer_ = nullptr;
+    pointer root_ = nullptr;
+};
+
+// Tree of nodes deriving from sharable_intrusive_tree_hook. The tree owns its root, each node owns its children.
+// The structural operations are static: they apply to any node, whichever tree it belongs to, and relink nodes
+// without touching their counters, except when a node enters or leaves a tree.
+template <typename IntrusiveT>
+class sharable_intrusive_tree
+{
+public:
+    using value_type = IntrusiveT;
+    using pointer = std::add_pointer_t<value_type>;
+    using value_siptr_type = shared_intrusive_ptr<value_type>;
+    using hook_type = tree_hook_t<value_type>;
+    using preorder_iterator = tree_preorder_iterator<value_type>;
+    using postorder_iterator = tree_postorder_iterator<value_type>;
+    using const_preorder_iterator = tree_preorder_iterator<const value_type>;
+    using const_postorder_iterator = tree_postorder_iterator<const value_type>;
+
+    sharable_intrusive_tree() = default;
+    explicit sharable_intrusive_tree(value_siptr_type root) { set_root(std::move(root)); }
+    sharable_intrusive_tree(sharable_intrusive_tree&& other) noexcept : root_(std::move(other.root_)) {}
+    inline sharable_intrusive_tree& operator=(sharable_intrusive_tree&& other) noexcept
+    {
+        root_.swap(other.root_);
+        return *this;
+    }
+    ~sharable_intrusive_tree() = default;
+
+    inline bool empty() const noexcept { return root_ == nullptr; }
+    inline pointer root() const noexcept { return root_.get(); }
+    // The root must not have a parent. Returns the previous root.
+    value_siptr_type set_root(value_siptr_type root);
+    inline void clear() noexcept { root_ = nullptr; }
+
+    // Number of nodes of the tree, counted by a traversal.
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    inline auto preorder() noexcept { return preorder(root()); }
+    inline auto postorder() noexcept { return postorder(root()); }
+    inline auto preorder() const noexcept { return preorder(static_cast<const value_type*>(root())); }
+    inline auto postorder() const noexcept { return postorder(static_cast<const value_type*>(root())); }
+
+    template <class NodeT>
+    inline static auto preorder(NodeT* subtree_root) noexcept
+    {
+        using iterator = tree_preorder_iterator<NodeT>;
+        return std::ranges::subrange(iterator(subtree_root, subtree_root), iterator());
+    }
+    template <class NodeT>
+    inline static auto postorder(NodeT* subtree_root) noexcept
+    {
+        using iterator = tree_postorder_iterator<NodeT>;
+        return std::ranges::subrange(
+            iterator(subtree_root ? iterator::first(subtree_root) : nullptr, subtree_root), iterator());
+    }
+
+    // Links child, which must not have a parent, as the last child of parent.
+    inline static void append_child(value_type& parent, value_siptr_type child)
+    {
+        insert_child_(parent, nullptr, std::move(child));
+    }
+    // Links child, which must not have a parent, as the first child of parent.
+    inline static void prepend_child(value_type& parent, value_siptr_type child)
+    {
+        insert_child_(parent, hook_(parent).first_child().get(), std::move(child));
+    }
+    // Links node, which must not have a parent, as the previous sibling of sibling.
+    inline static void insert_before(value_type& sibling, value_siptr_type node)
+    {
+        assert(hook_(sibling).parent());
+        insert_child_(*hook_(sibling).parent(), &sibling, std::move(node));
+    }
+    // Unlinks node from its parent, its subtree included. Returns the link the parent held on node.
+    static value_siptr_type detach(value_type& node) noexcept;
+    // Moves the subtree of node under new_parent, as its last child, in O(1). new_parent must not belong to the
+    // subtree of node.
+    static void reparent(value_type& node, value_type& new_parent) noexcept;
+    // Moves every child of from, in order, at the end of the children of to. Only their parent links are rewritten.
+    static void splice_children(value_type& to, value_type& from) noexcept;
+
+private:
+    inline static hook_type& hook_(value_type& node) noexcept { return node; }
+    static void insert_child_(value_type& parent, pointer next_sibling, value_siptr_type child);
+    static value_siptr_type unlink_(value_type& node) noexcept;
+
+    value_siptr_type root_;
+};
+
+template <typename IntrusiveT>
+typename sharable_intrusive_tree<IntrusiveT>::value_siptr_type
+sharable_intrusive_tree<IntrusiveT>::set_root(value_siptr_type root)
+{
+    assert(!root || !hook_(*root).parent());
+    root_.swap(root);
+    return root;
+}
+
+template <typename IntrusiveT>
+std::size_t sharable_intrusive_tree<IntrusiveT>::size() const noexcept
+{
+    std::size_t count = 0;
+    for ([[maybe_unused]] const value_type& node : preorder())
+        ++count;
+    return count;
+}
+
+template <typename IntrusiveT>
+typename sharable_intrusive_tree<IntrusiveT>::value_siptr_type
+sharable_intrusive_tree<IntrusiveT>::detach(value_type& node) noexcept
+{
+    if (!hook_(node).parent())
+        return nullptr;
+    return unlink_(node);
+}
+
+template <typename IntrusiveT>
+void sharable_intrusive_tree<IntrusiveT>::reparent(value_type& node, value_type& new_parent) noexcept
+{
+    assert(&node != &new_parent);
+    value_siptr_type link = hook_(node).parent() ? unlink_(node) : value_siptr_type(&node);
+    insert_child_(new_parent, nullptr, std::move(link));
+}
+
+template <typename IntrusiveT>
+void sharable_intrusive_tree<IntrusiveT>::splice_children(value_type& to, value_type& from) noexcept
+{
+    hook_type& from_hook = hook_(from);
+    if (!from_hook.has_children() || &to == &from)
+        return;
+    for (pointer child = from_hook.first_child().get(); child; child = hook_(*child).next_sibling())
+        hook_(*child).parent() = &to;
+    hook_type& to_hook = hook_(to);
+    pointer first = from_hook.first_child().get();
+    if (to_hook.has_children())
+    {
+        hook_(*first).previous() = to_hook.last_child();
+        hook_(*to_hook.last_child()).next() = std::exchange(from_hook.first_child(), nullptr);
+    }
+    else
+        to_hook.first_child() = std::exchange(from_hook.first_child(), nullptr);
+    to_hook.last_child() = std::exchange(from_hook.last_child(), nullptr);
+}
+
+template <typename IntrusiveT>
+void sharable_intrusive_tree<IntrusiveT>::insert_child_(value_type& parent, pointer next_sibling,
+                                                        value_siptr_type child)
+{
+    assert(child && !hook_(*child).parent() && !hook_(*child).next_sibling());
+    hook_type& parent_hook = hook_(parent);
+    hook_type& child_hook = hook_(*child);
+    pointer child_ptr = child.get();
+    child_hook.parent() = &parent;
+    if (next_sibling)
+    {
+        hook_type& next_hook = hook_(*next_sibling);
+        pointer previous = next_hook.previous_sibling();
+        child_hook.previous() = previous;
+        next_hook.previous() = child_ptr;
+        value_siptr_type& previous_link = previous ? hook_(*previous).next() : parent_hook.first_child();
+        child_hook.next() = std::exchange(previous_link, std::move(child));
+    }
+    else
+    {
+        pointer last = parent_hook.last_child();
+        child_hook.previous() = last;
+        (last ? hook_(*last).next() : parent_hook.first_child()) = std::move(child);
+        parent_hook.last_child() = child_ptr;
+    }
+}
+
+template <typename IntrusiveT>
+typename sharable_intrusive_tree<IntrusiveT>::value_siptr_type
+sharable_intrusive_tree<IntrusiveT>::unlink_(value_type& node) noexcept
+{
+    hook_type& node_hook = hook_(node);
+    hook_type& parent_hook = hook_(*node_hook.parent());
+    pointer previous = node_hook.previous_sibling();
+    pointer next = node_hook.next_sibling();
+    (next ? hook_(*next).previous() : parent_hook.last_child()) = previous;
+    value_siptr_type& previous_link = previous ? hook_(*previous).next() : parent_hook.first_child();
+    value_siptr_type link = std::exchange(previous_link, std::exchange(node_hook.next(), nullptr));
+    node_hook.previous() = nullptr;
+    node_hook.parent() = nullptr;
+    return link;
+}
+
+} // namespace itru
+} // namespace arba
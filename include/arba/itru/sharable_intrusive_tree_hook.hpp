@@ -0,0 +1,84 @@
+#pragma once
+
+#include "sharable_intrusive_list_hook.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+struct tree_sibling_hook_tag
+{
+};
+
+// Hook of a sharable_intrusive_tree node. The children of a node form a list embedded in the tree: they are linked
+// to each other through a tagged sharable_intrusive_list_hook (shared link to the next sibling, raw link to the
+// previous one), the parent owns the first one and points to the last one. A node points to its parent with a raw
+// link: a parent owns its children, not the other way around.
+// The children of a dying node are released iteratively, whatever the depth of its subtree. A child still
+// referenced elsewhere survives as the root of a detached subtree.
+template <typename IntrusiveTreeNodeT>
+class sharable_intrusive_tree_hook
+    : public sharable_intrusive_list_hook<IntrusiveTreeNodeT, shared_link_t, tree_sibling_hook_tag>
+{
+public:
+    using sibling_hook_type = sharable_intrusive_list_hook<IntrusiveTreeNodeT, shared_link_t, tree_sibling_hook_tag>;
+    using link_type = shared_intrusive_ptr<IntrusiveTreeNodeT>;
+
+    sharable_intrusive_tree_hook() = default;
+    // A copied node is not linked in the tree of the original one.
+    inline sharable_intrusive_tree_hook(const sharable_intrusive_tree_hook&) noexcept : sibling_hook_type() {}
+    inline sharable_intrusive_tree_hook& operator=(const sharable_intrusive_tree_hook&) noexcept { return *this; }
+    inline ~sharable_intrusive_tree_hook() { release_children(); }
+
+    inline IntrusiveTreeNodeT* parent() const noexcept { return parent_; }
+    inline IntrusiveTreeNodeT*& parent() noexcept { return parent_; }
+    inline const link_type& first_child() const noexcept { return first_child_; }
+    inline link_type& first_child() noexcept { return first_child_; }
+    inline IntrusiveTreeNodeT* last_child() const noexcept { return last_child_; }
+    inline IntrusiveTreeNodeT*& last_child() noexcept { return last_child_; }
+    inline IntrusiveTreeNodeT* next_sibling() const noexcept { return sibling_hook_type::next_pointer(); }
+    inline IntrusiveTreeNodeT* previous_sibling() const noexcept { return sibling_hook_type::previous(); }
+    inline bool has_children() const noexcept { return first_child_ != nullptr; }
+
+    // Releases the children, then theirs when they die, without recursion: the children of a dying node are
+    // moved to the front of the work chain before the node is released.
+    void release_children() noexcept
+    {
+        link_type work = std::exchange(first_child_, nullptr);
+        last_child_ = nullptr;
+        while (work)
+        {
+            IntrusiveTreeNodeT* node = work.get();
+            sharable_intrusive_tree_hook& node_hook = hook_of_(*node);
+            node_hook.parent_ = nullptr;
+            node_hook.sibling_().previous() = nullptr;
+            link_type next = std::exchange(node_hook.sibling_().next(), nullptr);
+            if (node_hook.first_child_ && shared_intrusive_ptr_is_unique(node))
+            {
+                hook_of_(*node_hook.last_child_).sibling_().next() = std::move(next);
+                next = std::exchange(node_hook.first_child_, nullptr);
+                node_hook.last_child_ = nullptr;
+            }
+            work = std::move(next);
+        }
+    }
+
+private:
+    inline static sharable_intrusive_tree_hook& hook_of_(IntrusiveTreeNodeT& node) noexcept
+    {
+        return static_cast<sharable_intrusive_tree_hook&>(node);
+    }
+    inline sibling_hook_type& sibling_() noexcept { return *this; }
+
+    IntrusiveTreeNodeT* parent_ = nullptr;
+    link_type first_child_ = nullptr;
+    IntrusiveTreeNodeT* last_child_ = nullptr;
+};
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,562 @@
+#pragma once
+
+#include "key_of.hpp"
+#include "policy/link_policy.hpp"
+#include "sharable_intrusive_unordered_set_hook.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Elements are threaded through the sharable_intrusive_unordered_set_hook embedded in IntrusiveT: a bucket is a
+// singly linked chain of bucket_next() links. When the set grows, the old buckets are migrated a few at a time by
+// the following insertions, so no insertion pays for a whole rehash.
+template <typename IntrusiveT, typename KeyOfT, typename HashT = std::hash<key_of_result_t<IntrusiveT, KeyOfT>>,
+          typename KeyEqualT = std::equal_to<key_of_result_t<IntrusiveT, KeyOfT>>,
+          LinkPolicy lk_policy = unordered_set_hook_link_policy_t<IntrusiveT>>
+class sharable_intrusive_unordered_set
+{
+public:
+    using key_type = key_of_result_t<IntrusiveT, KeyOfT>;
+    using value_type = IntrusiveT;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = HashT;
+    using key_equal = KeyEqualT;
+    using reference = std::add_lvalue_reference_t<value_type>;
+    using const_reference = std::add_lvalue_reference_t<std::add_const_t<value_type>>;
+    using pointer = std::add_pointer_t<value_type>;
+    using const_pointer = std::add_pointer_t<std::add_const_t<value_type>>;
+    using value_siptr_type = shared_intrusive_ptr<value_type>;
+    using link_policy_type = lk_policy;
+    using link_traits_type = link_traits<value_type, lk_policy>;
+    using value_link_type = typename link_traits_type::link_type;
+
+    static constexpr bool owns_values = std::is_same_v<lk_policy, shared_link_t>;
+    static constexpr size_type initial_bucket_count = 8;
+    static constexpr size_type rehash_step_bucket_count = 2;
+
+private:
+    using bucket_vector_type = std::vector<value_link_type>;
+
+    template <typename ValueT>
+    class iterator_
+    {
+    public:
+        using value_type = ValueT;
+        using pointer = std::add_pointer_t<ValueT>;
+        using reference = std::add_lvalue_reference_t<ValueT>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        iterator_() = default;
+
+        inline iterator_(const iterator_<std::remove_const_t<ValueT>>& iter)
+            : set_(iter.set_), pointer_(iter.pointer_), table_index_(iter.table_index_),
+              bucket_index_(iter.bucket_index_)
+        {
+        }
+
+        inline iterator_& operator=(const iterator_& iter) = default;
+
+        iterator_& operator++() noexcept
+        {
+            pointer_ = pointer_->bucket_next_pointer();
+            if (!pointer_)
+                set_->seek_node_(*this, bucket_index_ + 1);
+            return *this;
+        }
+        iterator_ operator++(int) noexcept
+        {
+            iterator_ iter(*this);
+            ++(*this);
+            return iter;
+        }
+
+        reference operator*() const noexcept { return *pointer_; }
+        pointer operator->() const noexcept { return pointer_; }
+
+        inline pointer ptr() const noexcept { return pointer_; }
+
+        inline bool operator==(const iterator_& other) const noexcept { return pointer_ == other.pointer_; }
+
+    private:
+        iterator_(const sharable_intrusive_unordered_set* set, pointer ptr, unsigned table_index,
+                  size_type bucket_index) noexcept
+            : set_(set), pointer_(ptr), table_index_(table_index), bucket_index_(bucket_index)
+        {
+        }
+
+        const sharable_intrusive_unordered_set* set_ = nullptr;
+        pointer pointer_ = nullptr;
+        unsigned table_index_ = 0;
+        size_type bucket_index_ = 0;
+
+        friend class sharable_intrusive_unordered_set;
+        template <typename OtherValueT>
+        friend class iterator_;
+    };
+
+public:
+    using iterator = iterator_<value_type>;
+    using const_iterator = iterator_<const value_type>;
+
+private:
+    template <class KeyT>
+    static constexpr bool transparent_key_v =
+        requires { typename HashT::is_transparent; typename KeyEqualT::is_transparent; }
+        && !std::is_convertible_v<const KeyT&, const_iterator> && !std::is_convertible_v<const KeyT&, iterator>;
+
+public:
+    sharable_intrusive_unordered_set() = default;
+    explicit sharable_intrusive_unordered_set(size_type bucket_count, const HashT& hash = HashT(),
+                                              const KeyEqualT& key_equal = KeyEqualT(),
+                                              const KeyOfT& key_of = KeyOfT());
+    sharable_intrusive_unordered_set(sharable_intrusive_unordered_set&& other) noexcept;
+    sharable_intrusive_unordered_set& operator=(sharable_intrusive_unordered_set&& other) noexcept;
+    ~sharable_intrusive_unordered_set();
+
+    inline const_iterator begin() const noexcept { return first_node_<const_iterator>(); }
+    inline iterator begin() noexcept { return first_node_<iterator>(); }
+    inline const_iterator cbegin() const noexcept { return begin(); }
+
+    inline const_iterator end() const noexcept { return const_iterator(); }
+    inline iterator end() noexcept { return iterator(); }
+    inline const_iterator cend() const noexcept { return end(); }
+
+    inline bool empty() const noexcept { return size_ == 0; }
+    inline size_type size() const noexcept { return size_; }
+
+    inline size_type bucket_count() const noexcept { return buckets_.size(); }
+    inline bool is_rehashing() const noexcept { return !old_buckets_.empty(); }
+    inline float load_factor() const noexcept
+    {
+        return buckets_.empty() ? 0.f : static_cast<float>(size_) / static_cast<float>(buckets_.size());
+    }
+    inline float max_load_factor() const noexcept { return max_load_factor_; }
+    // value must be positive.
+    inline void max_load_factor(float value) noexcept
+    {
+        assert(value > 0.f);
+        max_load_factor_ = value;
+    }
+
+    std::pair<iterator, bool> insert(value_link_type value_link);
+
+    template <class... ArgsT>
+        requires owns_values
+    inline std::pair<iterator, bool> emplace(ArgsT&&... args)
+    {
+        return insert(make_shared_intrusive_ptr<value_type>(std::forward<ArgsT>(args)...));
+    }
+
+    inline iterator find(const key_type& key) { return find_<iterator>(key); }
+    inline const_iterator find(const key_type& key) const { return find_<const_iterator>(key); }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline iterator find(const KeyT& key)
+    {
+        return find_<iterator>(key);
+    }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline const_iterator find(const KeyT& key) const
+    {
+        return find_<const_iterator>(key);
+    }
+
+    inline bool contains(const key_type& key) const { return find_node_(key) != nullptr; }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline bool contains(const KeyT& key) const
+    {
+        return find_node_(key) != nullptr;
+    }
+
+    inline size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline size_type count(const KeyT& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    iterator erase(const_iterator iter);
+    inline size_type erase(const key_type& key) { return extract_(key) ? 1 : 0; }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline size_type erase(const KeyT& key)
+    {
+        return extract_(key) ? 1 : 0;
+    }
+
+    inline value_link_type extract(const key_type& key) { return extract_(key); }
+    template <class KeyT>
+        requires transparent_key_v<KeyT>
+    inline value_link_type extract(const KeyT& key)
+    {
+        return extract_(key);
+    }
+
+    void clear();
+    void rehash(size_type bucket_count);
+    inline void reserve(size_type count)
+    {
+        rehash(static_cast<size_type>(std::ceil(static_cast<float>(count) / max_load_factor_)));
+    }
+
+    void swap(sharable_intrusive_unordered_set& other) noexcept;
+
+private:
+    inline size_type hash_(const auto& key) const { return hash_function_(key); }
+    // Fibonacci hashing: the high bits of the scrambled hash code are used, so that weak hash functions (like the
+    // identity for integers) still spread the elements over the power-of-two sized bucket table.
+    inline static size_type bucket_index_(size_type hash_code, size_type bucket_count) noexcept
+    {
+        const unsigned bit_count = std::countr_zero(bucket_count);
+        if (bit_count == 0)
+            return 0;
+        return static_cast<size_type>((std::uint64_t(hash_code) * 0x9E3779B97F4A7C15ull) >> (64 - bit_count));
+    }
+    value_link_type& bucket_of_(size_type hash_code) noexcept;
+    inline const value_link_type& bucket_of_(size_type hash_code) const noexcept
+    {
+        return const_cast<sharable_intrusive_unordered_set*>(this)->bucket_of_(hash_code);
+    }
+
+    template <class IteratorT>
+    IteratorT first_node_() const noexcept;
+    template <class IteratorT>
+    void seek_node_(IteratorT& iter, size_type bucket_index) const noexcept;
+    template <class IteratorT>
+    IteratorT make_iterator_(pointer ptr) const noexcept;
+    template <class IteratorT, class KeyT>
+    inline IteratorT find_(const KeyT& key) const
+    {
+        pointer node = find_node_(key);
+        return node ? make_iterator_<IteratorT>(node) : IteratorT();
+    }
+    template <class KeyT>
+    pointer find_node_(const KeyT& key) const;
+    template <class KeyT>
+    value_link_type extract_(const KeyT& key);
+    value_link_type unlink_(value_link_type& link) noexcept;
+
+    void prepare_insert_();
+    void start_rehash_(size_type bucket_count);
+    void migrate_bucket_(value_link_type& bucket) noexcept;
+    void finish_rehash_() noexcept;
+    static void clear_buckets_(bucket_vector_type& buckets) noexcept;
+
+private:
+    bucket_vector_type buckets_;
+    bucket_vector_type old_buckets_;
+    size_type migrated_bucket_count_ = 0;
+    size_type size_ = 0;
+    float max_load_factor_ = 1.f;
+    [[no_unique_address]] HashT hash_function_;
+    [[no_unique_address]] KeyEqualT key_equal_;
+    [[no_unique_address]] KeyOfT key_of_;
+};
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::sharable_intrusive_unordered_set(
+    size_type bucket_count, const HashT& hash, const KeyEqualT& key_equal, const KeyOfT& key_of)
+    : hash_function_(hash), key_equal_(key_equal), key_of_(key_of)
+{
+    rehash(bucket_count);
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::sharable_intrusive_unordered_set(
+    sharable_intrusive_unordered_set&& other) noexcept
+    : buckets_(std::move(other.buckets_)), old_buckets_(std::move(other.old_buckets_)),
+      migrated_bucket_count_(std::exchange(other.migrated_bucket_count_, 0)), size_(std::exchange(other.size_, 0)),
+      max_load_factor_(other.max_load_factor_), hash_function_(std::move(other.hash_function_)),
+      key_equal_(std::move(other.key_equal_)), key_of_(std::move(other.key_of_))
+{
+    other.buckets_.clear();
+    other.old_buckets_.clear();
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>&
+sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::operator=(
+    sharable_intrusive_unordered_set&& other) noexcept
+{
+    sharable_intrusive_unordered_set aux(std::move(other));
+    swap(aux);
+    return *this;
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::~sharable_intrusive_unordered_set()
+{
+    clear();
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+std::pair<typename sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::iterator, bool>
+sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::insert(value_link_type value_link)
+{
+    pointer value_ptr = link_traits_type::address(value_link);
+    const size_type hash_code = hash_(key_of_(*value_ptr));
+    if (!buckets_.empty())
+    {
+        for (pointer node = link_traits_type::address(bucket_of_(hash_code)); node; node = node->bucket_next_pointer())
+        {
+            if (node->hash_code() == hash_code && key_equal_(key_of_(*node), key_of_(*value_ptr)))
+                return { make_iterator_<iterator>(node), false };
+        }
+    }
+    prepare_insert_();
+    value_link_type& bucket = bucket_of_(hash_code);
+    value_ptr->hash_code() = hash_code;
+    value_ptr->bucket_next() = std::exchange(bucket, nullptr);
+    bucket = std::move(value_link);
+    ++size_;
+    return { make_iterator_<iterator>(value_ptr), true };
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+typename sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::iterator
+sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::erase(const_iterator iter)
+{
+    const_iterator next_iter = std::next(iter);
+    value_link_type* link = &bucket_of_(iter->hash_code());
+    while (link_traits_type::address(*link) != iter.ptr())
+        link = &link_traits_type::address(*link)->bucket_next();
+    unlink_(*link);
+    return iterator(this, const_cast<pointer>(next_iter.ptr()), next_iter.table_index_, next_iter.bucket_index_);
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+void sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::clear()
+{
+    clear_buckets_(old_buckets_);
+    clear_buckets_(buckets_);
+    old_buckets_ = bucket_vector_type();
+    migrated_bucket_count_ = 0;
+    size_ = 0;
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+void sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::rehash(size_type bucket_count)
+{
+    const size_type min_bucket_count =
+        static_cast<size_type>(std::ceil(static_cast<float>(size_) / max_load_factor_));
+    bucket_count = std::bit_ceil(std::max({ bucket_count, min_bucket_count, size_type(1) }));
+    if (bucket_count == buckets_.size())
+        return;
+    finish_rehash_();
+    start_rehash_(bucket_count);
+    finish_rehash_();
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+void sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::swap(
+    sharable_intrusive_unordered_set& other) noexcept
+{
+    using std::swap;
+    swap(buckets_, other.buckets_);
+    swap(old_buckets_, other.old_buckets_);
+    swap(migrated_bucket_count_, other.migrated_bucket_count_);
+    swap(size_, other.size_);
+    swap(max_load_factor_, other.max_load_factor_);
+    swap(hash_function_, other.hash_function_);
+    swap(key_equal_, other.key_equal_);
+    swap(key_of_, other.key_of_);
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+typename sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::value_link_type&
+sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::bucket_of_(
+    size_type hash_code) noexcept
+{
+    // A bucket of the old table which is not migrated yet still holds all the elements hashed to it.
+    if (!old_buckets_.empty())
+    {
+        const size_type old_index = bucket_index_(hash_code, old_buckets_.size());
+        if (old_index >= migrated_bucket_count_)
+            return old_buckets_[old_index];
+    }
+    return buckets_[bucket_index_(hash_code, buckets_.size())];
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+template <class IteratorT>
+IteratorT sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::first_node_() const noexcept
+{
+    IteratorT iter(this, nullptr, old_buckets_.empty() ? 1 : 0, 0);
+    seek_node_(iter, iter.table_index_ == 0 ? migrated_bucket_count_ : 0);
+    return iter;
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+template <class IteratorT>
+void sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::seek_node_(
+    IteratorT& iter, size_type bucket_index) const noexcept
+{
+    for (;;)
+    {
+        const bucket_vector_type& buckets = iter.table_index_ == 0 ? old_buckets_ : buckets_;
+        for (; bucket_index < buckets.size(); ++bucket_index)
+        {
+            if (pointer node = link_traits_type::address(buckets[bucket_index]))
+            {
+                iter.pointer_ = node;
+                iter.bucket_index_ = bucket_index;
+                return;
+            }
+        }
+        if (iter.table_index_ == 1)
+            break;
+        iter.table_index_ = 1;
+        bucket_index = 0;
+    }
+    iter = IteratorT();
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+template <class IteratorT>
+IteratorT sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::make_iterator_(
+    pointer ptr) const noexcept
+{
+    const size_type hash_code = ptr->hash_code();
+    if (!old_buckets_.empty())
+    {
+        const size_type old_index = bucket_index_(hash_code, old_buckets_.size());
+        if (old_index >= migrated_bucket_count_)
+            return IteratorT(this, ptr, 0, old_index);
+    }
+    return IteratorT(this, ptr, 1, bucket_index_(hash_code, buckets_.size()));
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+template <class KeyT>
+typename sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::pointer
+sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::find_node_(const KeyT& key) const
+{
+    if (size_ == 0)
+        return nullptr;
+    const size_type hash_code = hash_(key);
+    for (pointer node = link_traits_type::address(bucket_of_(hash_code)); node; node = node->bucket_next_pointer())
+    {
+        if (node->hash_code() == hash_code && key_equal_(key_of_(*node), key))
+            return node;
+    }
+    return nullptr;
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+template <class KeyT>
+typename sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::value_link_type
+sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::extract_(const KeyT& key)
+{
+    if (size_ == 0)
+        return nullptr;
+    const size_type hash_code = hash_(key);
+    for (value_link_type* link = &bucket_of_(hash_code); link_traits_type::address(*link);
+         link = &link_traits_type::address(*link)->bucket_next())
+    {
+        pointer node = link_traits_type::address(*link);
+        if (node->hash_code() == hash_code && key_equal_(key_of_(*node), key))
+            return unlink_(*link);
+    }
+    return nullptr;
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+typename sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::value_link_type
+sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::unlink_(
+    value_link_type& link) noexcept
+{
+    value_link_type removed_link = std::exchange(link, nullptr);
+    link = std::exchange(link_traits_type::address(removed_link)->bucket_next(), nullptr);
+    --size_;
+    return removed_link;
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+void sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::prepare_insert_()
+{
+    if (buckets_.empty())
+    {
+        buckets_.resize(initial_bucket_count);
+        return;
+    }
+    for (size_type i = 0; i < rehash_step_bucket_count && is_rehashing(); ++i)
+    {
+        migrate_bucket_(old_buckets_[migrated_bucket_count_]);
+        if (++migrated_bucket_count_ == old_buckets_.size())
+            finish_rehash_();
+    }
+    if (static_cast<float>(size_ + 1) > max_load_factor_ * static_cast<float>(buckets_.size()))
+    {
+        finish_rehash_();
+        start_rehash_(buckets_.size() * 2);
+    }
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+void sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::start_rehash_(
+    size_type bucket_count)
+{
+    bucket_vector_type new_buckets(bucket_count);
+    old_buckets_ = std::exchange(buckets_, std::move(new_buckets));
+    migrated_bucket_count_ = 0;
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+void sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::migrate_bucket_(
+    value_link_type& bucket) noexcept
+{
+    while (link_traits_type::address(bucket))
+    {
+        value_link_type node_link = std::exchange(bucket, nullptr);
+        pointer node = link_traits_type::address(node_link);
+        bucket = std::exchange(node->bucket_next(), nullptr);
+        value_link_type& new_bucket = buckets_[bucket_index_(node->hash_code(), buckets_.size())];
+        node->bucket_next() = std::exchange(new_bucket, nullptr);
+        new_bucket = std::move(node_link);
+    }
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+void sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::finish_rehash_() noexcept
+{
+    for (; migrated_bucket_count_ < old_buckets_.size(); ++migrated_bucket_count_)
+        migrate_bucket_(old_buckets_[migrated_bucket_count_]);
+    old_buckets_ = bucket_vector_type();
+    migrated_bucket_count_ = 0;
+}
+
+template <class IntrusiveT, class KeyOfT, class HashT, class KeyEqualT, LinkPolicy lk_policy>
+void sharable_intrusive_unordered_set<IntrusiveT, KeyOfT, HashT, KeyEqualT, lk_policy>::clear_buckets_(
+    bucket_vector_type& buckets) noexcept
+{
+    for (value_link_type& bucket : buckets)
+    {
+        while (link_traits_type::address(bucket))
+        {
+            value_link_type node_link = std::exchange(bucket, nullptr);
+            bucket = std::exchange(link_traits_type::address(node_link)->bucket_next(), nullptr);
+        }
+    }
+}
+
+} // namespace itru
+} // namespace arba
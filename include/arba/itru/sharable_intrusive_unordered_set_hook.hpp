@@ -0,0 +1,43 @@
+#pragma once
+
+#include "policy/link_policy.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <cstddef>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+template <typename IntrusiveSetNodeT, LinkPolicy lk_policy = shared_link_t>
+class sharable_intrusive_unordered_set_hook
+{
+public:
+    using link_policy_type = lk_policy;
+    using link_traits_type = link_traits<IntrusiveSetNodeT, lk_policy>;
+    using link_type = typename link_traits_type::link_type;
+
+    inline const link_type& bucket_next() const noexcept { return bucket_next_; }
+    inline link_type& bucket_next() noexcept { return bucket_next_; }
+    inline IntrusiveSetNodeT* bucket_next_pointer() const noexcept
+    {
+        return link_traits_type::address(bucket_next_);
+    }
+    inline std::size_t hash_code() const noexcept { return hash_code_; }
+    inline std::size_t& hash_code() noexcept { return hash_code_; }
+
+private:
+    link_type bucket_next_ = nullptr;
+    std::size_t hash_code_ = 0;
+};
+
+template <typename IntrusiveSetNodeT, LinkPolicy lk_policy>
+lk_policy unordered_set_hook_link_policy(const sharable_intrusive_unordered_set_hook<IntrusiveSetNodeT, lk_policy>*);
+
+template <typename IntrusiveT>
+using unordered_set_hook_link_policy_t = decltype(unordered_set_hook_link_policy(std::declval<IntrusiveT*>()));
+
+} // namespace itru
+} // namespace arba
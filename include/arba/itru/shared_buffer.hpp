@@ -0,0 +1,188 @@
+#pragma once
+
+#include "intrusive_ref_counter.hpp"
+#include "shared_bytes_view.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <span>
+#include <utility>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Byte buffer allocated in one block with its counter: its capacity bytes directly follow the object.
+class alignas(std::max_align_t) shared_buffer final : public intrusive_ref_counter<>
+{
+public:
+    [[nodiscard]] static shared_intrusive_ptr<shared_buffer> make(std::size_t capacity)
+    {
+        void* memory = ::operator new(sizeof(shared_buffer) + capacity);
+        return shared_intrusive_ptr<shared_buffer>(new (memory) shared_buffer(capacity));
+    }
+
+    shared_buffer(const shared_buffer&) = delete;
+    shared_buffer& operator=(const shared_buffer&) = delete;
+
+    // Used by shared_intrusive_ptr_release(): the block was allocated by make().
+    inline static void operator delete(void* ptr) noexcept { ::operator delete(ptr); }
+
+    inline std::byte* data() noexcept { return reinterpret_cast<std::byte*>(this + 1); }
+    inline const std::byte* data() const noexcept { return reinterpret_cast<const std::byte*>(this + 1); }
+    inline std::size_t capacity() const noexcept { return capacity_; }
+    inline std::span<const std::byte> bytes() const noexcept { return { data(), capacity_ }; }
+
+private:
+    inline explicit shared_buffer(std::size_t capacity) noexcept : capacity_(capacity) {}
+
+    std::size_t capacity_;
+};
+
+// Read-only view on a range of bytes of a shared_buffer, sharing the ownership of the buffer.
+class buffer_slice : public shared_bytes_view<shared_buffer, buffer_slice>
+{
+public:
+    using shared_bytes_view::shared_bytes_view;
+
+    inline const shared_intrusive_ptr<shared_buffer>& buffer() const noexcept { return owner_ptr_(); }
+
+    // Slice on [offset, offset + size) of this slice.
+    [[nodiscard]] inline buffer_slice subslice(std::size_t offset, std::size_t size) const noexcept
+    {
+        return subrange_(offset, size);
+    }
+    [[nodiscard]] inline buffer_slice subslice(std::size_t offset) const noexcept { return subrange_(offset); }
+};
+
+// Writes the iovec of each non-empty slice in iovecs, in order, until iovecs is full. Returns the number of iovec
+// written, to pass to writev() or sendmsg().
+inline std::size_t gather_iovecs(std::span<const buffer_slice> slices, std::span<::iovec> iovecs) noexcept
+{
+    std::size_t iovec_count = 0;
+    for (const buffer_slice& slice : slices)
+    {
+        if (iovec_count == iovecs.size())
+            break;
+        if (!slice.empty())
+            iovecs[iovec_count++] = slice.to_iovec();
+    }
+    return iovec_count;
+}
+
+// Fills shared_buffers with the bytes received by the I/O calls, then gives them away as buffer_slices.
+// The filled bytes not taken yet are readable(). When the tail of the current buffer is too small, a new buffer is
+// started, in which the bytes not taken yet are copied: only a partial message is copied, never a taken slice.
+// Once all its slices are released, the current buffer is reused instead.
+class buffer_builder
+{
+public:
+    static constexpr std::size_t default_buffer_capacity = 16 * 1024;
+
+    inline explicit buffer_builder(std::size_t buffer_capacity = default_buffer_capacity) noexcept
+        : buffer_capacity_(buffer_capacity)
+    {
+    }
+
+    // Bytes filled but not taken yet.
+    inline std::span<const std::byte> readable() const noexcept
+    {
+        return { buffer_ ? buffer_->data() + taken_size_ : nullptr, filled_size_ - taken_size_ };
+    }
+    inline std::size_t readable_size() const noexcept { return filled_size_ - taken_size_; }
+
+    // Writable tail of the current buffer, of at least min_size bytes.
+    std::span<std::byte> prepare(std::size_t min_size = 1);
+    // Marks size bytes of the span returned by prepare() as filled.
+    inline void commit(std::size_t size) noexcept
+    {
+        assert(buffer_ && filled_size_ + size <= buffer_->capacity());
+        filled_size_ += size;
+    }
+
+    // Takes the size first readable bytes.
+    [[nodiscard]] inline buffer_slice take(std::size_t size) noexcept
+    {
+        assert(size <= readable_size());
+        buffer_slice slice(buffer_, taken_size_, size);
+        taken_size_ += size;
+        return slice;
+    }
+    [[nodiscard]] inline buffer_slice take_all() noexcept { return take(readable_size()); }
+    inline void skip(std::size_t size) noexcept
+    {
+        assert(size <= readable_size());
+        taken_size_ += size;
+    }
+
+    // Calls read() or recv() once to fill the writable tail. Returns what the call returns: the number of bytes
+    // received, 0 at the end of the stream, or -1 with errno set.
+    ::ssize_t read_some(int fd);
+    ::ssize_t recv_some(int socket, int flags = 0);
+
+private:
+    template <class IoFunctionT>
+    ::ssize_t fill_(IoFunctionT&& io_function);
+
+    std::size_t buffer_capacity_;
+    shared_intrusive_ptr<shared_buffer> buffer_;
+    std::size_t taken_size_ = 0;
+    std::size_t filled_size_ = 0;
+};
+
+inline std::span<std::byte> buffer_builder::prepare(std::size_t min_size)
+{
+    const std::size_t readable_size = this->readable_size();
+    if (buffer_ && buffer_->capacity() - filled_size_ < min_size && buffer_->capacity() - readable_size >= min_size
+        && shared_intrusive_ptr_is_unique(buffer_.get()))
+    {
+        // No slice shares the buffer anymore: the readable bytes are moved to its front.
+        std::memmove(buffer_->data(), buffer_->data() + taken_size_, readable_size);
+        taken_size_ = 0;
+        filled_size_ = readable_size;
+    }
+    else if (!buffer_ || buffer_->capacity() - filled_size_ < min_size)
+    {
+        shared_intrusive_ptr<shared_buffer> new_buffer =
+            shared_buffer::make(std::max(buffer_capacity_, readable_size + min_size));
+        if (readable_size > 0)
+            std::memcpy(new_buffer->data(), buffer_->data() + taken_size_, readable_size);
+        buffer_ = std::move(new_buffer);
+        taken_size_ = 0;
+        filled_size_ = readable_size;
+    }
+    return { buffer_->data() + filled_size_, buffer_->capacity() - filled_size_ };
+}
+
+template <class IoFunctionT>
+::ssize_t buffer_builder::fill_(IoFunctionT&& io_function)
+{
+    std::span<std::byte> tail = prepare();
+    const ::ssize_t received_size = io_function(tail.data(), tail.size());
+    if (received_size > 0)
+        commit(static_cast<std::size_t>(received_size));
+    return received_size;
+}
+
+inline ::ssize_t buffer_builder::read_some(int fd)
+{
+    return fill_([fd](std::byte* data, std::size_t size) { return ::read(fd, data, size); });
+}
+
+inline ::ssize_t buffer_builder::recv_some(int socket, int flags)
+{
+    return fill_([socket, flags](std::byte* data, std::size_t size) { return ::recv(socket, data, size, flags); });
+}
+
+} // namespace itru
+} // namespace arba
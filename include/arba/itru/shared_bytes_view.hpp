@@ -0,0 +1,92 @@
+#pragma once
+
+#include "shared_intrusive_ptr.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+#include <sys/uio.h>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Read-only view on a range of the bytes() of an OwnerT, sharing the ownership of the owner. Copying, slicing and
+// splitting a view never copy bytes. ViewT is the derived view class, returned by the slicing functions.
+template <class OwnerT, class ViewT>
+class shared_bytes_view
+{
+public:
+    using owner_type = OwnerT;
+
+    shared_bytes_view() = default;
+    // View on all the bytes of owner.
+    inline explicit shared_bytes_view(shared_intrusive_ptr<OwnerT> owner) noexcept
+        : size_(owner ? owner->bytes().size() : 0), owner_(std::move(owner))
+    {
+    }
+    inline shared_bytes_view(shared_intrusive_ptr<OwnerT> owner, std::size_t offset, std::size_t size) noexcept
+        : offset_(offset), size_(size), owner_(std::move(owner))
+    {
+        assert(owner_ ? offset_ + size_ <= owner_->bytes().size() : size_ == 0);
+    }
+
+    inline const std::byte* data() const noexcept { return owner_ ? owner_->bytes().data() + offset_ : nullptr; }
+    inline std::size_t size() const noexcept { return size_; }
+    inline bool empty() const noexcept { return size_ == 0; }
+    inline std::span<const std::byte> bytes() const noexcept { return { data(), size_ }; }
+    inline const std::byte& operator[](std::size_t index) const noexcept
+    {
+        assert(index < size_);
+        return data()[index];
+    }
+
+    // Removes the first size bytes of this view, and returns them as a view.
+    [[nodiscard]] inline ViewT split_front(std::size_t size) noexcept
+    {
+        assert(size <= size_);
+        ViewT front(owner_, offset_, size);
+        offset_ += size;
+        size_ -= size;
+        return front;
+    }
+    inline void remove_prefix(std::size_t size) noexcept
+    {
+        assert(size <= size_);
+        offset_ += size;
+        size_ -= size;
+    }
+    inline void remove_suffix(std::size_t size) noexcept
+    {
+        assert(size <= size_);
+        size_ -= size;
+    }
+
+    inline ::iovec to_iovec() const noexcept { return { const_cast<std::byte*>(data()), size_ }; }
+
+protected:
+    inline const shared_intrusive_ptr<OwnerT>& owner_ptr_() const noexcept { return owner_; }
+
+    // View on [offset, offset + size) of this view.
+    inline ViewT subrange_(std::size_t offset, std::size_t size) const noexcept
+    {
+        assert(offset + size <= size_);
+        return ViewT(owner_, offset_ + offset, size);
+    }
+    inline ViewT subrange_(std::size_t offset) const noexcept
+    {
+        assert(offset <= size_);
+        return subrange_(offset, size_ - offset);
+    }
+
+private:
+    std::size_t offset_ = 0;
+    std::size_t size_ = 0;
+    shared_intrusive_ptr<OwnerT> owner_;
+};
+
+} // namespace itru
+} // namespace arba
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
 #include <functional>
 
 inline namespace arba
@@ -60,6 +61,15 @@ public:
     {
     };
 
+    // Takes a use reference on ptr, kept allocated by a weak reference, unless it has expired (see
+    // weak_intrusive_ptr_lock()). Returns nullptr if it has expired. Used by the containers of weak references.
+    [[nodiscard]] static shared_intrusive_ptr try_lock_from(element_type* ptr) noexcept
+    {
+        if (weak_intrusive_ptr_lock(ptr))
+            return shared_intrusive_ptr(ptr, lock_tag{});
+        return shared_intrusive_ptr();
+    }
+
 private:
     shared_intrusive_ptr(element_type* ptr, lock_tag);
 
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// POSIX shared memory object (shm_open) mapped in the address space of the process, and shared with the other
+// processes which map it. It may be mapped at a different address in each process: the data it holds must not contain
+// absolute pointers (see offset_shared_intrusive_ptr), nor virtual functions.
+// The memory is allocated by blocks of 32 << n bytes, recycled through one free list per size, under a spin lock held
+// in the segment. A process dying while it allocates or deallocates leaves the segment locked.
+class shared_segment
+{
+public:
+    static constexpr std::size_t block_alignment = 16;
+
+    // Creates and maps the shared memory object name, of size bytes. Fails if it already exists.
+    static shared_segment create(const std::string& name, std::size_t size);
+    // Maps the existing shared memory object name, created by create().
+    static shared_segment open(const std::string& name);
+    // Removes the name of the shared memory object: it is destroyed once no process maps it anymore.
+    inline static bool remove(const std::string& name) noexcept { return ::shm_unlink(name.c_str()) == 0; }
+
+    shared_segment(shared_segment&& other) noexcept
+        : base_(std::exchange(other.base_, nullptr)), size_(std::exchange(other.size_, 0))
+    {
+    }
+    inline shared_segment& operator=(shared_segment&& other) noexcept
+    {
+        std::swap(base_, other.base_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+    inline ~shared_segment()
+    {
+        if (base_)
+            ::munmap(base_, size_);
+    }
+
+    inline std::byte* base() const noexcept { return base_; }
+    inline std::size_t size() const noexcept { return size_; }
+    // Number of bytes taken from the segment so far, free blocks included.
+    inline std::size_t used_size() const noexcept { return header_().bump_offset.load(); }
+    inline bool contains(const void* ptr) const noexcept
+    {
+        return static_cast<const std::byte*>(ptr) >= base_ && static_cast<const std::byte*>(ptr) < base_ + size_;
+    }
+
+    // Returns memory aligned on block_alignment, or throws std::bad_alloc if the segment is full.
+    void* allocate(std::size_t size);
+    // Deallocates memory returned by allocate(), whichever segment object or process allocated it.
+    static void deallocate(void* ptr) noexcept;
+
+    // Entry point of the data shared in the segment, as an untyped pointer in the segment, or nullptr.
+    inline void* root() const noexcept { return pointer_of_(header_().root_offset.load()); }
+    inline void* exchange_root(void* root) noexcept
+    {
+        return pointer_of_(header_().root_offset.exchange(offset_of_(root)));
+    }
+
+private:
+    static constexpr std::uint64_t magic_number = 0x6974'7275'7365'676dULL;
+    static constexpr unsigned size_class_count = 48;
+
+    struct alignas(64) header
+    {
+        std::uint64_t magic;
+        std::uint64_t size;
+        std::atomic<std::uint64_t> bump_offset;
+        std::atomic<std::uint64_t> root_offset;
+        std::atomic<std::uint32_t> locked;
+        // Offset of the first free block of each size class, 0 if none. A free block stores the offset of the next
+        // one in its payload.
+        std::uint64_t free_lists[size_class_count];
+    };
+
+    // Written before the memory returned by allocate().
+    struct block_header
+    {
+        // Offset of the segment header, relative to the block: valid in every mapping.
+        std::int64_t header_offset;
+        std::uint32_t size_class;
+        std::uint32_t reserved;
+    };
+
+    static_assert(sizeof(block_header) == block_alignment);
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+                  "The atomics shared between processes must be lock-free.");
+
+    class segment_lock
+    {
+    public:
+        explicit segment_lock(header& locked_header) : header_(locked_header)
+        {
+            while (header_.locked.exchange(1, std::memory_order_acquire))
+                std::this_thread::yield();
+        }
+        segment_lock(const segment_lock&) = delete;
+        segment_lock& operator=(const segment_lock&) = delete;
+        ~segment_lock() { header_.locked.store(0, std::memory_order_release); }
+
+    private:
+        header& header_;
+    };
+
+    inline shared_segment(std::byte* base, std::size_t size) noexcept : base_(base), size_(size) {}
+
+    static std::byte* map_(int fd, std::size_t size);
+    inline header& header_() const noexcept { return *std::launder(reinterpret_cast<header*>(base_)); }
+    inline static std::size_t block_size_(unsigned size_class) noexcept { return std::size_t(32) << size_class; }
+    inline void* pointer_of_(std::uint64_t offset) const noexcept { return offset ? base_ + offset : nullptr; }
+    inline std::uint64_t offset_of_(const void* ptr) const noexcept
+    {
+        return ptr ? static_cast<std::uint64_t>(static_cast<const std::byte*>(ptr) - base_) : 0;
+    }
+
+    std::byte* base_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+inline shared_segment shared_segment::create(const std::string& name, std::size_t size)
+{
+    if (size < sizeof(header) + block_size_(0))
+        throw std::invalid_argument("shared_segment: size too small.");
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), "shared_segment: shm_open failed.");
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        const int error = errno;
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        throw std::system_error(error, std::generic_category(), "shared_segment: ftruncate failed.");
+    }
+    std::byte* base = nullptr;
+    try
+    {
+        base = map_(fd, size);
+    }
+    catch (...)
+    {
+        ::shm_unlink(name.c_str());
+        throw;
+    }
+    header* segment_header = new (base) header{};
+    segment_header->size = size;
+    segment_header->bump_offset.store(sizeof(header));
+    // Published last: open() checks it.
+    std::atomic_ref(segment_header->magic).store(magic_number);
+    return shared_segment(base, size);
+}
+
+inline shared_segment shared_segment::open(const std::string& name)
+{
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), "shared_segment: shm_open failed.");
+    struct stat status;
+    if (::fstat(fd, &status) != 0)
+    {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "shared_segment: fstat failed.");
+    }
+    const std::size_t size = static_cast<std::size_t>(status.st_size);
+    if (size < sizeof(header))
+    {
+        ::close(fd);
+        throw std::runtime_error("shared_segment: not a segment.");
+    }
+    shared_segment segment(map_(fd, size), size);
+    header& segment_header = segment.header_();
+    if (std::atomic_ref(segment_header.magic).load() != magic_number || segment_header.size != size)
+        throw std::runtime_error("shared_segment: not a segment.");
+    return segment;
+}
+
+inline std::byte* shared_segment::map_(int fd, std::size_t size)
+{
+    void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    // The mapping stays valid once the descriptor is closed.
+    ::close(fd);
+    if (base == MAP_FAILED)
+        throw std::system_error(error, std::generic_category(), "shared_segment: mmap failed.");
+    return static_cast<std::byte*>(base);
+}
+
+inline void* shared_segment::allocate(std::size_t size)
+{
+    const std::size_t needed_size = size + sizeof(block_header);
+    const unsigned size_class = needed_size <= block_size_(0) ? 0 : std::bit_width((needed_size - 1) >> 5);
+    if (size_class >= size_class_count)
+        throw std::bad_alloc();
+
+    header& segment_header = header_();
+    std::uint64_t block_offset = 0;
+    {
+        segment_lock lock(segment_header);
+        if (std::uint64_t& free_offset = segment_header.free_lists[size_class]; free_offset)
+        {
+            block_offset = free_offset;
+            free_offset = *reinterpret_cast<std::uint64_t*>(base_ + block_offset + sizeof(block_header));
+        }
+        else
+        {
+            block_offset = segment_header.bump_offset.load();
+            if (block_size_(size_class) > size_ - block_offset)
+                throw std::bad_alloc();
+            segment_header.bump_offset.store(block_offset + block_size_(size_class));
+        }
+    }
+    std::byte* block = base_ + block_offset;
+    new (block) block_header{ -static_cast<std::int64_t>(block_offset), size_class, 0 };
+    return block + sizeof(block_header);
+}
+
+inline void shared_segment::deallocate(void* ptr) noexcept
+{
+    if (!ptr)
+        return;
+    std::byte* block = static_cast<std::byte*>(ptr) - sizeof(block_header);
+    const block_header& info = *std::launder(reinterpret_cast<block_header*>(block));
+    std::byte* base = block + info.header_offset;
+    header& segment_header = *std::launder(reinterpret_cast<header*>(base));
+    segment_lock lock(segment_header);
+    std::uint64_t& free_offset = segment_header.free_lists[info.size_class];
+    *static_cast<std::uint64_t*>(ptr) = free_offset;
+    free_offset = static_cast<std::uint64_t>(block - base);
+}
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "epoch_reclaimer.hpp"
+#include "shared_intrusive_ptr.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Read-mostly cell holding the current version of a value (a configuration snapshot, for example).
+// read() returns a guard giving access to the current version without touching its counter: the guard is an
+// epoch_guard, and a replaced version is retired to the epoch_reclaimer, which releases the reference of the cell
+// once no guard can see it anymore. A reader needing the version beyond the lifetime of its guard calls share().
+template <typename ElementType>
+class snapshot_cell
+{
+public:
+    using element_type = ElementType;
+    using value_siptr_type = shared_intrusive_ptr<element_type>;
+
+    class read_guard
+    {
+    public:
+        read_guard(const read_guard&) = delete;
+        read_guard& operator=(const read_guard&) = delete;
+
+        inline const element_type* get() const noexcept { return pointer_; }
+        inline const element_type& operator*() const noexcept
+        {
+            assert(pointer_);
+            return *pointer_;
+        }
+        inline const element_type* operator->() const noexcept
+        {
+            assert(pointer_);
+            return pointer_;
+        }
+        inline operator bool() const { return pointer_ != nullptr; }
+
+        // The version is still referenced by the cell, or not reclaimed yet: its use count cannot be zero.
+        inline value_siptr_type share() const { return value_siptr_type(pointer_); }
+
+    private:
+        inline explicit read_guard(const snapshot_cell& cell) : pointer_(cell.current_.load())
+        {
+        }
+
+        epoch_guard guard_;
+        element_type* pointer_;
+
+        friend class snapshot_cell;
+    };
+
+    snapshot_cell() = default;
+    explicit snapshot_cell(value_siptr_type value) { publish(std::move(value)); }
+    snapshot_cell(const snapshot_cell&) = delete;
+    snapshot_cell& operator=(const snapshot_cell&) = delete;
+    // Must not run concurrently with any other operation on the cell.
+    inline ~snapshot_cell()
+    {
+        if (element_type* current = current_.load())
+            shared_intrusive_ptr_release(current);
+    }
+
+    [[nodiscard]] inline read_guard read() const { return read_guard(*this); }
+    [[nodiscard]] inline value_siptr_type load() const { return read().share(); }
+
+    // Replaces the current version. The previous one is released once no read_guard can see it anymore.
+    void publish(value_siptr_type value)
+    {
+        element_type* element = value.get();
+        if (element)
+            shared_intrusive_ptr_add_ref(element);
+        if (element_type* previous = current_.exchange(element))
+            epoch_reclaimer::retire_shared(previous);
+    }
+
+private:
+    std::atomic<element_type*> current_ = nullptr;
+};
+
+} // namespace itru
+} // namespace arba
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "sharable_intrusive_list.hpp"
+#include "timer_wheel_hook.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Hierarchical timer wheel: level l has 2^slot_bits slots of 2^(slot_bits * l) ticks each. The slots are
+// sharable_intrusive_lists threaded through the timer_wheel_hook of the timers, hence arming, re-arming and
+// cancelling a timer are O(1) and allocate nothing. Timers further than the last level are parked in it and
+// cascaded again until they come in range.
+// Each slot has its own sentinel: SentinelT should be light when IntrusiveT is not.
+template <typename IntrusiveT, typename SentinelT = IntrusiveT, unsigned level_count = 4, unsigned slot_bits = 6>
+class timer_wheel
+{
+    static_assert(level_count > 0 && slot_bits > 0 && slot_bits * level_count < 64);
+
+public:
+    using value_type = IntrusiveT;
+    using size_type = std::size_t;
+    using tick_type = std::uint64_t;
+    using reference = std::add_lvalue_reference_t<value_type>;
+    using const_reference = std::add_lvalue_reference_t<std::add_const_t<value_type>>;
+    using pointer = std::add_pointer_t<value_type>;
+    using value_siptr_type = shared_intrusive_ptr<value_type>;
+    using timer_list_type =
+        sharable_intrusive_list<IntrusiveT, SentinelT, base_list_hook_accessor<IntrusiveT, timer_hook_tag>>;
+
+    static constexpr size_type slot_count = size_type(1) << slot_bits;
+    static constexpr tick_type max_delay = (tick_type(1) << (slot_bits * level_count)) - 1;
+
+public:
+    explicit timer_wheel(tick_type now = 0) : now_(now) {}
+
+    inline tick_type now() const noexcept { return now_; }
+    inline bool empty() const noexcept { return size_ == 0; }
+    inline size_type size() const noexcept { return size_; }
+
+    // A timer is armed from the moment it is armed until it is cancelled or expires.
+    inline bool is_armed(const_reference value) const noexcept
+    {
+        return value.timer_expiry() > now_ && hook_(value).previous() != nullptr;
+    }
+
+    // Arms a timer which is not linked in this wheel, nor in a list of expired timers. A timer already expired
+    // expires at the next advance().
+    void arm(value_siptr_type value, tick_type expiry);
+    // Moves an armed timer to its new expiry, without touching its counter. Returns false if the timer was not armed.
+    bool rearm(reference value, tick_type expiry);
+    // Returns false if the timer was not armed.
+    bool cancel(reference value);
+
+    // Moves the timers expired at the given time to the back of the expired list, slot by slot.
+    void advance(tick_type now, timer_list_type& expired);
+    inline timer_list_type advance(tick_type now)
+    {
+        timer_list_type expired;
+        advance(now, expired);
+        return expired;
+    }
+
+    void clear();
+
+private:
+    inline static const auto& hook_(const_reference value) noexcept
+    {
+        return base_list_hook_accessor<IntrusiveT, timer_hook_tag>::hook(value);
+    }
+    inline static typename timer_list_type::iterator iterator_(reference value) noexcept
+    {
+        return typename timer_list_type::iterator(value);
+    }
+
+    std::uint32_t slot_index_(tick_type expiry) const noexcept;
+    void cascade_(std::uint32_t slot_index);
+
+private:
+    std::array<timer_list_type, level_count * slot_count> slots_;
+    tick_type now_;
+    size_type size_ = 0;
+};
+
+template <typename IntrusiveT, typename SentinelT, unsigned level_count, unsigned slot_bits>
+void timer_wheel<IntrusiveT, SentinelT, level_count, slot_bits>::arm(value_siptr_type value, tick_type expiry)
+{
+    value->timer_expiry() = std::max(expiry, now_ + 1);
+    const std::uint32_t slot_index = slot_index_(value->timer_expiry());
+    value->timer_slot() = slot_index;
+    slots_[slot_index].push_back(std::move(value));
+    ++size_;
+}
+
+template <typename IntrusiveT, typename SentinelT, unsigned level_count, unsigned slot_bits>
+bool timer_wheel<IntrusiveT, SentinelT, level_count, slot_bits>::rearm(reference value, tick_type expiry)
+{
+    if (!is_armed(value))
+        return false;
+    timer_list_type& old_slot = slots_[value.timer_slot()];
+    value.timer_expiry() = std::max(expiry, now_ + 1);
+    const std::uint32_t slot_index = slot_index_(value.timer_expiry());
+    value.timer_slot() = slot_index;
+    auto iter = iterator_(value);
+    slots_[slot_index].splice(slots_[slot_index].end(), old_slot, iter, std::next(iter));
+    return true;
+}
+
+template <typename IntrusiveT, typename SentinelT, unsigned level_count, unsigned slot_bits>
+bool timer_wheel<IntrusiveT, SentinelT, level_count, slot_bits>::cancel(reference value)
+{
+    if (!is_armed(value))
+        return false;
+    slots_[value.timer_slot()].erase(iterator_(value));
+    --size_;
+    return true;
+}
+
+template <typename IntrusiveT, typename SentinelT, unsigned level_count, unsigned slot_bits>
+void timer_wheel<IntrusiveT, SentinelT, level_count, slot_bits>::advance(tick_type now, timer_list_type& expired)
+{
+    for (; now_ < now && size_ > 0;)
+    {
+        const tick_type tick = ++now_;
+        // The higher levels are cascaded first, since they may refill the slots of the lower ones.
+        for (unsigned level = level_count - 1; level > 0; --level)
+        {
+            const unsigned shift = slot_bits * level;
+            if ((tick & ((tick_type(1) << shift) - 1)) == 0)
+                cascade_(level * slot_count + ((tick >> shift) & (slot_count - 1)));
+        }
+        timer_list_type& slot = slots_[tick & (slot_count - 1)];
+        size_ -= slot.size();
+        expired.splice(expired.end(), slot);
+    }
+    if (now_ < now)
+        now_ = now;
+}
+
+template <typename IntrusiveT, typename SentinelT, unsigned level_count, unsigned slot_bits>
+void timer_wheel<IntrusiveT, SentinelT, level_count, slot_bits>::clear()
+{
+    for (timer_list_type& slot : slots_)
+        slot.clear();
+    size_ = 0;
+}
+
+template <typename IntrusiveT, typename SentinelT, unsigned level_count, unsigned slot_bits>
+std::uint32_t timer_wheel<IntrusiveT, SentinelT, level_count, slot_bits>::slot_index_(tick_type expiry) const noexcept
+{
+    const tick_type delay = std::min(expiry - now_, max_delay);
+    const tick_type slot_expiry = now_ + delay;
+    unsigned level = 0;
+    while (level + 1 < level_count && delay >= (tick_type(1) << (slot_bits * (level + 1))))
+        ++level;
+    return static_cast<std::uint32_t>(level * slot_count + ((slot_expiry >> (slot_bits * level)) & (slot_count - 1)));
+}
+
+template <typename IntrusiveT, typename SentinelT, unsigned level_count, unsigned slot_bits>
+void timer_wheel<IntrusiveT, SentinelT, level_count, slot_bits>::cascade_(std::uint32_t slot_index)
+{
+    timer_list_type& slot = slots_[slot_index];
+    while (!slot.empty())
+    {
+        auto iter = slot.begin();
+        const std::uint32_t new_slot_index = slot_index_(iter->timer_expiry());
+        iter->timer_slot() = new_slot_index;
+        slots_[new_slot_index].splice(slots_[new_slot_index].end(), slot, iter, std::next(iter));
+    }
+}
+
+} // namespace itru
+} // namespace arba
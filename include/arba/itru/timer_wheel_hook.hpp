@@ -0,0 +1,35 @@
+#pragma once
+
+#include "sharable_intrusive_list_hook.hpp"
+
+#include <cstdint>
+
+inline namespace arba
+{
+namespace itru
+{
+
+struct timer_hook_tag
+{
+};
+
+// A timer of timer_wheel is linked in a slot of the wheel, then in the list of expired timers, through the same
+// tagged list hook.
+template <typename IntrusiveTimerNodeT>
+class timer_wheel_hook : public sharable_intrusive_list_hook<IntrusiveTimerNodeT, shared_link_t, timer_hook_tag>
+{
+public:
+    using tick_type = std::uint64_t;
+
+    inline tick_type timer_expiry() const noexcept { return timer_expiry_; }
+    inline tick_type& timer_expiry() noexcept { return timer_expiry_; }
+    inline std::uint32_t timer_slot() const noexcept { return timer_slot_; }
+    inline std::uint32_t& timer_slot() noexcept { return timer_slot_; }
+
+private:
+    tick_type timer_expiry_ = 0;
+    std::uint32_t timer_slot_ = 0;
+};
+
+} // namespace itru
+} // namespace arba
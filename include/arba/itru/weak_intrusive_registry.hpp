@@ -0,0 +1,207 @@
+#pragma once
+
+#include "shared_intrusive_ptr.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+inline namespace arba
+{
+namespace itru
+{
+
+// Registry of weak references (an observer list, for example) stored as a contiguous array of pointers, each one
+// holding a latent reference on its element. Expired entries are not removed one by one: they are compacted in
+// batches, when the number of entries reaches twice the number of live entries found by the previous compaction,
+// which amortises the compactions over the insertions.
+// Iterating the registry hands out locked shared_intrusive_ptr, skipping the expired entries.
+template <typename ElementType>
+class weak_intrusive_registry
+{
+public:
+    using element_type = ElementType;
+    using size_type = std::size_t;
+    using value_siptr_type = shared_intrusive_ptr<element_type>;
+
+    static constexpr size_type min_compaction_threshold = 16;
+
+    class iterator
+    {
+    public:
+        using value_type = value_siptr_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = const value_siptr_type&;
+        using pointer = const value_siptr_type*;
+        using iterator_category = std::input_iterator_tag;
+
+        iterator() = default;
+
+        inline reference operator*() const noexcept { return locked_; }
+        inline pointer operator->() const noexcept { return &locked_; }
+        iterator& operator++() noexcept
+        {
+            ++current_;
+            lock_current_();
+            return *this;
+        }
+        inline void operator++(int) noexcept { ++(*this); }
+        inline bool operator==(const iterator& iter) const noexcept { return current_ == iter.current_; }
+
+    private:
+        inline iterator(element_type* const* current, element_type* const* end) : current_(current), end_(end)
+        {
+            lock_current_();
+        }
+
+        void lock_current_() noexcept
+        {
+            locked_ = nullptr;
+            for (; current_ != end_; ++current_)
+            {
+                if ((locked_ = value_siptr_type::try_lock_from(*current_)))
+                    return;
+            }
+        }
+
+        element_type* const* current_ = nullptr;
+        element_type* const* end_ = nullptr;
+        value_siptr_type locked_;
+
+        friend class weak_intrusive_registry;
+    };
+
+    weak_intrusive_registry() = default;
+    weak_intrusive_registry(const weak_intrusive_registry& other)
+        : elements_(other.elements_), compaction_threshold_(other.compaction_threshold_)
+    {
+        for (element_type* element : elements_)
+            weak_intrusive_ptr_add_ref(element);
+    }
+    inline weak_intrusive_registry(weak_intrusive_registry&& other) noexcept { swap(other); }
+    inline weak_intrusive_registry& operator=(weak_intrusive_registry other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+    inline ~weak_intrusive_registry() { clear(); }
+
+    // Number of entries, the expired ones not compacted yet included.
+    [[nodiscard]] inline size_type size() const noexcept { return elements_.size(); }
+    [[nodiscard]] inline bool empty() const noexcept { return elements_.empty(); }
+
+    inline iterator begin() const noexcept { return iterator(elements_.data(), elements_.data() + elements_.size()); }
+    inline iterator end() const noexcept
+    {
+        element_type* const* end_ptr = elements_.data() + elements_.size();
+        return iterator(end_ptr, end_ptr);
+    }
+
+    template <typename Up>
+        requires std::is_convertible_v<std::add_pointer_t<Up>, std::add_pointer_t<element_type>>
+    void insert(const shared_intrusive_ptr<Up>& siptr)
+    {
+        assert(siptr);
+        if (elements_.size() >= compaction_threshold_)
+            compact();
+        element_type* element = siptr.get();
+        elements_.push_back(element);
+        weak_intrusive_ptr_add_ref(element);
+    }
+
+    // Removes the first entry referring to element. The order of the other entries is kept.
+    bool erase(const element_type* element);
+
+    // Calls function with a locked shared_intrusive_ptr on each live entry, then compacts the registry if at least
+    // half of its entries were found expired. function must not modify the registry.
+    template <class FunctionT>
+    void for_each(FunctionT function);
+
+    // Removes every expired entry. Returns the number of removed entries.
+    size_type compact();
+    void clear() noexcept;
+
+    inline void swap(weak_intrusive_registry& other) noexcept
+    {
+        elements_.swap(other.elements_);
+        alive_flags_.swap(other.alive_flags_);
+        std::swap(compaction_threshold_, other.compaction_threshold_);
+    }
+
+private:
+    std::vector<element_type*> elements_;
+    // Scratch buffer of compact(), kept to avoid an allocation per compaction.
+    std::vector<std::uint8_t> alive_flags_;
+    size_type compaction_threshold_ = min_compaction_threshold;
+};
+
+template <typename ElementType>
+bool weak_intrusive_registry<ElementType>::erase(const element_type* element)
+{
+    auto iter = std::find(elements_.begin(), elements_.end(), element);
+    if (iter == elements_.end())
+        return false;
+    element_type* erased_element = *iter;
+    elements_.erase(iter);
+    weak_intrusive_ptr_release(erased_element);
+    return true;
+}
+
+template <typename ElementType>
+template <class FunctionT>
+void weak_intrusive_registry<ElementType>::for_each(FunctionT function)
+{
+    size_type expired_count = 0;
+    for (element_type* element : elements_)
+    {
+        if (value_siptr_type value = value_siptr_type::try_lock_from(element))
+            function(std::move(value));
+        else
+            ++expired_count;
+    }
+    if (expired_count > 0 && expired_count * 2 >= elements_.size())
+        compact();
+}
+
+template <typename ElementType>
+typename weak_intrusive_registry<ElementType>::size_type weak_intrusive_registry<ElementType>::compact()
+{
+    const size_type count = elements_.size();
+    alive_flags_.resize(count);
+    // First pass: the use counters are only read, without any branch nor atomic read-modify-write, hence the loads
+    // are independent from each other and their cache misses overlap. An expired element never comes back to life.
+    element_type* const* elements = elements_.data();
+    std::uint8_t* alive_flags = alive_flags_.data();
+    for (size_type i = 0; i < count; ++i)
+        alive_flags[i] = weak_intrusive_ptr_use_count(elements[i]) != 0;
+    // Second pass: stable compaction of the live entries.
+    size_type kept_count = 0;
+    for (size_type i = 0; i < count; ++i)
+    {
+        element_type* element = elements_[i];
+        if (alive_flags[i])
+            elements_[kept_count++] = element;
+        else
+            weak_intrusive_ptr_release(element);
+    }
+    elements_.resize(kept_count);
+    compaction_threshold_ = std::max(min_compaction_threshold, kept_count * 2);
+    return count - kept_count;
+}
+
+template <typename ElementType>
+void weak_intrusive_registry<ElementType>::clear() noexcept
+{
+    for (element_type* element : elements_)
+        weak_intrusive_ptr_release(element);
+    elements_.clear();
+    compaction_threshold_ = min_compaction_threshold;
+}
+
+} // namespace itru
+} // namespace arba
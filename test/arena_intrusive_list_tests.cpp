@@ -0,0 +1,173 @@
+#include "data_silist_node.hpp"
+#include <arba/itru/arena_intrusive_list.hpp>
+#include <arba/itru/weak_intrusive_ptr.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_arena_list = itru::arena_intrusive_list<data_arena_silist_node>;
+
+std::vector<std::string> list_texts(const data_arena_list& list)
+{
+    std::vector<std::string> texts;
+    for (const data_arena_silist_node& node : list)
+        texts.push_back(node.text);
+    return texts;
+}
+
+bool in_traversal_order(const data_arena_list& list)
+{
+    const std::byte* previous = nullptr;
+    for (const data_arena_silist_node& node : list)
+    {
+        const std::byte* address = reinterpret_cast<const std::byte*>(&node);
+        if (previous && address <= previous)
+            return false;
+        previous = address;
+    }
+    return true;
+}
+} // namespace
+
+TEST(arena_intrusive_list_tests, emplace_back__many_nodes__allocated_by_arena)
+{
+    constexpr int count = 200;
+    std::unique_ptr<bool[]> valids(new bool[count]);
+    {
+        data_arena_list list;
+        for (int i = 0; i < count; ++i)
+            list.emplace_back(valids[i], std::to_string(i));
+        ASSERT_EQ(list.size(), count);
+        ASSERT_EQ(list.arena().node_count(), count);
+        ASSERT_LE(list.arena().block_count(), 3);
+        ASSERT_TRUE(in_traversal_order(list));
+
+        list.pop_front();
+        ASSERT_FALSE(valids[0]);
+        ASSERT_EQ(list.arena().node_count(), count - 1);
+        // The freed slot is reused.
+        list.emplace_front(valids[0], "0");
+        ASSERT_EQ(list.arena().node_count(), count);
+    }
+    for (int i = 0; i < count; ++i)
+        ASSERT_FALSE(valids[i]);
+}
+
+TEST(arena_intrusive_list_tests, destructor__node_shared_outside__node_outlives_list)
+{
+    bool valid_1 = false;
+    bool valid_2 = false;
+    itru::shared_intrusive_ptr<data_arena_silist_node> kept;
+    {
+        data_arena_list list;
+        list.emplace_back(valid_1, "1");
+        list.emplace_back(valid_2, "2");
+        kept = itru::shared_intrusive_ptr<data_arena_silist_node>(&list.back());
+    }
+    ASSERT_FALSE(valid_1);
+    ASSERT_TRUE(valid_2);
+    ASSERT_EQ(kept->text, "2");
+    kept = nullptr;
+    ASSERT_FALSE(valid_2);
+}
+
+TEST(arena_intrusive_list_tests, compact__churned_list__relocated_in_traversal_order)
+{
+    constexpr int count = 300;
+    std::unique_ptr<bool[]> valids(new bool[count]);
+    data_arena_list list;
+    for (int i = 0; i < count; ++i)
+        list.emplace_back(valids[i], std::to_string(i));
+    // Churn: every other node is erased, then the survivors are moved to the front in reverse order.
+    list.remove_if([](const data_arena_silist_node& node) { return std::stoi(node.text) % 2 == 0; });
+    list.reverse();
+    ASSERT_FALSE(in_traversal_order(list));
+    const std::vector<std::string> texts = list_texts(list);
+
+    itru::shared_intrusive_ptr<data_arena_silist_node> pinned = std::next(list.begin(), 10).make_intrusive_shared();
+    const data_arena_silist_node* pinned_address = pinned.get();
+
+    ASSERT_EQ(list.compact(), count / 2 - 1);
+    ASSERT_EQ(list_texts(list), texts);
+    ASSERT_EQ(&*std::next(list.begin(), 10), pinned_address);
+    ASSERT_EQ(list.arena().node_count(), count / 2);
+    for (int i = 0; i < count; ++i)
+        ASSERT_EQ(valids[i], i % 2 == 1) << i;
+
+    pinned = nullptr;
+    list.erase(std::next(list.begin(), 10));
+    ASSERT_TRUE(in_traversal_order(list));
+    // The block of the pinned node is released by the next compaction.
+    ASSERT_EQ(list.compact(), count / 2 - 1);
+    ASSERT_EQ(list.arena().block_count(), 1);
+}
+
+TEST(arena_intrusive_list_tests, compact__defaulted_move_constructor__links_kept)
+{
+    itru::arena_intrusive_list<data_arena_plain_silist_node> list;
+    for (int i = 0; i < 8; ++i)
+        list.emplace_back(std::to_string(i));
+    list.reverse();
+    ASSERT_EQ(list.compact(), 8);
+    std::vector<std::string> texts;
+    for (const data_arena_plain_silist_node& node : list)
+        texts.push_back(node.text);
+    ASSERT_EQ(texts, (std::vector<std::string>{ "7", "6", "5", "4", "3", "2", "1", "0" }));
+    ASSERT_EQ(list.size(), 8);
+    ASSERT_EQ(list.back().text, "0");
+    ASSERT_EQ(list.arena().node_count(), 8);
+    ASSERT_EQ(list.arena().block_count(), 1);
+}
+
+TEST(arena_intrusive_list_tests, compact__heap_allocated_nodes__moved_into_arena)
+{
+    bool valid_1 = false;
+    bool valid_2 = false;
+    data_arena_list list;
+    list.push_back(itru::make_shared_intrusive_ptr<data_arena_silist_node>(valid_1, "1"));
+    list.push_back(itru::make_shared_intrusive_ptr<data_arena_silist_node>(valid_2, "2"));
+    ASSERT_EQ(list.arena().node_count(), 0);
+    ASSERT_EQ(list.compact(), 2);
+    ASSERT_EQ(list.arena().node_count(), 2);
+    ASSERT_EQ(list_texts(list), (std::vector<std::string>{ "1", "2" }));
+    ASSERT_TRUE(valid_1);
+    ASSERT_TRUE(valid_2);
+    ASSERT_TRUE(in_traversal_order(list));
+}
+
+TEST(arena_intrusive_list_tests, compact__node_with_latent_reference__not_relocated)
+{
+    bool valid = false;
+    data_arena_list list;
+    list.emplace_back(valid, "1");
+    itru::weak_intrusive_ptr<data_arena_silist_node> weak(list.begin().make_intrusive_shared());
+    const data_arena_silist_node* address = &list.front();
+    ASSERT_EQ(list.compact(), 0);
+    ASSERT_EQ(&list.front(), address);
+    ASSERT_EQ(weak.lock()->text, "1");
+}
+
+TEST(arena_intrusive_list_tests, compact__node_unique_after_first_pass__relocations_bounded_by_block)
+{
+    itru::arena_intrusive_list<data_arena_pinning_silist_node> list;
+    for (const char* text : { "1", "2", "3", "4" })
+        list.emplace_back(text);
+    // The last node is unique only once the first one has been relocated: the block is sized for three nodes.
+    list.front().pinned = itru::shared_intrusive_ptr<data_arena_pinning_silist_node>(&list.back());
+    const data_arena_pinning_silist_node* last_address = &list.back();
+    ASSERT_EQ(list.compact(), 3);
+    ASSERT_EQ(&list.back(), last_address);
+    std::vector<std::string> texts;
+    for (const data_arena_pinning_silist_node& node : list)
+        texts.push_back(node.text);
+    ASSERT_EQ(texts, (std::vector<std::string>{ "1", "2", "3", "4" }));
+    ASSERT_EQ(list.arena().node_count(), 4);
+}
@@ -0,0 +1,155 @@
+#include "data_with_core_counter.hpp"
+#include <arba/itru/chunked_siptr_list.hpp>
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_list = itru::chunked_siptr_list<data_with_ircnt, 4>;
+using data_siptr = itru::shared_intrusive_ptr<data_with_ircnt>;
+
+std::vector<std::string> list_texts(const data_list& list)
+{
+    std::vector<std::string> texts;
+    for (const data_siptr& value : list)
+        texts.push_back(value->text);
+    return texts;
+}
+
+std::vector<std::string> backward_texts(const data_list& list)
+{
+    std::vector<std::string> texts;
+    for (auto iter = list.end(); iter != list.begin();)
+        texts.push_back((*--iter)->text);
+    return texts;
+}
+} // namespace
+
+TEST(chunked_siptr_list_tests, push_back_push_front__many_values__ordered)
+{
+    constexpr int count = 50;
+    std::unique_ptr<bool[]> valids(new bool[count]);
+    {
+        data_list list;
+        std::vector<std::string> expected;
+        for (int i = 0; i < count; ++i)
+        {
+            if (i % 2 == 0)
+                list.push_back(itru::make_shared_intrusive_ptr<data_with_ircnt>(valids[i], std::to_string(i)));
+            else
+                list.push_front(itru::make_shared_intrusive_ptr<data_with_ircnt>(valids[i], std::to_string(i)));
+        }
+        for (int i = count - 1; i >= 0; i -= 2)
+            expected.push_back(std::to_string(i));
+        for (int i = 0; i < count; i += 2)
+            expected.push_back(std::to_string(i));
+        ASSERT_EQ(list.size(), count);
+        ASSERT_EQ(list_texts(list), expected);
+        ASSERT_EQ(backward_texts(list), std::vector<std::string>(expected.rbegin(), expected.rend()));
+        ASSERT_LE(list.chunk_count(), count / 2);
+        for (const data_siptr& value : list)
+            ASSERT_EQ(value->use_count(), 1);
+    }
+    for (int i = 0; i < count; ++i)
+        ASSERT_FALSE(valids[i]);
+}
+
+TEST(chunked_siptr_list_tests, insert_erase__random_positions__same_as_std_list)
+{
+    bool valid = false;
+    std::vector<data_siptr> values;
+    for (int i = 0; i < 64; ++i)
+        values.push_back(itru::make_shared_intrusive_ptr<data_with_ircnt>(valid, std::to_string(i)));
+
+    data_list list;
+    std::list<std::string> reference;
+    unsigned seed = 7;
+    for (int step = 0; step < 2000; ++step)
+    {
+        seed = seed * 1103515245 + 12345;
+        const std::size_t position = reference.empty() ? 0 : (seed >> 8) % (reference.size() + 1);
+        if ((seed >> 20) % 3 != 0 || reference.empty())
+        {
+            const data_siptr& value = values[(seed >> 4) % values.size()];
+            auto iter = list.insert(std::next(list.begin(), position), value);
+            ASSERT_EQ((*iter)->text, value->text);
+            reference.insert(std::next(reference.begin(), position), value->text);
+        }
+        else
+        {
+            const std::size_t erase_position = position % reference.size();
+            auto iter = list.erase(std::next(list.begin(), erase_position));
+            auto reference_iter = reference.erase(std::next(reference.begin(), erase_position));
+            ASSERT_EQ(iter == list.end(), reference_iter == reference.end());
+            if (iter != list.end())
+            {
+                ASSERT_EQ((*iter)->text, *reference_iter);
+            }
+        }
+    }
+    ASSERT_EQ(list_texts(list), std::vector<std::string>(reference.begin(), reference.end()));
+    ASSERT_EQ(list.size(), reference.size());
+
+    std::size_t reference_count = 0;
+    for (const data_siptr& value : values)
+        reference_count += value->use_count() - 1;
+    ASSERT_EQ(reference_count, list.size());
+    list.clear();
+    ASSERT_EQ(list.chunk_count(), 0);
+    for (const data_siptr& value : values)
+        ASSERT_EQ(value->use_count(), 1);
+}
+
+TEST(chunked_siptr_list_tests, splice__middle_of_chunk__no_counter_touched)
+{
+    bool valid = false;
+    data_list list;
+    data_list other;
+    for (int i = 0; i < 10; ++i)
+        list.push_back(itru::make_shared_intrusive_ptr<data_with_ircnt>(valid, std::to_string(i)));
+    for (int i = 0; i < 5; ++i)
+        other.push_back(itru::make_shared_intrusive_ptr<data_with_ircnt>(valid, "o" + std::to_string(i)));
+    list.splice(std::next(list.begin(), 3), other);
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(other.chunk_count(), 0);
+    ASSERT_EQ(list.size(), 15);
+    ASSERT_EQ(list_texts(list), (std::vector<std::string>{ "0", "1", "2", "o0", "o1", "o2", "o3", "o4", "3", "4", "5",
+                                                           "6", "7", "8", "9" }));
+    ASSERT_EQ(backward_texts(list).front(), "9");
+    for (const data_siptr& value : list)
+        ASSERT_EQ(value->use_count(), 1);
+
+    data_list moved(std::move(list));
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(moved.size(), 15);
+    data_list copy(moved);
+    ASSERT_EQ(list_texts(copy), list_texts(moved));
+    ASSERT_EQ(moved.front()->use_count(), 2);
+    copy.swap(list);
+    ASSERT_TRUE(copy.empty());
+    ASSERT_EQ(list.size(), 15);
+}
+
+TEST(chunked_siptr_list_tests, remove_if__predicate__matching_values_released)
+{
+    constexpr int count = 30;
+    std::unique_ptr<bool[]> valids(new bool[count]);
+    data_list list;
+    for (int i = 0; i < count; ++i)
+        list.push_back(itru::make_shared_intrusive_ptr<data_with_ircnt>(valids[i], std::to_string(i)));
+    ASSERT_EQ(list.remove_if([](const data_siptr& value) { return std::stoi(value->text) % 3 != 0; }), 20);
+    ASSERT_EQ(list.size(), 10);
+    for (int i = 0; i < count; ++i)
+        ASSERT_EQ(valids[i], i % 3 == 0);
+    ASSERT_EQ(list_texts(list).back(), "27");
+    ASSERT_EQ(list.remove_if([](const data_siptr&) { return true; }), 10);
+    ASSERT_EQ(list.chunk_count(), 0);
+    ASSERT_EQ(list.begin(), list.end());
+}
@@ -0,0 +1,162 @@
+#include "concurrent_writers_readers.hpp"
+#include "data_concurrent_map_node.hpp"
+#include <arba/itru/concurrent_intrusive_map.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_map = itru::concurrent_intrusive_map<data_concurrent_map_node, data_concurrent_map_node_key_of>;
+
+struct constant_hash
+{
+    std::size_t operator()(int) const noexcept { return 3; }
+};
+} // namespace
+
+TEST(concurrent_intrusive_map_tests, test_insert_find__many_keys__all_found)
+{
+    data_map map;
+    for (int key = 0; key < 1000; ++key)
+        ASSERT_TRUE(map.emplace(key * 3));
+    ASSERT_EQ(map.size(), 1000);
+    ASSERT_GE(map.bucket_count(), 512);
+    for (int key = 0; key < 3000; ++key)
+    {
+        itru::shared_intrusive_ptr node = map.find(key);
+        ASSERT_EQ(node != nullptr, key % 3 == 0);
+        if (node)
+        {
+            ASSERT_EQ(node->key, key);
+        }
+    }
+}
+
+TEST(concurrent_intrusive_map_tests, test_insert__equivalent_key__rejected)
+{
+    data_map map;
+    itru::shared_intrusive_ptr first = itru::make_shared_intrusive_ptr<data_concurrent_map_node>(3);
+    itru::shared_intrusive_ptr second = itru::make_shared_intrusive_ptr<data_concurrent_map_node>(3);
+    ASSERT_TRUE(map.insert(first));
+    ASSERT_FALSE(map.insert(second));
+    ASSERT_EQ(map.size(), 1);
+    ASSERT_EQ(map.find(3), first);
+    ASSERT_EQ(first->use_count(), 2);
+    ASSERT_EQ(second->use_count(), 1);
+}
+
+TEST(concurrent_intrusive_map_tests, test_erase__colliding_keys__other_keys_kept)
+{
+    itru::concurrent_intrusive_map<data_concurrent_map_node, data_concurrent_map_node_key_of, constant_hash> map;
+    for (int key = 0; key < 40; ++key)
+        map.emplace(key);
+    for (int key = 0; key < 40; key += 2)
+        ASSERT_TRUE(map.erase(key));
+    ASSERT_FALSE(map.erase(0));
+    ASSERT_EQ(map.size(), 20);
+    for (int key = 0; key < 40; ++key)
+        ASSERT_EQ(map.contains(key), key % 2 == 1);
+}
+
+TEST(concurrent_intrusive_map_tests, test_extract__reader_holds_element__element_kept_alive)
+{
+    std::atomic<int> alive_count = 0;
+    {
+        data_map map;
+        for (int key = 0; key < 5; ++key)
+            map.emplace(alive_count, key);
+        itru::shared_intrusive_ptr held = map.find(2);
+        ASSERT_TRUE(map.erase(2));
+        ASSERT_FALSE(map.contains(2));
+        ASSERT_EQ(map.size(), 4);
+        itru::epoch_reclaimer::synchronize();
+        ASSERT_EQ(held->use_count(), 1);
+        ASSERT_EQ(held->key, 2);
+        ASSERT_EQ(alive_count, 5);
+    }
+    itru::epoch_reclaimer::synchronize();
+    ASSERT_EQ(alive_count, 0);
+}
+
+TEST(concurrent_intrusive_map_tests, test_insert_erase__concurrent_writers_and_readers__consistent)
+{
+    constexpr int key_count = 4096;
+    constexpr int writer_count = 4;
+    constexpr int operation_count = 20000;
+    std::atomic<int> alive_count = 0;
+    {
+        data_map map;
+        // Keys never erased: the readers must always find them, even while the map grows.
+        for (int key = key_count; key < key_count + 16; ++key)
+            map.emplace(alive_count, key);
+        const std::vector<bool> presents = run_concurrent_writers_and_readers(
+            key_count, writer_count, operation_count,
+            [&]
+            {
+                for (int key = 0; key < key_count + 16; key += 5)
+                {
+                    itru::shared_intrusive_ptr node = map.find(key);
+                    if (key >= key_count)
+                    {
+                        EXPECT_NE(node, nullptr);
+                    }
+                    if (node)
+                    {
+                        EXPECT_EQ(node->key, key);
+                    }
+                }
+            },
+            [&](int key) { return map.emplace(alive_count, key); }, [&](int key) { return map.erase(key); });
+
+        std::size_t expected_size = 16;
+        for (int key = 0; key < key_count; ++key)
+        {
+            ASSERT_EQ(map.contains(key), presents[key]);
+            expected_size += presents[key] ? 1 : 0;
+        }
+        ASSERT_EQ(map.size(), expected_size);
+    }
+    itru::epoch_reclaimer::synchronize();
+    ASSERT_EQ(alive_count, 0);
+}
+
+TEST(concurrent_intrusive_map_tests, test_insert_find__growing_colliding_keys__kept_keys_always_found)
+{
+    // All the keys are in one bucket: each migration relinks a long chain while the readers walk it.
+    std::atomic<int> alive_count = 0;
+    {
+        itru::concurrent_intrusive_map<data_concurrent_map_node, data_concurrent_map_node_key_of, constant_hash> map(1);
+        for (int key = 0; key < 8; ++key)
+            map.emplace(alive_count, key);
+        std::atomic<bool> stop = false;
+        std::vector<std::thread> readers;
+        for (int reader_index = 0; reader_index < 2; ++reader_index)
+        {
+            readers.emplace_back(
+                [&]
+                {
+                    while (!stop)
+                    {
+                        for (int key = 0; key < 8; ++key)
+                            EXPECT_TRUE(map.contains(key));
+                    }
+                });
+        }
+        // The readers must be joined before any fatal assertion returns.
+        for (int key = 8; key < 1024; ++key)
+            EXPECT_TRUE(map.emplace(alive_count, key));
+        stop = true;
+        for (std::thread& reader : readers)
+            reader.join();
+        ASSERT_EQ(map.size(), 1024);
+        ASSERT_GE(map.bucket_count(), 512);
+    }
+    itru::epoch_reclaimer::synchronize();
+    ASSERT_EQ(alive_count, 0);
+}
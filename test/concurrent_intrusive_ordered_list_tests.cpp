@@ -0,0 +1,135 @@
+#include "concurrent_writers_readers.hpp"
+#include "data_ordered_list_node.hpp"
+#include <arba/itru/concurrent_intrusive_ordered_list.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_ordered_list =
+    itru::concurrent_intrusive_ordered_list<data_ordered_list_node, data_ordered_list_node_key_of>;
+
+std::vector<int> keys(const data_ordered_list& list)
+{
+    std::vector<int> keys;
+    for (const data_ordered_list_node& node : list)
+        keys.push_back(node.key);
+    return keys;
+}
+} // namespace
+
+TEST(concurrent_intrusive_ordered_list_tests, test_insert__shuffled_keys__ordered)
+{
+    std::vector<int> input(100);
+    for (int i = 0; i < 100; ++i)
+        input[i] = i;
+    std::shuffle(input.begin(), input.end(), std::mt19937(7));
+
+    data_ordered_list list;
+    for (int key : input)
+        ASSERT_TRUE(list.emplace(key));
+    ASSERT_EQ(list.size(), 100);
+    std::sort(input.begin(), input.end());
+    ASSERT_EQ(keys(list), input);
+    std::vector<int> visited;
+    list.for_each([&](const data_ordered_list_node& node) { visited.push_back(node.key); });
+    ASSERT_EQ(visited, input);
+}
+
+TEST(concurrent_intrusive_ordered_list_tests, test_insert__equivalent_key__rejected)
+{
+    data_ordered_list list;
+    itru::shared_intrusive_ptr first = itru::make_shared_intrusive_ptr<data_ordered_list_node>(3);
+    itru::shared_intrusive_ptr second = itru::make_shared_intrusive_ptr<data_ordered_list_node>(3);
+    ASSERT_TRUE(list.insert(first));
+    ASSERT_FALSE(list.insert(second));
+    ASSERT_EQ(list.size(), 1);
+    ASSERT_EQ(list.find(3), first);
+    ASSERT_EQ(first->use_count(), 2);
+    ASSERT_EQ(second->use_count(), 1);
+}
+
+TEST(concurrent_intrusive_ordered_list_tests, test_find__present_and_absent_keys__expected_results)
+{
+    data_ordered_list list;
+    for (int key : { 10, 20, 30 })
+        list.emplace(key);
+    ASSERT_TRUE(list.contains(20));
+    ASSERT_FALSE(list.contains(25));
+    ASSERT_EQ(list.find(25), nullptr);
+    ASSERT_EQ(list.find(30)->key, 30);
+    ASSERT_EQ(list.lower_bound(25)->key, 30);
+    ASSERT_EQ(list.lower_bound(5)->key, 10);
+    ASSERT_EQ(list.lower_bound(35), list.end());
+}
+
+TEST(concurrent_intrusive_ordered_list_tests, test_iterator__current_element_erased__continues_after_it)
+{
+    std::atomic<int> alive_count = 0;
+    {
+        data_ordered_list list;
+        for (int key = 0; key < 6; ++key)
+            list.emplace(alive_count, key);
+        data_ordered_list::iterator iter = list.lower_bound(2);
+        ASSERT_TRUE(list.erase(2));
+        ASSERT_TRUE(list.erase(3));
+        itru::epoch_reclaimer::synchronize();
+        ASSERT_EQ(iter->key, 2);
+        ASSERT_EQ(iter.siptr()->use_count(), 1);
+        ++iter;
+        ASSERT_EQ(iter->key, 4);
+        ASSERT_FALSE(list.erase(2));
+        ASSERT_EQ(list.size(), 4);
+        ASSERT_EQ(keys(list), (std::vector<int>{ 0, 1, 4, 5 }));
+        ASSERT_EQ(alive_count, 4);
+    }
+    itru::epoch_reclaimer::synchronize();
+    ASSERT_EQ(alive_count, 0);
+}
+
+TEST(concurrent_intrusive_ordered_list_tests, test_insert_erase__concurrent_writers_and_readers__consistent)
+{
+    constexpr int key_count = 128;
+    constexpr int writer_count = 4;
+    constexpr int operation_count = 4000;
+    std::atomic<int> alive_count = 0;
+    {
+        data_ordered_list list;
+        const std::vector<bool> presents = run_concurrent_writers_and_readers(
+            key_count, writer_count, operation_count,
+            [&]
+            {
+                int previous_key = -1;
+                for (const data_ordered_list_node& node : list)
+                {
+                    EXPECT_LT(previous_key, node.key);
+                    previous_key = node.key;
+                }
+                for (int key = 0; key < key_count; key += 7)
+                {
+                    itru::shared_intrusive_ptr node = list.find(key);
+                    if (node)
+                    {
+                        EXPECT_EQ(node->key, key);
+                    }
+                }
+            },
+            [&](int key) { return list.emplace(alive_count, key); }, [&](int key) { return list.erase(key); });
+
+        std::vector<int> expected_keys;
+        for (int key = 0; key < key_count; ++key)
+            if (presents[key])
+                expected_keys.push_back(key);
+        ASSERT_EQ(keys(list), expected_keys);
+        ASSERT_EQ(list.size(), expected_keys.size());
+    }
+    itru::epoch_reclaimer::synchronize();
+    ASSERT_EQ(alive_count, 0);
+}
@@ -0,0 +1,225 @@
+#include "concurrent_writers_readers.hpp"
+#include "data_skip_list_node.hpp"
+#include <arba/itru/concurrent_intrusive_skip_list.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_skip_list = itru::concurrent_intrusive_skip_list<data_skip_list_node, data_skip_list_node_key_of>;
+
+std::vector<int> keys(const data_skip_list& list)
+{
+    std::vector<int> keys;
+    list.for_each([&](const data_skip_list_node& node) { keys.push_back(node.key); });
+    return keys;
+}
+} // namespace
+
+TEST(concurrent_intrusive_skip_list_tests, test_insert__shuffled_keys__ordered)
+{
+    std::vector<int> input(200);
+    for (int i = 0; i < 200; ++i)
+        input[i] = i;
+    std::shuffle(input.begin(), input.end(), std::mt19937(7));
+
+    data_skip_list list;
+    for (int key : input)
+        ASSERT_TRUE(list.emplace(key));
+    ASSERT_EQ(list.size(), 200);
+    std::sort(input.begin(), input.end());
+    ASSERT_EQ(keys(list), input);
+}
+
+TEST(concurrent_intrusive_skip_list_tests, test_insert__equivalent_key__rejected)
+{
+    data_skip_list list;
+    itru::shared_intrusive_ptr first = itru::make_shared_intrusive_ptr<data_skip_list_node>(3);
+    itru::shared_intrusive_ptr second = itru::make_shared_intrusive_ptr<data_skip_list_node>(3);
+    ASSERT_TRUE(list.insert(first));
+    ASSERT_FALSE(list.insert(second));
+    ASSERT_EQ(list.size(), 1);
+    ASSERT_EQ(list.find(3), first);
+    ASSERT_EQ(first->use_count(), 2);
+    ASSERT_EQ(second->use_count(), 1);
+}
+
+TEST(concurrent_intrusive_skip_list_tests, test_insert__already_linked_element__rejected_and_later_retired)
+{
+    std::atomic<int> alive_count = 0;
+    {
+        data_skip_list list;
+        for (int key = 0; key < 10; ++key)
+            list.emplace(alive_count, key);
+        itru::shared_intrusive_ptr node = list.find(5);
+        const unsigned height = node->tower_height();
+        ASSERT_FALSE(list.insert(node));
+        ASSERT_EQ(node->tower_height(), height);
+        ASSERT_EQ(list.size(), 10);
+        node = nullptr;
+        ASSERT_TRUE(list.erase(5));
+        itru::epoch_reclaimer::synchronize();
+        ASSERT_EQ(alive_count, 9);
+    }
+    itru::epoch_reclaimer::synchronize();
+    ASSERT_EQ(alive_count, 0);
+}
+
+TEST(concurrent_intrusive_skip_list_tests, test_find__present_and_absent_keys__expected_results)
+{
+    data_skip_list list;
+    for (int key : { 10, 20, 30 })
+        list.emplace(key);
+    ASSERT_TRUE(list.contains(20));
+    ASSERT_FALSE(list.contains(25));
+    ASSERT_EQ(list.find(25), nullptr);
+    ASSERT_EQ(list.find(30)->key, 30);
+    ASSERT_EQ(list.lower_bound(25)->key, 30);
+    ASSERT_EQ(list.lower_bound(5)->key, 10);
+    ASSERT_EQ(list.lower_bound(35), nullptr);
+}
+
+TEST(concurrent_intrusive_skip_list_tests, test_for_each_in__range__keys_in_range)
+{
+    data_skip_list list;
+    for (int key = 0; key < 10; ++key)
+        list.emplace(key * 2);
+    std::vector<int> visited;
+    list.for_each_in(5, 11, [&](const data_skip_list_node& node) { visited.push_back(node.key); });
+    ASSERT_EQ(visited, (std::vector<int>{ 6, 8, 10 }));
+}
+
+TEST(concurrent_intrusive_skip_list_tests, test_extract__reader_holds_element__element_kept_alive)
+{
+    std::atomic<int> alive_count = 0;
+    {
+        data_skip_list list;
+        for (int key = 0; key < 5; ++key)
+            list.emplace(alive_count, key);
+        itru::shared_intrusive_ptr held = list.find(2);
+        ASSERT_TRUE(list.erase(2));
+        ASSERT_FALSE(list.erase(2));
+        ASSERT_FALSE(list.contains(2));
+        ASSERT_EQ(list.size(), 4);
+        ASSERT_EQ(keys(list), (std::vector<int>{ 0, 1, 3, 4 }));
+        itru::epoch_reclaimer::synchronize();
+        ASSERT_EQ(held->use_count(), 1);
+        ASSERT_EQ(held->key, 2);
+        ASSERT_EQ(alive_count, 5);
+    }
+    itru::epoch_reclaimer::synchronize();
+    ASSERT_EQ(alive_count, 0);
+}
+
+TEST(concurrent_intrusive_skip_list_tests, test_insert_erase__concurrent_writers_and_readers__consistent)
+{
+    constexpr int key_count = 512;
+    constexpr int writer_count = 4;
+    constexpr int operation_count = 4000;
+    std::atomic<int> alive_count = 0;
+    {
+        data_skip_list list;
+        const std::vector<bool> presents = run_concurrent_writers_and_readers(
+            key_count, writer_count, operation_count,
+            [&]
+            {
+                int previous_key = -1;
+                list.for_each(
+                    [&](const data_skip_list_node& node)
+                    {
+                        EXPECT_LT(previous_key, node.key);
+                        previous_key = node.key;
+                    });
+                for (int key = 0; key < key_count; key += 7)
+                {
+                    itru::shared_intrusive_ptr node = list.find(key);
+                    if (node)
+                    {
+                        EXPECT_EQ(node->key, key);
+                    }
+                }
+            },
+            [&](int key) { return list.emplace(alive_count, key); }, [&](int key) { return list.erase(key); });
+
+        std::vector<int> expected_keys;
+        for (int key = 0; key < key_count; ++key)
+            if (presents[key])
+                expected_keys.push_back(key);
+        ASSERT_EQ(keys(list), expected_keys);
+        ASSERT_EQ(list.size(), expected_keys.size());
+    }
+    itru::epoch_reclaimer::synchronize();
+    ASSERT_EQ(alive_count, 0);
+}
+
+TEST(concurrent_intrusive_skip_list_tests, test_insert_extract__same_keys_from_all_threads__no_element_leaked)
+{
+    // Few keys, shared by all the writers: an element is often erased while its insertion still links its upper
+    // levels, and readers walk the upper levels meanwhile.
+    constexpr int key_count = 8;
+    constexpr int writer_count = 4;
+    constexpr int operation_count = 20000;
+    std::atomic<int> alive_count = 0;
+    {
+        data_skip_list list;
+        std::atomic<bool> stop = false;
+        std::thread reader(
+            [&]
+            {
+                while (!stop)
+                {
+                    for (int key = 0; key < key_count; ++key)
+                    {
+                        itru::shared_intrusive_ptr node = list.lower_bound(key);
+                        if (node)
+                        {
+                            EXPECT_GE(node->key, key);
+                        }
+                    }
+                }
+            });
+        std::vector<std::thread> writers;
+        std::atomic<int> inserted_count = 0;
+        std::atomic<int> extracted_count = 0;
+        for (int writer_index = 0; writer_index < writer_count; ++writer_index)
+        {
+            writers.emplace_back(
+                [&, writer_index]
+                {
+                    std::mt19937 engine(writer_index);
+                    for (int i = 0; i < operation_count; ++i)
+                    {
+                        const int key = int(engine() % key_count);
+                        if (engine() % 2)
+                            inserted_count += list.emplace(alive_count, key);
+                        else if (itru::shared_intrusive_ptr node = list.extract(key))
+                        {
+                            EXPECT_EQ(node->key, key);
+                            ++extracted_count;
+                        }
+                    }
+                });
+        }
+        for (std::thread& writer : writers)
+            writer.join();
+        stop = true;
+        reader.join();
+
+        const std::vector<int> list_keys = keys(list);
+        ASSERT_TRUE(std::is_sorted(list_keys.begin(), list_keys.end()));
+        ASSERT_EQ(list_keys.size(), std::size_t(inserted_count - extracted_count));
+        ASSERT_EQ(list.size(), list_keys.size());
+        itru::epoch_reclaimer::synchronize();
+        ASSERT_EQ(alive_count, int(list_keys.size()));
+    }
+    itru::epoch_reclaimer::synchronize();
+    ASSERT_EQ(alive_count, 0);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Runs writer_count writers, each toggling operation_count times a random key it owns, while reader_count readers
+// call read() in a loop. Each writer owns the keys equal to its index modulo writer_count, hence knows which of them
+// are present: insert(key) and erase(key) are expected to succeed. Every thread is joined before returning the
+// presence of each key of [0, key_count).
+template <class ReadT, class InsertT, class EraseT>
+std::vector<bool> run_concurrent_writers_and_readers(int key_count, int writer_count, int operation_count, ReadT read,
+                                                     InsertT insert, EraseT erase, int reader_count = 2)
+{
+    std::atomic<bool> stop = false;
+    std::vector<std::thread> readers;
+    for (int reader_index = 0; reader_index < reader_count; ++reader_index)
+    {
+        readers.emplace_back(
+            [&]
+            {
+                while (!stop)
+                    read();
+            });
+    }
+    std::vector<std::thread> writers;
+    std::vector<std::vector<bool>> presents(writer_count, std::vector<bool>(key_count, false));
+    for (int writer_index = 0; writer_index < writer_count; ++writer_index)
+    {
+        writers.emplace_back(
+            [&, writer_index]
+            {
+                std::mt19937 engine(writer_index);
+                std::vector<bool>& present = presents[writer_index];
+                for (int i = 0; i < operation_count; ++i)
+                {
+                    const int key = int(engine() % (key_count / writer_count)) * writer_count + writer_index;
+                    if (present[key])
+                        EXPECT_TRUE(erase(key));
+                    else
+                        EXPECT_TRUE(insert(key));
+                    present[key] = !present[key];
+                }
+            });
+    }
+    for (std::thread& writer : writers)
+        writer.join();
+    stop = true;
+    for (std::thread& reader : readers)
+        reader.join();
+
+    std::vector<bool> key_presents(key_count);
+    for (int key = 0; key < key_count; ++key)
+        key_presents[key] = presents[key % writer_count][key];
+    return key_presents;
+}
@@ -0,0 +1,95 @@
+#include "data_cow_node.hpp"
+#include <arba/itru/cow_intrusive_ptr.hpp>
+#include <arba/itru/weak_intrusive_ptr.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------
+
+TEST(cow_intrusive_ptr_tests, test_mutate__unique_owner__not_cloned)
+{
+    std::atomic<int> copy_count = 0;
+    itru::cow_intrusive_ptr cptr = itru::make_cow_intrusive_ptr<data_cow_node>(copy_count, std::vector{ 1, 2 });
+    const data_cow_node* address = cptr.get();
+    ASSERT_TRUE(cptr.unique());
+    cptr.mutate().values.push_back(3);
+    ASSERT_EQ(cptr.get(), address);
+    ASSERT_EQ(copy_count, 0);
+    ASSERT_EQ(cptr->values, (std::vector{ 1, 2, 3 }));
+}
+
+TEST(cow_intrusive_ptr_tests, test_mutate__shared_element__cloned)
+{
+    std::atomic<int> copy_count = 0;
+    itru::cow_intrusive_ptr cptr = itru::make_cow_intrusive_ptr<data_cow_node>(copy_count, std::vector{ 1, 2 });
+    itru::cow_intrusive_ptr<data_cow_node> copy = cptr;
+    ASSERT_EQ(cptr.get(), copy.get());
+    ASSERT_EQ(cptr.use_count(), 2);
+    ASSERT_FALSE(cptr.unique());
+
+    copy.mutate().values.push_back(3);
+    ASSERT_EQ(copy_count, 1);
+    ASSERT_NE(cptr.get(), copy.get());
+    ASSERT_EQ(cptr->values, (std::vector{ 1, 2 }));
+    ASSERT_EQ(copy->values, (std::vector{ 1, 2, 3 }));
+    ASSERT_TRUE(cptr.unique());
+    ASSERT_TRUE(copy.unique());
+    copy.mutate().values.push_back(4);
+    ASSERT_EQ(copy_count, 1);
+}
+
+TEST(cow_intrusive_ptr_tests, test_mutate__latent_reference__cloned)
+{
+    std::atomic<int> copy_count = 0;
+    auto siptr = itru::make_shared_intrusive_ptr<data_cow_node>(copy_count, std::vector{ 1 });
+    itru::weak_intrusive_ptr<data_cow_node> wiptr(siptr);
+    itru::cow_intrusive_ptr<data_cow_node> cptr(std::move(siptr));
+    ASSERT_EQ(cptr.use_count(), 1);
+    ASSERT_FALSE(cptr.unique());
+
+    cptr.mutate().values.push_back(2);
+    ASSERT_EQ(copy_count, 1);
+    ASSERT_TRUE(wiptr.expired());
+    ASSERT_EQ(cptr->values, (std::vector{ 1, 2 }));
+}
+
+TEST(cow_intrusive_ptr_tests, test_mutate__polymorphic_element__cloned_with_clone)
+{
+    itru::cow_intrusive_ptr<base_cow_shape> cptr(itru::make_shared_intrusive_ptr<data_cow_square>());
+    itru::cow_intrusive_ptr<base_cow_shape> copy = cptr;
+    copy.mutate().scale = 2;
+    ASSERT_EQ(copy->side_count(), 4);
+    ASSERT_EQ(copy->scale, 2);
+    ASSERT_EQ(cptr->scale, 1);
+}
+
+TEST(cow_intrusive_ptr_tests, test_mutate__concurrent_copies__each_thread_writes_its_own_element)
+{
+    constexpr int thread_count = 4;
+    std::atomic<int> copy_count = 0;
+    itru::cow_intrusive_ptr original = itru::make_cow_intrusive_ptr<data_cow_node>(copy_count, std::vector{ 0 });
+    std::vector<itru::cow_intrusive_ptr<data_cow_node>> copies(thread_count, original);
+    original.reset();
+    std::vector<std::thread> threads;
+    for (int thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        threads.emplace_back(
+            [&copies, thread_index]
+            {
+                itru::cow_intrusive_ptr<data_cow_node>& cptr = copies[thread_index];
+                for (int i = 0; i < 100; ++i)
+                    cptr.mutate().values.push_back(thread_index);
+            });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    for (int thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        ASSERT_TRUE(copies[thread_index].unique());
+        ASSERT_EQ(copies[thread_index]->values.size(), 101);
+        ASSERT_EQ(copies[thread_index]->values.back(), thread_index);
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <arba/itru/intrusive_ref_counter.hpp>
+#include <arba/itru/shared_intrusive_ptr.hpp>
+
+#include <atomic>
+#include <vector>
+
+struct data_cow_node : public itru::intrusive_ref_counters<>
+{
+    std::vector<int> values;
+    std::atomic<int>* copy_count = nullptr;
+
+    explicit data_cow_node(std::atomic<int>& count, std::vector<int> input_values)
+        : values(std::move(input_values)), copy_count(&count)
+    {
+    }
+    data_cow_node(const data_cow_node& other)
+        : itru::intrusive_ref_counters<>(other), values(other.values), copy_count(other.copy_count)
+    {
+        if (copy_count)
+            ++*copy_count;
+    }
+};
+
+struct base_cow_shape : public itru::intrusive_ref_counter<>
+{
+    virtual ~base_cow_shape() = default;
+    virtual itru::shared_intrusive_ptr<base_cow_shape> clone() const = 0;
+    virtual int side_count() const = 0;
+
+    int scale = 1;
+};
+
+struct data_cow_square : public base_cow_shape
+{
+    itru::shared_intrusive_ptr<base_cow_shape> clone() const override
+    {
+        return itru::make_shared_intrusive_ptr<data_cow_square>(*this);
+    }
+    int side_count() const override { return 4; }
+};
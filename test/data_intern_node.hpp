@@ -0,0 +1,36 @@
+#pragma once
+
+#include <arba/itru/intern_pool.hpp>
+#include <arba/itru/intrusive_ref_counter.hpp>
+
+#include <string>
+#include <string_view>
+
+struct data_intern_node : public itru::intrusive_ref_counters<>, public itru::intern_pool_hook<data_intern_node>
+{
+    std::string text;
+    bool* valid = nullptr;
+
+    explicit data_intern_node(bool& bval, std::string_view input_text) : text(input_text), valid(&bval) { bval = true; }
+    explicit data_intern_node(std::string_view input_text) : text(input_text) {}
+
+    ~data_intern_node()
+    {
+        if (valid)
+        {
+            *valid = false;
+        }
+    }
+};
+
+struct data_intern_node_key_of
+{
+    const std::string& operator()(const data_intern_node& node) const noexcept { return node.text; }
+};
+
+struct transparent_text_hash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>()(str); }
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <arba/itru/intrusive_lru_cache_hook.hpp>
+#include <arba/itru/intrusive_ref_counter.hpp>
+
+#include <string>
+
+struct data_lru_cache_node : public itru::intrusive_ref_counters<>,
+                             public itru::intrusive_lru_cache_hook<data_lru_cache_node, std::string>
+{
+    std::string text;
+    bool* valid = nullptr;
+
+    data_lru_cache_node() {}
+
+    explicit data_lru_cache_node(bool& bval, const std::string& input_text = "") : text(input_text), valid(&bval)
+    {
+        bval = true;
+    }
+    explicit data_lru_cache_node(const std::string& input_text) : text(input_text) {}
+
+    ~data_lru_cache_node()
+    {
+        if (valid)
+        {
+            *valid = false;
+        }
+    }
+};
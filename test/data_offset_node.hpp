@@ -0,0 +1,16 @@
+#pragma once
+
+#include <arba/itru/intrusive_ref_counter.hpp>
+#include <arba/itru/offset_shared_intrusive_ptr.hpp>
+
+struct data_offset_node : public itru::intrusive_ref_counter<>
+{
+    int value = 0;
+    itru::offset_shared_intrusive_ptr<data_offset_node> next;
+
+    explicit data_offset_node(int input_value) : value(input_value) {}
+    data_offset_node(int input_value, itru::offset_shared_intrusive_ptr<data_offset_node> input_next)
+        : value(input_value), next(std::move(input_next))
+    {
+    }
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <arba/itru/intrusive_ref_counter.hpp>
+#include <arba/itru/sharable_intrusive_heap_hook.hpp>
+
+struct data_siheap_node : public itru::intrusive_ref_counters<>,
+                          public itru::sharable_intrusive_heap_hook<data_siheap_node>
+{
+    int deadline = 0;
+    bool* valid = nullptr;
+
+    explicit data_siheap_node(bool& bval, int input_deadline) : deadline(input_deadline), valid(&bval)
+    {
+        bval = true;
+    }
+    explicit data_siheap_node(int input_deadline) : deadline(input_deadline) {}
+
+    ~data_siheap_node()
+    {
+        if (valid)
+        {
+            *valid = false;
+        }
+    }
+};
+
+struct later_deadline
+{
+    template <class NodeT>
+    bool operator()(const NodeT& lhs, const NodeT& rhs) const noexcept
+    {
+        return lhs.deadline > rhs.deadline;
+    }
+};
+
+struct data_raw_siheap_node : public itru::sharable_intrusive_heap_hook<data_raw_siheap_node, itru::raw_link_t>
+{
+    int deadline = 0;
+
+    explicit data_raw_siheap_node(int input_deadline) : deadline(input_deadline) {}
+};
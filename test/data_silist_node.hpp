@@ -1,6 +1,7 @@
 #pragma once
 
 #include <arba/itru/intrusive_ref_counter.hpp>
+#include <arba/itru/node_arena.hpp>
 #include <arba/itru/sharable_intrusive_list_hook.hpp>
 
 #include <string>
@@ -73,3 +74,86 @@ struct data_silist_node : public itru::intrusive_ref_counters<>,
         }
     }
 };
+
+struct data_arena_silist_node : public itru::intrusive_ref_counters<>,
+                                public itru::sharable_intrusive_list_hook<data_arena_silist_node>,
+                                public itru::arena_node_base
+{
+    std::string text;
+    bool* valid = nullptr;
+
+    data_arena_silist_node() {}
+
+    explicit data_arena_silist_node(bool& bval, const std::string& input_text = "") : text(input_text), valid(&bval)
+    {
+        bval = true;
+    }
+
+    data_arena_silist_node(data_arena_silist_node&& other) : text(std::move(other.text)), valid(other.valid)
+    {
+        other.valid = nullptr;
+    }
+
+    ~data_arena_silist_node()
+    {
+        if (valid)
+        {
+            *valid = false;
+        }
+    }
+};
+
+// Relocated by its defaulted move constructor, which moves the links of the hook too.
+struct data_arena_plain_silist_node : public itru::intrusive_ref_counters<>,
+                                      public itru::sharable_intrusive_list_hook<data_arena_plain_silist_node>,
+                                      public itru::arena_node_base
+{
+    std::string text;
+
+    data_arena_plain_silist_node() {}
+    explicit data_arena_plain_silist_node(const std::string& input_text) : text(input_text) {}
+    data_arena_plain_silist_node(data_arena_plain_silist_node&&) = default;
+};
+
+// Holds a reference on another node, which its move constructor leaves to the moved-from node: the reference is
+// released once the moved-from node is destroyed.
+struct data_arena_pinning_silist_node : public itru::intrusive_ref_counters<>,
+                                        public itru::sharable_intrusive_list_hook<data_arena_pinning_silist_node>,
+                                        public itru::arena_node_base
+{
+    std::string text;
+    itru::shared_intrusive_ptr<data_arena_pinning_silist_node> pinned;
+
+    data_arena_pinning_silist_node() {}
+    explicit data_arena_pinning_silist_node(const std::string& input_text) : text(input_text) {}
+    data_arena_pinning_silist_node(data_arena_pinning_silist_node&& other) : text(std::move(other.text)) {}
+};
+
+struct data_raw_silist_node : public itru::sharable_intrusive_list_hook<data_raw_silist_node, itru::raw_link_t>
+{
+    std::string text;
+
+    data_raw_silist_node() {}
+
+    explicit data_raw_silist_node(const std::string& input_text) : text(input_text) {}
+};
+
+struct connection_hook_tag
+{
+};
+struct timeout_hook_tag
+{
+};
+
+struct multi_hook_silist_node
+    : public itru::intrusive_ref_counters<>,
+      public itru::sharable_intrusive_list_hook<multi_hook_silist_node, itru::shared_link_t, connection_hook_tag>,
+      public itru::sharable_intrusive_list_hook<multi_hook_silist_node, itru::shared_link_t, timeout_hook_tag>
+{
+    std::string text;
+    itru::sharable_intrusive_list_hook<multi_hook_silist_node> priority_hook;
+
+    multi_hook_silist_node() {}
+
+    explicit multi_hook_silist_node(const std::string& input_text) : text(input_text) {}
+};
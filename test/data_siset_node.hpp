@@ -0,0 +1,38 @@
+#pragma once
+
+#include <arba/itru/intrusive_ref_counter.hpp>
+#include <arba/itru/sharable_intrusive_set_hook.hpp>
+
+struct data_siset_node : public itru::intrusive_ref_counters<>,
+                         public itru::sharable_intrusive_set_hook<data_siset_node>
+{
+    int key = 0;
+    bool* valid = nullptr;
+
+    explicit data_siset_node(bool& bval, int input_key) : key(input_key), valid(&bval) { bval = true; }
+    explicit data_siset_node(int input_key) : key(input_key) {}
+
+    ~data_siset_node()
+    {
+        if (valid)
+        {
+            *valid = false;
+        }
+    }
+};
+
+struct data_siset_node_key_of
+{
+    template <class NodeT>
+    int operator()(const NodeT& node) const noexcept
+    {
+        return node.key;
+    }
+};
+
+struct data_raw_siset_node : public itru::sharable_intrusive_set_hook<data_raw_siset_node, itru::raw_link_t>
+{
+    int key = 0;
+
+    explicit data_raw_siset_node(int input_key) : key(input_key) {}
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <arba/itru/intrusive_ref_counter.hpp>
+#include <arba/itru/sharable_intrusive_slist_hook.hpp>
+
+#include <string>
+
+struct data_sislist_node : public itru::intrusive_ref_counter<>,
+                           public itru::sharable_intrusive_slist_hook<data_sislist_node>
+{
+    std::string text;
+    bool* valid = nullptr;
+
+    data_sislist_node() {}
+
+    explicit data_sislist_node(bool& bval, const std::string& input_text = "") : text(input_text), valid(&bval)
+    {
+        bval = true;
+    }
+
+    ~data_sislist_node()
+    {
+        if (valid)
+        {
+            *valid = false;
+        }
+    }
+};
+
+struct data_raw_sislist_node : public itru::sharable_intrusive_slist_hook<data_raw_sislist_node, itru::raw_link_t>
+{
+    std::string text;
+
+    data_raw_sislist_node() {}
+
+    explicit data_raw_sislist_node(const std::string& input_text) : text(input_text) {}
+};
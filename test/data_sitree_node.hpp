@@ -0,0 +1,30 @@
+#pragma once
+
+#include <arba/itru/intrusive_ref_counter.hpp>
+#include <arba/itru/sharable_intrusive_tree_hook.hpp>
+
+#include <string>
+
+struct data_sitree_node : public itru::intrusive_ref_counter<>,
+                          public itru::sharable_intrusive_tree_hook<data_sitree_node>
+{
+    std::string text;
+    bool* valid = nullptr;
+
+    data_sitree_node() {}
+
+    explicit data_sitree_node(const std::string& input_text) : text(input_text) {}
+
+    explicit data_sitree_node(bool& bval, const std::string& input_text = "") : text(input_text), valid(&bval)
+    {
+        bval = true;
+    }
+
+    ~data_sitree_node()
+    {
+        if (valid)
+        {
+            *valid = false;
+        }
+    }
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <arba/itru/intrusive_ref_counter.hpp>
+#include <arba/itru/sharable_intrusive_unordered_set_hook.hpp>
+
+#include <string>
+#include <string_view>
+
+struct data_siuset_node : public itru::intrusive_ref_counters<>,
+                          public itru::sharable_intrusive_unordered_set_hook<data_siuset_node>
+{
+    std::string key;
+    bool* valid = nullptr;
+
+    explicit data_siuset_node(bool& bval, const std::string& input_key) : key(input_key), valid(&bval) { bval = true; }
+    explicit data_siuset_node(const std::string& input_key) : key(input_key) {}
+
+    ~data_siuset_node()
+    {
+        if (valid)
+        {
+            *valid = false;
+        }
+    }
+};
+
+struct data_siuset_node_key_of
+{
+    template <class NodeT>
+    const std::string& operator()(const NodeT& node) const noexcept
+    {
+        return node.key;
+    }
+};
+
+struct transparent_string_hash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>()(str); }
+};
+
+struct data_raw_siuset_node : public itru::sharable_intrusive_unordered_set_hook<data_raw_siuset_node, itru::raw_link_t>
+{
+    std::string key;
+
+    explicit data_raw_siuset_node(const std::string& input_key) : key(input_key) {}
+};
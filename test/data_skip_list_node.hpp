@@ -0,0 +1,30 @@
+#pragma once
+
+#include <arba/itru/concurrent_intrusive_skip_list_hook.hpp>
+#include <arba/itru/intrusive_ref_counter.hpp>
+
+#include <atomic>
+
+struct data_skip_list_node : public itru::intrusive_ref_counter<>,
+                             public itru::concurrent_intrusive_skip_list_hook<data_skip_list_node>
+{
+    int key = 0;
+    std::atomic<int>* alive_count = nullptr;
+
+    explicit data_skip_list_node(int input_key) : key(input_key) {}
+    explicit data_skip_list_node(std::atomic<int>& count, int input_key) : key(input_key), alive_count(&count)
+    {
+        ++count;
+    }
+
+    ~data_skip_list_node()
+    {
+        if (alive_count)
+            --*alive_count;
+    }
+};
+
+struct data_skip_list_node_key_of
+{
+    int operator()(const data_skip_list_node& node) const noexcept { return node.key; }
+};
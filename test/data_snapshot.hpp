@@ -0,0 +1,25 @@
+#pragma once
+
+#include <arba/itru/intrusive_ref_counter.hpp>
+
+#include <atomic>
+
+struct data_snapshot : public itru::intrusive_ref_counter<>
+{
+    int version = 0;
+    int checksum = 0;
+    std::atomic<int>* alive_count = nullptr;
+
+    explicit data_snapshot(int input_version) : version(input_version), checksum(-input_version) {}
+    explicit data_snapshot(std::atomic<int>& count, int input_version)
+        : version(input_version), checksum(-input_version), alive_count(&count)
+    {
+        ++count;
+    }
+
+    ~data_snapshot()
+    {
+        if (alive_count)
+            --*alive_count;
+    }
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <arba/itru/intrusive_ref_counter.hpp>
+#include <arba/itru/timer_wheel_hook.hpp>
+
+#include <string>
+
+struct data_timer_node : public itru::intrusive_ref_counters<>,
+                         public itru::timer_wheel_hook<data_timer_node>
+{
+    std::string name;
+    bool* valid = nullptr;
+
+    data_timer_node() {}
+
+    explicit data_timer_node(bool& bval, const std::string& input_name) : name(input_name), valid(&bval)
+    {
+        bval = true;
+    }
+    explicit data_timer_node(const std::string& input_name) : name(input_name) {}
+
+    ~data_timer_node()
+    {
+        if (valid)
+        {
+            *valid = false;
+        }
+    }
+};
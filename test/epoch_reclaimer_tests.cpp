@@ -0,0 +1,74 @@
+#include <arba/itru/epoch_reclaimer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+//----------------------------------------------------------------
+
+namespace
+{
+std::atomic<int> reclaimed_count = 0;
+
+void count_reclaim(void*)
+{
+    ++reclaimed_count;
+}
+} // namespace
+
+TEST(epoch_reclaimer_tests, test_synchronize__no_guard__retired_reclaimed)
+{
+    reclaimed_count = 0;
+    int element = 0;
+    itru::epoch_reclaimer::retire(&element, &count_reclaim);
+    itru::epoch_reclaimer::synchronize();
+    ASSERT_EQ(reclaimed_count, 1);
+}
+
+TEST(epoch_reclaimer_tests, test_collect__guard_in_other_thread__reclaim_deferred)
+{
+    itru::epoch_reclaimer::synchronize();
+    reclaimed_count = 0;
+    std::atomic<int> step = 0;
+    std::thread reader(
+        [&]
+        {
+            itru::epoch_guard guard;
+            step = 1;
+            while (step != 2)
+                std::this_thread::yield();
+        });
+    while (step != 1)
+        std::this_thread::yield();
+
+    int element = 0;
+    itru::epoch_reclaimer::retire(&element, &count_reclaim);
+    for (int i = 0; i < 4; ++i)
+        itru::epoch_reclaimer::collect();
+    ASSERT_EQ(reclaimed_count, 0);
+
+    step = 2;
+    reader.join();
+    itru::epoch_reclaimer::synchronize();
+    ASSERT_EQ(reclaimed_count, 1);
+}
+
+TEST(epoch_reclaimer_tests, test_guard__nested__epoch_can_advance_after_outer_guard)
+{
+    itru::epoch_reclaimer::synchronize();
+    reclaimed_count = 0;
+    int element = 0;
+    {
+        itru::epoch_guard outer_guard;
+        {
+            itru::epoch_guard inner_guard;
+        }
+        itru::epoch_reclaimer::retire(&element, &count_reclaim);
+        itru::epoch_reclaimer::collect();
+        itru::epoch_reclaimer::collect();
+        ASSERT_EQ(reclaimed_count, 0);
+    }
+    itru::epoch_reclaimer::synchronize();
+    ASSERT_EQ(reclaimed_count, 1);
+}
@@ -0,0 +1,136 @@
+#include "data_intern_node.hpp"
+#include <arba/itru/intern_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_intern_pool = itru::intern_pool<data_intern_node, data_intern_node_key_of>;
+using transparent_data_intern_pool =
+    itru::intern_pool<data_intern_node, data_intern_node_key_of, transparent_text_hash, std::equal_to<>>;
+
+auto factory_of(std::string_view text)
+{
+    return [text] { return itru::make_shared_intrusive_ptr<data_intern_node>(text); };
+}
+} // namespace
+
+TEST(intern_pool_tests, test_intern__same_key__same_element)
+{
+    data_intern_pool pool;
+    int factory_call_count = 0;
+    auto factory = [&]
+    {
+        ++factory_call_count;
+        return itru::make_shared_intrusive_ptr<data_intern_node>("abc");
+    };
+    auto first = pool.intern(std::string("abc"), factory);
+    auto second = pool.intern(std::string("abc"), factory);
+    auto other = pool.intern(std::string("xyz"), factory_of("xyz"));
+    ASSERT_EQ(first, second);
+    ASSERT_NE(first, other);
+    ASSERT_EQ(factory_call_count, 1);
+    ASSERT_EQ(first->use_count(), 2);
+    ASSERT_EQ(first->latent_count(), 1);
+    ASSERT_EQ(pool.size(), 2);
+}
+
+TEST(intern_pool_tests, test_intern__dropped_element__recreated)
+{
+    data_intern_pool pool;
+    bool valid = false;
+    pool.intern(std::string("abc"), [&] { return itru::make_shared_intrusive_ptr<data_intern_node>(valid, "abc"); });
+    ASSERT_TRUE(valid);
+    ASSERT_EQ(pool.find(std::string("abc")), nullptr);
+
+    bool new_valid = false;
+    auto element = pool.intern(std::string("abc"),
+                               [&] { return itru::make_shared_intrusive_ptr<data_intern_node>(new_valid, "abc"); });
+    ASSERT_FALSE(valid);
+    ASSERT_TRUE(new_valid);
+    ASSERT_EQ(pool.find(std::string("abc")), element);
+    ASSERT_EQ(pool.size(), 1);
+}
+
+TEST(intern_pool_tests, test_purge__dropped_elements__memory_released)
+{
+    data_intern_pool pool;
+    bool valid = false;
+    bool kept_valid = false;
+    pool.intern(std::string("dropped"),
+                [&] { return itru::make_shared_intrusive_ptr<data_intern_node>(valid, "dropped"); });
+    auto kept = pool.intern(std::string("kept"),
+                            [&] { return itru::make_shared_intrusive_ptr<data_intern_node>(kept_valid, "kept"); });
+    ASSERT_TRUE(valid);
+    ASSERT_EQ(pool.purge(), 1);
+    ASSERT_FALSE(valid);
+    ASSERT_TRUE(kept_valid);
+    ASSERT_EQ(pool.size(), 1);
+}
+
+TEST(intern_pool_tests, test_intern__many_dropped_elements__swept_in_batch)
+{
+    data_intern_pool pool;
+    for (int i = 0; i < 10'000; ++i)
+    {
+        const std::string text = std::to_string(i);
+        pool.intern(text, factory_of(text));
+    }
+    ASSERT_LE(pool.size(), 16 * data_intern_pool::min_sweep_threshold);
+}
+
+TEST(intern_pool_tests, test_intern__transparent_key__no_key_conversion)
+{
+    transparent_data_intern_pool pool;
+    auto element = pool.intern(std::string_view("abc"), factory_of("abc"));
+    ASSERT_EQ(pool.find(std::string_view("abc")), element);
+    ASSERT_EQ(pool.intern(std::string_view("abc"), factory_of("abc")), element);
+}
+
+TEST(intern_pool_tests, test_destructor__element_outlives_pool__element_kept)
+{
+    bool valid = false;
+    itru::shared_intrusive_ptr<data_intern_node> element;
+    {
+        data_intern_pool pool;
+        element = pool.intern(std::string("abc"),
+                              [&] { return itru::make_shared_intrusive_ptr<data_intern_node>(valid, "abc"); });
+    }
+    ASSERT_TRUE(valid);
+    ASSERT_EQ(element->latent_count(), 0);
+    element = nullptr;
+    ASSERT_FALSE(valid);
+}
+
+TEST(intern_pool_tests, test_intern__concurrent_threads__one_element_per_key)
+{
+    constexpr int thread_count = 4;
+    constexpr int key_count = 200;
+    data_intern_pool pool;
+    std::vector<std::vector<itru::shared_intrusive_ptr<data_intern_node>>> results(thread_count);
+    std::vector<std::thread> threads;
+    for (int thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        threads.emplace_back(
+            [&, thread_index]
+            {
+                for (int i = 0; i < key_count; ++i)
+                {
+                    const std::string text = std::to_string(i);
+                    results[thread_index].push_back(pool.intern(text, factory_of(text)));
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    for (int thread_index = 1; thread_index < thread_count; ++thread_index)
+        ASSERT_EQ(results[thread_index], results[0]);
+    ASSERT_EQ(pool.size(), key_count);
+}
@@ -0,0 +1,178 @@
+#include "data_lru_cache_node.hpp"
+#include <arba/itru/intrusive_lru_cache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_lru_cache = itru::intrusive_lru_cache<std::string, data_lru_cache_node>;
+
+itru::shared_intrusive_ptr<data_lru_cache_node> make_node(const std::string& text)
+{
+    return itru::make_shared_intrusive_ptr<data_lru_cache_node>(text);
+}
+
+// Hashes as std::hash, and throws once calls_before_failure calls have been made (never while it is negative).
+struct throwing_string_hash
+{
+    static inline int calls_before_failure = -1;
+
+    std::size_t operator()(const std::string& key) const
+    {
+        if (calls_before_failure >= 0 && calls_before_failure-- == 0)
+            throw std::runtime_error("hash failed");
+        return std::hash<std::string>()(key);
+    }
+};
+} // namespace
+
+TEST(intrusive_lru_cache_tests, constructor__max_size__empty)
+{
+    data_lru_cache cache(4);
+    ASSERT_TRUE(cache.empty());
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.weight(), 0);
+    ASSERT_EQ(cache.max_size(), 4);
+    ASSERT_EQ(cache.max_weight(), data_lru_cache::unlimited);
+    ASSERT_EQ(cache.get("none"), nullptr);
+    ASSERT_EQ(cache.stats().miss_count, 1);
+}
+
+TEST(intrusive_lru_cache_tests, get__cached_keys__hits_and_misses_counted)
+{
+    data_lru_cache cache(4);
+    cache.put("a", make_node("A"));
+    cache.put("b", make_node("B"));
+    ASSERT_EQ(cache.get("a")->text, "A");
+    ASSERT_EQ(cache.get("b")->text, "B");
+    ASSERT_EQ(cache.get("c"), nullptr);
+    ASSERT_EQ(cache.stats().hit_count, 2);
+    ASSERT_EQ(cache.stats().miss_count, 1);
+    ASSERT_EQ(cache.stats().eviction_count, 0);
+    ASSERT_EQ(cache.peek("a")->use_count(), 3);
+    cache.reset_stats();
+    ASSERT_EQ(cache.stats().hit_count, 0);
+}
+
+TEST(intrusive_lru_cache_tests, put__max_size_reached__least_recently_used_evicted)
+{
+    data_lru_cache cache(2);
+    cache.put("a", make_node("A"));
+    cache.put("b", make_node("B"));
+    ASSERT_NE(cache.get("a"), nullptr);
+    cache.put("c", make_node("C"));
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_TRUE(cache.contains("a"));
+    ASSERT_FALSE(cache.contains("b"));
+    ASSERT_TRUE(cache.contains("c"));
+    ASSERT_EQ(cache.stats().eviction_count, 1);
+}
+
+TEST(intrusive_lru_cache_tests, put__existing_key__value_replaced)
+{
+    bool value_1 = false;
+    data_lru_cache cache(2);
+    cache.put("a", itru::make_shared_intrusive_ptr<data_lru_cache_node>(value_1, "A1"));
+    cache.put("b", make_node("B"));
+    cache.put("a", make_node("A2"));
+    ASSERT_FALSE(value_1);
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(cache.peek("a")->text, "A2");
+    ASSERT_EQ(cache.stats().eviction_count, 0);
+    cache.put("c", make_node("C"));
+    ASSERT_FALSE(cache.contains("b"));
+}
+
+TEST(intrusive_lru_cache_tests, put__max_weight_reached__entries_evicted)
+{
+    data_lru_cache cache(data_lru_cache::unlimited, 10);
+    cache.put("a", make_node("A"), 4);
+    cache.put("b", make_node("B"), 4);
+    ASSERT_EQ(cache.weight(), 8);
+    cache.put("c", make_node("C"), 5);
+    ASSERT_EQ(cache.weight(), 9);
+    ASSERT_FALSE(cache.contains("a"));
+    cache.set_max_weight(5);
+    ASSERT_EQ(cache.size(), 1);
+    ASSERT_TRUE(cache.contains("c"));
+    cache.put("d", make_node("D"), 6);
+    ASSERT_TRUE(cache.empty());
+    ASSERT_EQ(cache.weight(), 0);
+    ASSERT_EQ(cache.stats().eviction_count, 4);
+}
+
+TEST(intrusive_lru_cache_tests, evict__value_in_use__value_kept_alive)
+{
+    bool value = false;
+    data_lru_cache cache(1);
+    cache.put("a", itru::make_shared_intrusive_ptr<data_lru_cache_node>(value, "A"));
+    itru::shared_intrusive_ptr<data_lru_cache_node> in_use = cache.get("a");
+    cache.put("b", make_node("B"));
+    ASSERT_FALSE(cache.contains("a"));
+    ASSERT_TRUE(value);
+    ASSERT_EQ(in_use->use_count(), 1);
+    ASSERT_EQ(in_use->text, "A");
+    in_use = nullptr;
+    ASSERT_FALSE(value);
+}
+
+TEST(intrusive_lru_cache_tests, get_or_put__factory__called_on_miss_only)
+{
+    data_lru_cache cache(2);
+    int call_count = 0;
+    auto factory = [&call_count]
+    {
+        ++call_count;
+        return make_node("A");
+    };
+    ASSERT_EQ(cache.get_or_put("a", factory)->text, "A");
+    ASSERT_EQ(cache.get_or_put("a", factory)->text, "A");
+    ASSERT_EQ(call_count, 1);
+    ASSERT_EQ(cache.stats().hit_count, 1);
+    ASSERT_EQ(cache.stats().miss_count, 1);
+}
+
+TEST(intrusive_lru_cache_tests, erase_clear__cached_values__values_released)
+{
+    bool value_1 = false;
+    bool value_2 = false;
+    data_lru_cache cache(4);
+    cache.put("a", itru::make_shared_intrusive_ptr<data_lru_cache_node>(value_1, "A"), 2);
+    cache.put("b", itru::make_shared_intrusive_ptr<data_lru_cache_node>(value_2, "B"), 3);
+    ASSERT_TRUE(cache.erase("a"));
+    ASSERT_FALSE(cache.erase("a"));
+    ASSERT_FALSE(value_1);
+    ASSERT_EQ(cache.weight(), 3);
+    cache.clear();
+    ASSERT_FALSE(value_2);
+    ASSERT_TRUE(cache.empty());
+    ASSERT_EQ(cache.weight(), 0);
+}
+
+TEST(intrusive_lru_cache_tests, put__throwing_hasher__cache_consistent)
+{
+    bool value = false;
+    {
+        itru::intrusive_lru_cache<std::string, data_lru_cache_node, throwing_string_hash> cache(2);
+        cache.put("a", make_node("A"));
+        cache.put("b", make_node("B"), 3);
+        // The lookup of the replaced entry succeeds, the index insertion throws.
+        throwing_string_hash::calls_before_failure = 1;
+        ASSERT_THROW(cache.put("c", itru::make_shared_intrusive_ptr<data_lru_cache_node>(value, "C")),
+                     std::runtime_error);
+        ASSERT_FALSE(value);
+        ASSERT_EQ(cache.size(), 2);
+        ASSERT_EQ(cache.weight(), 4);
+        ASSERT_FALSE(cache.contains("c"));
+        cache.put("c", make_node("C"));
+        ASSERT_EQ(cache.size(), 2);
+        ASSERT_EQ(cache.weight(), 4);
+        ASSERT_FALSE(cache.contains("a"));
+        ASSERT_EQ(cache.get("b")->text, "B");
+        ASSERT_EQ(cache.get("c")->text, "C");
+    }
+}
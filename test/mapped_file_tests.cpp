@@ -0,0 +1,86 @@
+#include <arba/itru/mapped_file.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+//----------------------------------------------------------------
+
+namespace
+{
+std::string_view as_string_view(std::span<const std::byte> bytes)
+{
+    return std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+// Temporary file holding content, removed at the end of the scope.
+class temporary_file
+{
+public:
+    explicit temporary_file(std::string_view content)
+    {
+        const int fd = ::mkstemp(path_.data());
+        EXPECT_GE(fd, 0);
+        EXPECT_EQ(::write(fd, content.data(), content.size()), ::ssize_t(content.size()));
+        ::close(fd);
+    }
+    ~temporary_file() { ::unlink(path_.c_str()); }
+
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_ = "/tmp/itru_mapped_file_XXXXXX";
+};
+} // namespace
+
+TEST(mapped_file_tests, test_open__file__content_mapped)
+{
+    temporary_file file("line 1\nline 2\n");
+    itru::shared_intrusive_ptr mapping = itru::mapped_file::open(file.path());
+    ASSERT_EQ(mapping->size(), 14);
+    ASSERT_EQ(as_string_view(mapping->bytes()), "line 1\nline 2\n");
+    ASSERT_EQ(mapping->use_count(), 1);
+}
+
+TEST(mapped_file_tests, test_view__file_released__mapping_kept_alive)
+{
+    temporary_file file("key=value");
+    itru::mapped_file_view value;
+    {
+        itru::mapped_file_view content(itru::mapped_file::open(file.path()));
+        itru::mapped_file_view key = content.split_front(3);
+        content.remove_prefix(1);
+        value = content;
+        ASSERT_EQ(as_string_view(key.bytes()), "key");
+        ASSERT_EQ(value.file()->use_count(), 3);
+    }
+    ASSERT_EQ(value.file()->use_count(), 1);
+    ASSERT_EQ(as_string_view(value.bytes()), "value");
+}
+
+TEST(mapped_file_tests, test_open__options__hints_applied)
+{
+    const std::string content(3 * 4096 + 5, 'x');
+    temporary_file file(content);
+    itru::shared_intrusive_ptr mapping = itru::mapped_file::open(
+        file.path(), { .advice = itru::access_advice::sequential, .huge_page_aligned = true });
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(mapping->data()) % itru::mapped_file::huge_page_size, 0);
+    ASSERT_EQ(as_string_view(mapping->bytes()), content);
+    ASSERT_TRUE(mapping->advise(itru::access_advice::will_need, 4097, 10));
+    ASSERT_TRUE(mapping->advise(itru::access_advice::random));
+}
+
+TEST(mapped_file_tests, test_open__empty_or_missing_file__empty_or_throws)
+{
+    temporary_file file("");
+    itru::shared_intrusive_ptr mapping = itru::mapped_file::open(file.path());
+    ASSERT_EQ(mapping->size(), 0);
+    ASSERT_EQ(mapping->data(), nullptr);
+    ASSERT_TRUE(itru::mapped_file_view(mapping).empty());
+    ASSERT_THROW(itru::mapped_file::open(file.path() + "_missing"), std::system_error);
+}
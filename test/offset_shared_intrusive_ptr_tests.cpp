@@ -0,0 +1,139 @@
+#include "data_offset_node.hpp"
+#include <arba/itru/offset_shared_intrusive_ptr.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+//----------------------------------------------------------------
+
+namespace
+{
+std::string unique_segment_name()
+{
+    static int segment_index = 0;
+    return "/itru_test_" + std::to_string(::getpid()) + "_" + std::to_string(segment_index++);
+}
+
+// Values of the list starting at node, in order.
+std::vector<int> list_values(itru::offset_shared_intrusive_ptr<data_offset_node> node)
+{
+    std::vector<int> values;
+    for (; node; node = node->next)
+        values.push_back(node->value);
+    return values;
+}
+} // namespace
+
+TEST(offset_shared_intrusive_ptr_tests, test_make__released__block_reused)
+{
+    const std::string name = unique_segment_name();
+    {
+        itru::shared_segment segment = itru::shared_segment::create(name, 1 << 16);
+        itru::offset_shared_intrusive_ptr node = itru::make_offset_shared_intrusive_ptr<data_offset_node>(segment, 5);
+        ASSERT_TRUE(segment.contains(node.get()));
+        ASSERT_EQ(node->value, 5);
+        ASSERT_EQ(node->use_count(), 1);
+        itru::offset_shared_intrusive_ptr copy = node;
+        ASSERT_EQ(copy, node);
+        ASSERT_EQ(node->use_count(), 2);
+        const std::size_t used_size = segment.used_size();
+        copy.reset();
+        node.reset();
+        ASSERT_EQ(node, nullptr);
+        node = itru::make_offset_shared_intrusive_ptr<data_offset_node>(segment, 7);
+        ASSERT_EQ(segment.used_size(), used_size);
+    }
+    ASSERT_TRUE(itru::shared_segment::remove(name));
+}
+
+TEST(offset_shared_intrusive_ptr_tests, test_segment_root__other_mapping__same_list)
+{
+    const std::string name = unique_segment_name();
+    {
+        itru::shared_segment segment = itru::shared_segment::create(name, 1 << 16);
+        itru::offset_shared_intrusive_ptr<data_offset_node> head;
+        for (int value = 3; value > 0; --value)
+            head = itru::make_offset_shared_intrusive_ptr<data_offset_node>(segment, value, head);
+        itru::set_segment_root(segment, head);
+        ASSERT_EQ(head->use_count(), 2);
+
+        itru::shared_segment other_segment = itru::shared_segment::open(name);
+        ASSERT_NE(other_segment.base(), segment.base());
+        itru::offset_shared_intrusive_ptr other_head = itru::segment_root<data_offset_node>(other_segment);
+        ASSERT_TRUE(other_segment.contains(other_head.get()));
+        ASSERT_EQ(reinterpret_cast<std::byte*>(other_head.get()) - other_segment.base(),
+                  reinterpret_cast<std::byte*>(head.get()) - segment.base());
+        ASSERT_EQ(list_values(other_head), (std::vector<int>{ 1, 2, 3 }));
+        ASSERT_EQ(head->use_count(), 3);
+
+        head.reset();
+        other_head.reset();
+        itru::set_segment_root(segment, itru::offset_shared_intrusive_ptr<data_offset_node>());
+        ASSERT_EQ(segment.root(), nullptr);
+    }
+    ASSERT_TRUE(itru::shared_segment::remove(name));
+}
+
+TEST(offset_shared_intrusive_ptr_tests, test_segment_root__other_process__list_shared)
+{
+    const std::string name = unique_segment_name();
+    {
+        itru::shared_segment segment = itru::shared_segment::create(name, 1 << 16);
+        itru::set_segment_root(segment, itru::make_offset_shared_intrusive_ptr<data_offset_node>(segment, 2));
+
+        const pid_t child = ::fork();
+        ASSERT_NE(child, -1);
+        if (child == 0)
+        {
+            // The child pushes a node in front of the list it reads, then updates the root.
+            int status = 1;
+            try
+            {
+                itru::shared_segment child_segment = itru::shared_segment::open(name);
+                itru::offset_shared_intrusive_ptr head = itru::segment_root<data_offset_node>(child_segment);
+                if (list_values(head) == std::vector<int>{ 2 })
+                {
+                    itru::set_segment_root(child_segment, itru::make_offset_shared_intrusive_ptr<data_offset_node>(
+                                                              child_segment, 1, head));
+                    status = 0;
+                }
+            }
+            catch (...)
+            {
+            }
+            ::_exit(status);
+        }
+        int status = 0;
+        ASSERT_EQ(::waitpid(child, &status, 0), child);
+        ASSERT_TRUE(WIFEXITED(status));
+        ASSERT_EQ(WEXITSTATUS(status), 0);
+
+        itru::offset_shared_intrusive_ptr head = itru::segment_root<data_offset_node>(segment);
+        ASSERT_EQ(list_values(head), (std::vector<int>{ 1, 2 }));
+        ASSERT_EQ(head->use_count(), 2);
+        ASSERT_EQ(head->next->use_count(), 1);
+    }
+    ASSERT_TRUE(itru::shared_segment::remove(name));
+}
+
+TEST(offset_shared_intrusive_ptr_tests, test_make__segment_full__bad_alloc)
+{
+    const std::string name = unique_segment_name();
+    {
+        itru::shared_segment segment = itru::shared_segment::create(name, 4096);
+        std::vector<itru::offset_shared_intrusive_ptr<data_offset_node>> nodes;
+        ASSERT_THROW(
+            for (;;) nodes.push_back(itru::make_offset_shared_intrusive_ptr<data_offset_node>(segment, 0)),
+            std::bad_alloc);
+        ASSERT_FALSE(nodes.empty());
+        nodes.pop_back();
+        ASSERT_NO_THROW(nodes.push_back(itru::make_offset_shared_intrusive_ptr<data_offset_node>(segment, 0)));
+    }
+    ASSERT_TRUE(itru::shared_segment::remove(name));
+    ASSERT_THROW(itru::shared_segment::open(name), std::system_error);
+}
@@ -0,0 +1,141 @@
+#include "data_silist_node.hpp"
+#include <arba/itru/parallel_list_algorithm.hpp>
+#include <arba/itru/sharable_intrusive_list.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_silist = itru::sharable_intrusive_list<data_silist_node>;
+
+void fill(data_silist& list, int count, bool* valids = nullptr)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        if (valids)
+            list.emplace_back(valids[i], std::to_string(i));
+        else
+        {
+            list.emplace_back();
+            list.back().text = std::to_string(i);
+        }
+    }
+}
+
+std::vector<std::string> texts(const data_silist& list)
+{
+    std::vector<std::string> texts;
+    for (const data_silist_node& node : list)
+        texts.push_back(node.text);
+    return texts;
+}
+} // namespace
+
+TEST(parallel_list_algorithm_tests, test_list_chunks__list__one_pass_boundaries)
+{
+    data_silist list;
+    fill(list, 10);
+    itru::list_chunks chunks(list, 4);
+    ASSERT_EQ(chunks.size(), 3);
+    ASSERT_EQ(chunks.element_count(), 10);
+    ASSERT_EQ(chunks.chunk_begin(0)->text, "0");
+    ASSERT_EQ(chunks.chunk_begin(1)->text, "4");
+    ASSERT_EQ(chunks.chunk_begin(2)->text, "8");
+    ASSERT_EQ(chunks.chunk_end(2), list.end());
+    ASSERT_EQ(chunks.chunk_offset(2), 8);
+}
+
+TEST(parallel_list_algorithm_tests, test_parallel_for_each__list__every_element_visited_once)
+{
+    data_silist list;
+    fill(list, 1000);
+    itru::parallel_for_each(list, [](data_silist_node& node) { node.text += "!"; },
+                            itru::parallel_options{ .thread_count = 4, .chunk_size = 7 });
+    int index = 0;
+    for (const data_silist_node& node : list)
+        ASSERT_EQ(node.text, std::to_string(index++) + "!");
+}
+
+TEST(parallel_list_algorithm_tests, test_parallel_transform_reduce__various_chunk_sizes__same_result)
+{
+    data_silist list;
+    fill(list, 1000);
+    const auto to_int = [](const data_silist_node& node) { return std::stoll(node.text); };
+    for (std::size_t chunk_size : { 0, 1, 7, 1000, 5000 })
+    {
+        const long long sum = itru::parallel_transform_reduce(
+            list, 5LL, std::plus<>(), to_int, itru::parallel_options{ .thread_count = 3, .chunk_size = chunk_size });
+        ASSERT_EQ(sum, 5 + 999 * 1000 / 2);
+    }
+    // Associative but not commutative: the chunks are reduced in list order.
+    const std::string concatenation = itru::parallel_transform_reduce(
+        list, std::string(), std::plus<>(), [](const data_silist_node& node) { return node.text; },
+        itru::parallel_options{ .thread_count = 4, .chunk_size = 3 });
+    std::string expected;
+    for (int i = 0; i < 1000; ++i)
+        expected += std::to_string(i);
+    ASSERT_EQ(concatenation, expected);
+
+    data_silist empty_list;
+    ASSERT_EQ(itru::parallel_transform_reduce(empty_list, 5LL, std::plus<>(), to_int), 5);
+}
+
+TEST(parallel_list_algorithm_tests, test_parallel_remove_if__owning_list__erased_and_released)
+{
+    constexpr int count = 500;
+    std::unique_ptr<bool[]> valids(new bool[count]);
+    data_silist list;
+    fill(list, count, valids.get());
+    itru::shared_intrusive_ptr<data_silist_node> held = std::next(list.begin(), 10).make_intrusive_shared();
+
+    const auto erased_count = itru::parallel_remove_if(
+        list, [](const data_silist_node& node) { return std::stoi(node.text) % 2 == 0; },
+        itru::parallel_options{ .thread_count = 4, .chunk_size = 16 });
+    ASSERT_EQ(erased_count, count / 2);
+    ASSERT_EQ(list.size(), count / 2);
+    std::vector<std::string> expected;
+    for (int i = 1; i < count; i += 2)
+        expected.push_back(std::to_string(i));
+    ASSERT_EQ(texts(list), expected);
+    for (int i = 0; i < count; ++i)
+        ASSERT_EQ(valids[i], i % 2 == 1 || i == 10) << i;
+    ASSERT_EQ(held->use_count(), 1);
+}
+
+TEST(parallel_list_algorithm_tests, test_parallel_remove_if__raw_link_list__erased)
+{
+    std::vector<data_raw_silist_node> nodes;
+    for (int i = 0; i < 100; ++i)
+        nodes.emplace_back(std::to_string(i));
+    itru::sharable_intrusive_list<data_raw_silist_node> list;
+    for (data_raw_silist_node& node : nodes)
+        list.push_back(&node);
+    const auto erased_count = itru::parallel_remove_if(
+        list, [](const data_raw_silist_node& node) { return node.text.size() == 1; },
+        itru::parallel_options{ .thread_count = 2, .chunk_size = 8 });
+    ASSERT_EQ(erased_count, 10);
+    ASSERT_EQ(list.size(), 90);
+    ASSERT_EQ(list.front().text, "10");
+}
+
+TEST(parallel_list_algorithm_tests, test_parallel_for_each__throwing_function__exception_rethrown)
+{
+    data_silist list;
+    fill(list, 100);
+    ASSERT_THROW(itru::parallel_for_each(
+                     list,
+                     [](const data_silist_node& node)
+                     {
+                         if (node.text == "42")
+                             throw std::runtime_error("42");
+                     },
+                     itru::parallel_options{ .thread_count = 4, .chunk_size = 5 }),
+                 std::runtime_error);
+}
@@ -0,0 +1,169 @@
+#include <arba/itru/persistent_map.hpp>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using int_map = itru::persistent_map<int, std::string>;
+
+std::map<int, std::string> ordered(const int_map& map)
+{
+    std::map<int, std::string> entries;
+    for (const auto& [key, value] : map)
+        entries.emplace(key, value);
+    return entries;
+}
+
+struct constant_hash
+{
+    std::size_t operator()(int) const noexcept { return 42; }
+};
+
+// All the keys share the first slot of the root. Throws on the call following calls_before_failure successful ones.
+struct throwing_hash
+{
+    static inline int calls_before_failure = -1;
+
+    std::size_t operator()(int key) const
+    {
+        if (calls_before_failure >= 0 && calls_before_failure-- == 0)
+            throw std::runtime_error("throwing_hash");
+        return std::size_t(key) << int_map::bits_per_level;
+    }
+};
+} // namespace
+
+TEST(persistent_map_tests, set_erase__random_operations__same_as_std_unordered_map)
+{
+    std::mt19937 engine(7);
+    std::uniform_int_distribution<int> key_distribution(0, 2000);
+    int_map map;
+    std::unordered_map<int, std::string> expected_map;
+    for (int i = 0; i < 20000; ++i)
+    {
+        const int key = key_distribution(engine);
+        if (engine() % 3 == 0)
+        {
+            map = std::move(map).erase(key);
+            expected_map.erase(key);
+        }
+        else
+        {
+            map = map.set(key, std::to_string(i));
+            expected_map.insert_or_assign(key, std::to_string(i));
+        }
+    }
+    ASSERT_EQ(map.size(), expected_map.size());
+    for (const auto& [key, value] : expected_map)
+    {
+        const std::string* found = map.find(key);
+        ASSERT_NE(found, nullptr);
+        ASSERT_EQ(*found, value);
+    }
+    ASSERT_EQ(ordered(map), (std::map<int, std::string>(expected_map.begin(), expected_map.end())));
+    ASSERT_FALSE(map.contains(-1));
+}
+
+TEST(persistent_map_tests, set_erase__old_versions__unchanged)
+{
+    int_map empty_map;
+    int_map map_1 = empty_map.set(1, "one").set(2, "two");
+    int_map map_2 = map_1.set(2, "deux").set(3, "three");
+    int_map map_3 = map_2.erase(1);
+    int_map map_4 = map_3.erase(42);
+
+    ASSERT_TRUE(empty_map.empty());
+    ASSERT_EQ(ordered(map_1), (std::map<int, std::string>{ { 1, "one" }, { 2, "two" } }));
+    ASSERT_EQ(ordered(map_2), (std::map<int, std::string>{ { 1, "one" }, { 2, "deux" }, { 3, "three" } }));
+    ASSERT_EQ(ordered(map_3), (std::map<int, std::string>{ { 2, "deux" }, { 3, "three" } }));
+    ASSERT_EQ(ordered(map_4), ordered(map_3));
+}
+
+TEST(persistent_map_tests, transient__batch_modifications__source_unchanged)
+{
+    int_map map;
+    for (int i = 0; i < 1000; ++i)
+        map = std::move(map).set(i, std::to_string(i));
+
+    int_map::transient_type transient = map.transient();
+    for (int i = 0; i < 1000; i += 2)
+        ASSERT_TRUE(transient.erase(i));
+    ASSERT_FALSE(transient.erase(0));
+    ASSERT_FALSE(transient.set(1, "one"));
+    ASSERT_TRUE(transient.set(2000, "2000"));
+    int_map edited_map = transient.persistent();
+    transient.set(3, "three");
+
+    ASSERT_EQ(map.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+        ASSERT_EQ(*map.find(i), std::to_string(i));
+    ASSERT_EQ(edited_map.size(), 501);
+    ASSERT_FALSE(edited_map.contains(0));
+    ASSERT_EQ(*edited_map.find(1), "one");
+    ASSERT_EQ(*edited_map.find(3), "3");
+    ASSERT_EQ(*edited_map.find(2000), "2000");
+    ASSERT_EQ(*transient.find(3), "three");
+}
+
+TEST(persistent_map_tests, set_erase__colliding_hash_codes__ok)
+{
+    itru::persistent_map<int, int, constant_hash> map;
+    for (int i = 0; i < 10; ++i)
+        map = map.set(i, i * i);
+    itru::persistent_map<int, int, constant_hash> map_without_5 = map.erase(5);
+    ASSERT_EQ(map.size(), 10);
+    ASSERT_EQ(map_without_5.size(), 9);
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_EQ(*map.find(i), i * i);
+        ASSERT_EQ(map_without_5.contains(i), i != 5);
+    }
+    for (int i = 0; i < 10; ++i)
+        map_without_5 = map_without_5.erase(i);
+    ASSERT_TRUE(map_without_5.empty());
+    ASSERT_EQ(map_without_5.begin(), map_without_5.end());
+}
+
+TEST(persistent_map_tests, set__hasher_throws_on_slot_collision__transient_unchanged)
+{
+    itru::persistent_map<int, int, throwing_hash>::transient_type transient =
+        itru::persistent_map<int, int, throwing_hash>().transient();
+    transient.set(1, 10);
+    // The key is hashed, then the key already in its slot, to push them down in a new child.
+    throwing_hash::calls_before_failure = 1;
+    ASSERT_THROW(transient.set(2, 20), std::runtime_error);
+    throwing_hash::calls_before_failure = -1;
+    ASSERT_EQ(transient.size(), 1);
+    ASSERT_EQ(*transient.find(1), 10);
+    ASSERT_FALSE(transient.contains(2));
+
+    ASSERT_TRUE(transient.set(2, 20));
+    ASSERT_EQ(transient.size(), 2);
+    ASSERT_EQ(*transient.find(1), 10);
+    ASSERT_EQ(*transient.find(2), 20);
+}
+
+TEST(persistent_map_tests, destructor__many_versions__ok)
+{
+    std::vector<int_map> versions;
+    int_map map;
+    for (int i = 0; i < 100000; ++i)
+    {
+        map = std::move(map).set(i, {});
+        if (i % 1000 == 0)
+            versions.push_back(map);
+    }
+    ASSERT_EQ(map.size(), 100000);
+    versions.clear();
+    map = int_map();
+    ASSERT_TRUE(map.empty());
+}
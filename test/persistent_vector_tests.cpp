@@ -0,0 +1,192 @@
+#include <arba/itru/persistent_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+// The allocation following allocations_before_failure successful ones throws std::bad_alloc.
+int allocations_before_failure = -1;
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    if (allocations_before_failure >= 0 && allocations_before_failure-- == 0)
+        throw std::bad_alloc();
+    if (void* address = std::malloc(size != 0 ? size : 1))
+        return address;
+    throw std::bad_alloc();
+}
+
+// GCC mistakes the inlined free() of the replacement operator delete for a mismatch with operator new.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* address) noexcept
+{
+    std::free(address);
+}
+
+void operator delete(void* address, std::size_t) noexcept
+{
+    std::free(address);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+//----------------------------------------------------------------
+
+namespace
+{
+using string_vector = itru::persistent_vector<std::string>;
+
+std::vector<std::string> to_std_vector(const string_vector& vector)
+{
+    return std::vector<std::string>(vector.begin(), vector.end());
+}
+} // namespace
+
+TEST(persistent_vector_tests, push_back_pop_back_set__random_operations__same_as_std_vector)
+{
+    std::mt19937 engine(11);
+    string_vector vector;
+    std::vector<std::string> expected_vector;
+    for (int i = 0; i < 50000; ++i)
+    {
+        const unsigned operation = engine() % 8;
+        if (operation == 0 && !expected_vector.empty())
+        {
+            vector = vector.pop_back();
+            expected_vector.pop_back();
+        }
+        else if (operation == 1 && !expected_vector.empty())
+        {
+            const std::size_t index = engine() % expected_vector.size();
+            vector = std::move(vector).set(index, std::to_string(i));
+            expected_vector[index] = std::to_string(i);
+        }
+        else
+        {
+            vector = vector.push_back(std::to_string(i));
+            expected_vector.push_back(std::to_string(i));
+        }
+    }
+    ASSERT_EQ(vector.size(), expected_vector.size());
+    for (std::size_t i = 0; i < expected_vector.size(); ++i)
+        ASSERT_EQ(vector[i], expected_vector[i]);
+    ASSERT_EQ(to_std_vector(vector), expected_vector);
+
+    while (!expected_vector.empty())
+    {
+        vector = std::move(vector).pop_back();
+        expected_vector.pop_back();
+        if (!expected_vector.empty())
+        {
+            ASSERT_EQ(vector.back(), expected_vector.back());
+        }
+    }
+    ASSERT_TRUE(vector.empty());
+}
+
+TEST(persistent_vector_tests, push_back_set__old_versions__unchanged)
+{
+    std::vector<string_vector> versions(1);
+    for (int i = 0; i < 2000; ++i)
+        versions.push_back(versions.back().push_back(std::to_string(i)));
+    string_vector modified_vector = versions.back().set(0, "zero").set(1500, "1500!").pop_back();
+
+    for (std::size_t i = 0; i < versions.size(); ++i)
+    {
+        ASSERT_EQ(versions[i].size(), i);
+        for (std::size_t j = 0; j < i; ++j)
+            ASSERT_EQ(versions[i][j], std::to_string(j));
+    }
+    ASSERT_EQ(modified_vector.size(), 1999);
+    ASSERT_EQ(modified_vector.front(), "zero");
+    ASSERT_EQ(modified_vector[1500], "1500!");
+    ASSERT_EQ(modified_vector.back(), "1998");
+}
+
+TEST(persistent_vector_tests, transient__batch_modifications__source_unchanged)
+{
+    string_vector vector;
+    for (int i = 0; i < 1100; ++i)
+        vector = std::move(vector).push_back(std::to_string(i));
+
+    string_vector::transient_type transient = vector.transient();
+    for (std::size_t i = 0; i < transient.size(); i += 3)
+        transient.set(i, "x");
+    for (int i = 0; i < 100; ++i)
+        transient.pop_back();
+    for (int i = 0; i < 50; ++i)
+        transient.push_back("y");
+    string_vector edited_vector = transient.persistent();
+    transient.set(0, "z");
+
+    ASSERT_EQ(vector.size(), 1100);
+    for (std::size_t i = 0; i < vector.size(); ++i)
+        ASSERT_EQ(vector[i], std::to_string(i));
+    ASSERT_EQ(edited_vector.size(), 1050);
+    for (std::size_t i = 0; i < 1000; ++i)
+        ASSERT_EQ(edited_vector[i], i % 3 == 0 ? "x" : std::to_string(i));
+    for (std::size_t i = 1000; i < 1050; ++i)
+        ASSERT_EQ(edited_vector[i], "y");
+    ASSERT_EQ(transient[0], "z");
+}
+
+TEST(persistent_vector_tests, push_back__allocation_throws__transient_unchanged)
+{
+    // Sizes where the value goes to the tail, or where the full tail moves to a new root, to a new root level, or to
+    // the last leaf of the trie.
+    for (const int size : { 1, 32, 33, 1056, 1088 })
+    {
+        string_vector vector;
+        for (int i = 0; i < size; ++i)
+            vector = std::move(vector).push_back(std::to_string(i));
+
+        // Every allocation of the push_back, including the copies of the nodes shared with vector, fails in turn.
+        for (int allocation_count = 0;; ++allocation_count)
+        {
+            string_vector::transient_type transient = vector.transient();
+            std::string value = "value";
+            allocations_before_failure = allocation_count;
+            try
+            {
+                transient.push_back(std::move(value));
+                allocations_before_failure = -1;
+                ASSERT_EQ(transient.size(), size + 1);
+                ASSERT_EQ(transient[size], "value");
+                break;
+            }
+            catch (const std::bad_alloc&)
+            {
+                allocations_before_failure = -1;
+            }
+            ASSERT_EQ(to_std_vector(transient.persistent()), to_std_vector(vector));
+            transient.push_back("value");
+            ASSERT_EQ(transient[size], "value");
+        }
+    }
+}
+
+TEST(persistent_vector_tests, destructor__large_vector__ok)
+{
+    itru::persistent_vector<int> vector;
+    itru::persistent_vector<int>::transient_type transient = vector.transient();
+    for (int i = 0; i < 1000000; ++i)
+        transient.push_back(i);
+    vector = std::move(transient).persistent();
+    ASSERT_EQ(vector.size(), 1000000);
+    ASSERT_EQ(vector[123456], 123456);
+    vector = itru::persistent_vector<int>();
+    ASSERT_TRUE(vector.empty());
+}
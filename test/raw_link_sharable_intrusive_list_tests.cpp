@@ -0,0 +1,207 @@
+#include "data_silist_node.hpp"
+#include <arba/itru/sharable_intrusive_list.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using raw_data_silist = itru::sharable_intrusive_list<data_raw_silist_node>;
+
+std::vector<std::string> list_texts(const raw_data_silist& data_islist)
+{
+    std::vector<std::string> texts;
+    for (const auto& item : data_islist)
+        texts.push_back(item.text);
+    return texts;
+}
+
+std::vector<std::string> sorted_list_texts(const raw_data_silist& data_islist)
+{
+    std::vector<std::string> texts = list_texts(data_islist);
+    std::sort(texts.begin(), texts.end());
+    return texts;
+}
+
+// Checks that every previous link matches the next link walked from the sentinel.
+void check_links(const raw_data_silist& data_islist)
+{
+    const data_raw_silist_node* previous = nullptr;
+    for (auto iter = data_islist.begin(); iter != data_islist.end(); ++iter)
+    {
+        if (previous)
+        {
+            ASSERT_EQ(iter->previous(), previous);
+        }
+        previous = &*iter;
+    }
+}
+
+// Compares the texts, and throws at the throw_index-th call.
+struct throwing_text_less
+{
+    int throw_index;
+    int call_count = 0;
+
+    bool operator()(const data_raw_silist_node& lhs, const data_raw_silist_node& rhs)
+    {
+        if (call_count++ == throw_index)
+            throw std::runtime_error("comparison failed");
+        return lhs.text < rhs.text;
+    }
+};
+} // namespace
+
+TEST(raw_link_intrusive_list_tests, hook__raw_link__pointer_size)
+{
+    static_assert(std::is_same_v<data_raw_silist_node::link_type, data_raw_silist_node*>);
+    static_assert(std::is_same_v<raw_data_silist::link_policy_type, itru::raw_link_t>);
+    static_assert(!raw_data_silist::owns_values);
+    ASSERT_EQ(sizeof(itru::sharable_intrusive_list_hook<data_raw_silist_node, itru::raw_link_t>),
+              2 * sizeof(void*));
+}
+
+TEST(raw_link_intrusive_list_tests, constructor__no_arg__no_exception)
+{
+    raw_data_silist data_islist;
+    ASSERT_EQ(data_islist.size(), 0);
+    ASSERT_TRUE(data_islist.empty());
+    ASSERT_EQ(data_islist.begin(), data_islist.end());
+}
+
+TEST(raw_link_intrusive_list_tests, push_back_push_front_insert__valid_args__no_exception)
+{
+    std::array<data_raw_silist_node, 4> nodes = { data_raw_silist_node("1"), data_raw_silist_node("2"),
+                                                  data_raw_silist_node("3"), data_raw_silist_node("4") };
+    raw_data_silist data_islist;
+    data_islist.push_back(&nodes[1]);
+    data_islist.push_back(&nodes[3]);
+    data_islist.push_front(&nodes[0]);
+    auto iter = data_islist.insert(std::next(data_islist.begin(), 2), &nodes[2]);
+    ASSERT_EQ(iter.ptr(), &nodes[2]);
+    ASSERT_EQ(data_islist.size(), 4);
+    ASSERT_EQ(list_texts(data_islist), (std::vector<std::string>{ "1", "2", "3", "4" }));
+    ASSERT_EQ(&data_islist.front(), &nodes[0]);
+    ASSERT_EQ(&data_islist.back(), &nodes[3]);
+    ASSERT_EQ((--data_islist.end())->previous(), &nodes[2]);
+}
+
+TEST(raw_link_intrusive_list_tests, erase_pop__valid_args__nodes_unlinked)
+{
+    std::array<data_raw_silist_node, 4> nodes = { data_raw_silist_node("1"), data_raw_silist_node("2"),
+                                                  data_raw_silist_node("3"), data_raw_silist_node("4") };
+    raw_data_silist data_islist;
+    for (auto& node : nodes)
+        data_islist.push_back(&node);
+    auto iter = data_islist.erase(std::next(data_islist.begin()));
+    ASSERT_EQ(iter.ptr(), &nodes[2]);
+    ASSERT_EQ(nodes[1].previous(), nullptr);
+    ASSERT_EQ(nodes[1].next(), nullptr);
+    data_islist.pop_front();
+    data_islist.pop_back();
+    ASSERT_EQ(nodes[0].previous(), nullptr);
+    ASSERT_EQ(nodes[3].next(), nullptr);
+    ASSERT_EQ(list_texts(data_islist), (std::vector<std::string>{ "3" }));
+    ASSERT_EQ(data_islist.size(), 1);
+}
+
+TEST(raw_link_intrusive_list_tests, unhook__linked_node__node_unlinked)
+{
+    std::array<data_raw_silist_node, 3> nodes = { data_raw_silist_node("1"), data_raw_silist_node("2"),
+                                                  data_raw_silist_node("3") };
+    raw_data_silist data_islist;
+    for (auto& node : nodes)
+        data_islist.push_back(&node);
+    nodes[1].unhook();
+    ASSERT_EQ(nodes[1].previous(), nullptr);
+    ASSERT_EQ(nodes[1].next(), nullptr);
+    ASSERT_EQ(nodes[0].next(), &nodes[2]);
+    ASSERT_EQ(nodes[2].previous(), &nodes[0]);
+}
+
+TEST(raw_link_intrusive_list_tests, splice__sublist__no_exception)
+{
+    std::array<data_raw_silist_node, 6> nodes = { data_raw_silist_node("1"), data_raw_silist_node("2"),
+                                                  data_raw_silist_node("3"), data_raw_silist_node("4"),
+                                                  data_raw_silist_node("5"), data_raw_silist_node("6") };
+    raw_data_silist data_islist;
+    raw_data_silist other_data_islist;
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        data_islist.push_back(&nodes[i]);
+        other_data_islist.push_back(&nodes[i + 3]);
+    }
+    data_islist.splice(data_islist.begin(), other_data_islist, std::next(other_data_islist.begin()),
+                       other_data_islist.end());
+    ASSERT_EQ(list_texts(data_islist), (std::vector<std::string>{ "5", "6", "1", "2", "3" }));
+    ASSERT_EQ(list_texts(other_data_islist), (std::vector<std::string>{ "4" }));
+    data_islist.splice(data_islist.end(), other_data_islist, other_data_islist.begin());
+    ASSERT_EQ(list_texts(data_islist), (std::vector<std::string>{ "5", "6", "1", "2", "3", "4" }));
+    ASSERT_TRUE(other_data_islist.empty());
+    data_islist.swap(other_data_islist);
+    ASSERT_TRUE(data_islist.empty());
+    ASSERT_EQ(list_texts(other_data_islist), (std::vector<std::string>{ "5", "6", "1", "2", "3", "4" }));
+}
+
+TEST(raw_link_intrusive_list_tests, destructor__not_empty_list__nodes_unlinked)
+{
+    std::array<data_raw_silist_node, 2> nodes = { data_raw_silist_node("1"), data_raw_silist_node("2") };
+    {
+        raw_data_silist data_islist;
+        for (auto& node : nodes)
+            data_islist.push_back(&node);
+    }
+    for (auto& node : nodes)
+    {
+        ASSERT_EQ(node.previous(), nullptr);
+        ASSERT_EQ(node.next(), nullptr);
+    }
+}
+
+TEST(raw_link_intrusive_list_tests, sort__throwing_compare__all_nodes_kept)
+{
+    for (int throw_index : { 0, 3, 6, 10 })
+    {
+        std::array<data_raw_silist_node, 8> nodes;
+        raw_data_silist data_islist;
+        for (unsigned i = 0; i < nodes.size(); ++i)
+        {
+            nodes[i].text = std::string(1, char('a' + (i * 5) % 8));
+            data_islist.push_back(&nodes[i]);
+        }
+        ASSERT_THROW(data_islist.sort(throwing_text_less{ throw_index }), std::runtime_error);
+        ASSERT_EQ(data_islist.size(), 8);
+        ASSERT_EQ(sorted_list_texts(data_islist),
+                  (std::vector<std::string>{ "a", "b", "c", "d", "e", "f", "g", "h" }));
+        check_links(data_islist);
+        data_islist.sort(throwing_text_less{ -1 });
+        ASSERT_EQ(list_texts(data_islist), (std::vector<std::string>{ "a", "b", "c", "d", "e", "f", "g", "h" }));
+    }
+}
+
+TEST(raw_link_intrusive_list_tests, merge__throwing_compare__all_nodes_kept)
+{
+    for (int throw_index : { 0, 2, 4 })
+    {
+        std::array<data_raw_silist_node, 6> nodes = { data_raw_silist_node("a"), data_raw_silist_node("c"),
+                                                      data_raw_silist_node("e"), data_raw_silist_node("b"),
+                                                      data_raw_silist_node("d"), data_raw_silist_node("f") };
+        raw_data_silist data_islist;
+        raw_data_silist other_data_islist;
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            data_islist.push_back(&nodes[i]);
+            other_data_islist.push_back(&nodes[i + 3]);
+        }
+        ASSERT_THROW(data_islist.merge(other_data_islist, throwing_text_less{ throw_index }), std::runtime_error);
+        ASSERT_EQ(data_islist.size(), 6);
+        ASSERT_EQ(sorted_list_texts(data_islist), (std::vector<std::string>{ "a", "b", "c", "d", "e", "f" }));
+        check_links(data_islist);
+        ASSERT_TRUE(other_data_islist.empty());
+    }
+}
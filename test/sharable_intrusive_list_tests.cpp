@@ -3,8 +3,23 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <stdexcept>
+
 //----------------------------------------------------------------
 
+namespace
+{
+// Value pointers of the list, read from the back to the front through the previous links.
+std::vector<const bool*> backward_value_pointers(const itru::sharable_intrusive_list<data_silist_node>& list)
+{
+    std::vector<const bool*> value_pointers;
+    for (auto iter = list.end(); iter != list.begin();)
+        value_pointers.push_back((--iter)->valid);
+    return value_pointers;
+}
+} // namespace
+
 TEST(intrusive_list_iter_tests, constructor_abstract__no_arg__no_exception)
 {
     using data_islist_node_siptr = itru::shared_intrusive_ptr<data_silist_node>;
@@ -239,6 +254,29 @@ TEST(intrusive_list_tests, erase__valid_arg__no_exception)
     }
 }
 
+TEST(intrusive_list_tests, extract__valid_arg__owning_link_returned)
+{
+    bool value_1 = false;
+    bool value_2 = false;
+    {
+        itru::sharable_intrusive_list<data_silist_node> data_islist;
+        data_islist.push_back(itru::make_shared_intrusive_ptr<data_silist_node>(value_1, "1"));
+        data_islist.push_back(itru::make_shared_intrusive_ptr<data_silist_node>(value_2, "2"));
+        itru::shared_intrusive_ptr<data_silist_node> extracted = data_islist.extract(data_islist.front());
+        ASSERT_EQ(extracted->text, "1");
+        ASSERT_EQ(extracted->use_count(), 1);
+        ASSERT_EQ(extracted->previous(), nullptr);
+        ASSERT_EQ(extracted->next(), nullptr);
+        ASSERT_EQ(data_islist.size(), 1);
+        ASSERT_EQ(data_islist.front().text, "2");
+        ASSERT_TRUE(value_1);
+        extracted = nullptr;
+        ASSERT_FALSE(value_1);
+        ASSERT_TRUE(value_2);
+    }
+    ASSERT_FALSE(value_2);
+}
+
 TEST(intrusive_list_tests, clear__not_empty_list__no_exception)
 {
     bool svalue = false;
@@ -290,6 +328,52 @@ TEST(intrusive_list_tests, swap__not_empty_list_arg__no_exception)
     }
 }
 
+TEST(intrusive_list_tests, swap__empty_list_arg__links_updated)
+{
+    bool value_1 = false;
+    bool value_2 = false;
+    {
+        itru::sharable_intrusive_list<data_silist_node> data_islist;
+        data_islist.emplace_back(value_1, "1");
+        data_islist.emplace_back(value_2, "2");
+        itru::sharable_intrusive_list<data_silist_node> other_data_islist;
+        data_islist.swap(other_data_islist);
+        ASSERT_TRUE(data_islist.empty());
+        ASSERT_EQ(data_islist.begin(), data_islist.end());
+        std::vector<const bool*> value_pointers;
+        for (const auto& item : other_data_islist)
+            value_pointers.push_back(item.valid);
+        std::vector<const bool*> expected_pointers{ &value_1, &value_2 };
+        ASSERT_EQ(value_pointers, expected_pointers);
+        ASSERT_EQ(other_data_islist.begin()->previous(), &*other_data_islist.end());
+        data_islist.swap(other_data_islist);
+        ASSERT_TRUE(other_data_islist.empty());
+        ASSERT_EQ(data_islist.size(), 2);
+        ASSERT_EQ(std::distance(data_islist.begin(), data_islist.end()), 2);
+    }
+    ASSERT_FALSE(value_1);
+    ASSERT_FALSE(value_2);
+}
+
+TEST(intrusive_list_tests, move_constructor__not_empty_list__no_exception)
+{
+    bool value_1 = false;
+    bool value_2 = false;
+    {
+        itru::sharable_intrusive_list<data_silist_node> data_islist;
+        data_islist.emplace_back(value_1, "1");
+        data_islist.emplace_back(value_2, "2");
+        itru::sharable_intrusive_list<data_silist_node> other_data_islist(std::move(data_islist));
+        ASSERT_TRUE(data_islist.empty());
+        ASSERT_EQ(other_data_islist.size(), 2);
+        ASSERT_EQ(other_data_islist.front().valid, &value_1);
+        ASSERT_EQ(other_data_islist.back().valid, &value_2);
+        ASSERT_EQ(std::next(other_data_islist.begin(), 2), other_data_islist.end());
+    }
+    ASSERT_FALSE(value_1);
+    ASSERT_FALSE(value_2);
+}
+
 TEST(intrusive_list_tests, std_swap__not_empty_list_arg__no_exception)
 {
     bool value_1 = false;
@@ -429,6 +513,9 @@ TEST(intrusive_list_tests, splice__list__no_exception)
         ASSERT_EQ(value_pointers, expected_pointers);
         ASSERT_EQ(data_islist.size(), 6);
         ASSERT_TRUE(other_data_islist.empty());
+        ASSERT_EQ(backward_value_pointers(data_islist),
+                  (std::vector<const bool*>{ &value_3, &value_2, &value_1, &value_6, &value_5, &value_4 }));
+        ASSERT_TRUE(backward_value_pointers(other_data_islist).empty());
     }
 }
 
@@ -460,6 +547,8 @@ TEST(intrusive_list_tests, splice__rvalue_list__no_exception)
         std::vector<const bool*> expected_pointers{ &value_4, &value_5, &value_6, &value_1, &value_2, &value_3 };
         ASSERT_EQ(value_pointers, expected_pointers);
         ASSERT_EQ(data_islist.size(), 6);
+        ASSERT_EQ(backward_value_pointers(data_islist),
+                  (std::vector<const bool*>{ &value_3, &value_2, &value_1, &value_6, &value_5, &value_4 }));
     }
 }
 
@@ -490,6 +579,9 @@ TEST(intrusive_list_tests, splice__sublist__no_exception)
         ASSERT_EQ(data_islist.size(), 5);
         ASSERT_EQ(other_data_islist.front().valid, &value_4);
         ASSERT_EQ(other_data_islist.size(), 1);
+        ASSERT_EQ(backward_value_pointers(data_islist),
+                  (std::vector<const bool*>{ &value_3, &value_2, &value_1, &value_6, &value_5 }));
+        ASSERT_EQ(backward_value_pointers(other_data_islist), (std::vector<const bool*>{ &value_4 }));
     }
 }
 
@@ -520,6 +612,9 @@ TEST(intrusive_list_tests, splice__value_iter__no_exception)
         ASSERT_EQ(other_data_islist.front().valid, &value_4);
         ASSERT_EQ(other_data_islist.back().valid, &value_6);
         ASSERT_EQ(other_data_islist.size(), 2);
+        ASSERT_EQ(backward_value_pointers(data_islist),
+                  (std::vector<const bool*>{ &value_3, &value_2, &value_1, &value_5 }));
+        ASSERT_EQ(backward_value_pointers(other_data_islist), (std::vector<const bool*>{ &value_6, &value_4 }));
     }
 }
 
@@ -586,3 +681,263 @@ TEST(intrusive_list_tests, std_erase_if__lambda__no_exception)
         ASSERT_FALSE(value_6);
     }
 }
+
+namespace
+{
+std::vector<std::string> list_texts(const itru::sharable_intrusive_list<data_silist_node>& data_islist)
+{
+    std::vector<std::string> texts;
+    for (const auto& item : data_islist)
+        texts.push_back(item.text);
+    return texts;
+}
+
+void check_links(const itru::sharable_intrusive_list<data_silist_node>& data_islist)
+{
+    std::size_t count = 0;
+    auto previous_iter = data_islist.end();
+    for (auto iter = data_islist.begin(); iter != data_islist.end(); previous_iter = iter++, ++count)
+        ASSERT_EQ(iter->previous(), previous_iter.ptr());
+    ASSERT_EQ(data_islist.end()->previous(), previous_iter.ptr());
+    ASSERT_EQ(count, data_islist.size());
+}
+
+std::size_t counted_node_ref_ops = 0;
+
+struct counted_silist_node : public itru::sharable_intrusive_list_hook<counted_silist_node>
+{
+    int value = 0;
+    unsigned counter = 0;
+
+    counted_silist_node() {}
+    explicit counted_silist_node(int v) : value(v) {}
+};
+
+void shared_intrusive_ptr_add_ref(counted_silist_node* ptr) noexcept
+{
+    ++counted_node_ref_ops;
+    ++(ptr->counter);
+}
+
+void shared_intrusive_ptr_release(counted_silist_node* ptr) noexcept
+{
+    ++counted_node_ref_ops;
+    if (--(ptr->counter); ptr->counter == 0)
+        delete ptr;
+}
+} // namespace
+
+TEST(intrusive_list_tests, sort__unsorted_list__sorted_and_stable)
+{
+    bool value_1 = false;
+    bool value_2 = false;
+    bool value_3 = false;
+    bool value_4 = false;
+    bool value_5 = false;
+    {
+        itru::sharable_intrusive_list<data_silist_node> data_islist;
+        data_islist.emplace_back(value_1, "c");
+        data_islist.emplace_back(value_2, "a");
+        data_islist.emplace_back(value_3, "b");
+        data_islist.emplace_back(value_4, "a");
+        data_islist.emplace_back(value_5, "d");
+        data_islist.sort([](const data_silist_node& lhs, const data_silist_node& rhs) { return lhs.text < rhs.text; });
+        ASSERT_EQ(list_texts(data_islist), (std::vector<std::string>{ "a", "a", "b", "c", "d" }));
+        ASSERT_EQ(data_islist.begin()->valid, &value_2);
+        ASSERT_EQ(std::next(data_islist.begin())->valid, &value_4);
+        check_links(data_islist);
+        ASSERT_EQ(data_islist.front().use_count(), 1);
+    }
+    ASSERT_FALSE(value_1);
+    ASSERT_FALSE(value_3);
+    ASSERT_FALSE(value_5);
+}
+
+TEST(intrusive_list_tests, sort__empty_list__no_exception)
+{
+    itru::sharable_intrusive_list<data_silist_node> data_islist;
+    data_islist.sort([](const data_silist_node& lhs, const data_silist_node& rhs) { return lhs.text < rhs.text; });
+    ASSERT_TRUE(data_islist.empty());
+    ASSERT_EQ(data_islist.begin(), data_islist.end());
+}
+
+TEST(intrusive_list_tests, sort__many_values__no_counter_touched)
+{
+    itru::sharable_intrusive_list<counted_silist_node> data_islist;
+    for (int i = 0; i < 1000; ++i)
+        data_islist.emplace_back((i * 7919) % 1000);
+    counted_node_ref_ops = 0;
+    data_islist.sort([](const counted_silist_node& lhs, const counted_silist_node& rhs)
+                     { return lhs.value < rhs.value; });
+    data_islist.reverse();
+    ASSERT_EQ(counted_node_ref_ops, 0);
+    int expected_value = 999;
+    for (const auto& item : data_islist)
+    {
+        ASSERT_EQ(item.value, expected_value--);
+        ASSERT_EQ(item.counter, 1);
+    }
+    ASSERT_EQ(data_islist.size(), 1000);
+}
+
+TEST(intrusive_list_tests, merge__sorted_lists__merged_and_stable)
+{
+    bool values[6] = {};
+    {
+        itru::sharable_intrusive_list<data_silist_node> data_islist;
+        data_islist.emplace_back(values[0], "a");
+        data_islist.emplace_back(values[1], "c");
+        data_islist.emplace_back(values[2], "e");
+        itru::sharable_intrusive_list<data_silist_node> other_data_islist;
+        other_data_islist.emplace_back(values[3], "b");
+        other_data_islist.emplace_back(values[4], "c");
+        other_data_islist.emplace_back(values[5], "f");
+        data_islist.merge(other_data_islist,
+                          [](const data_silist_node& lhs, const data_silist_node& rhs) { return lhs.text < rhs.text; });
+        ASSERT_EQ(list_texts(data_islist), (std::vector<std::string>{ "a", "b", "c", "c", "e", "f" }));
+        ASSERT_EQ(std::next(data_islist.begin(), 2)->valid, &values[1]);
+        ASSERT_EQ(data_islist.size(), 6);
+        check_links(data_islist);
+        ASSERT_TRUE(other_data_islist.empty());
+        ASSERT_EQ(other_data_islist.begin(), other_data_islist.end());
+        other_data_islist.emplace_back(values[3], "z");
+        ASSERT_EQ(other_data_islist.size(), 1);
+        check_links(other_data_islist);
+    }
+    for (bool value : values)
+        ASSERT_FALSE(value);
+}
+
+namespace
+{
+// Compares the texts, and throws at the throw_index-th call.
+struct throwing_text_less
+{
+    int throw_index;
+    int call_count = 0;
+
+    bool operator()(const data_silist_node& lhs, const data_silist_node& rhs)
+    {
+        if (call_count++ == throw_index)
+            throw std::runtime_error("comparison failed");
+        return lhs.text < rhs.text;
+    }
+};
+
+std::vector<std::string> sorted_list_texts(const itru::sharable_intrusive_list<data_silist_node>& list)
+{
+    std::vector<std::string> texts = list_texts(list);
+    std::sort(texts.begin(), texts.end());
+    return texts;
+}
+} // namespace
+
+TEST(intrusive_list_tests, sort__throwing_compare__all_nodes_kept)
+{
+    bool values[8] = {};
+    {
+        itru::sharable_intrusive_list<data_silist_node> data_islist;
+        for (int i = 0; i < 8; ++i)
+            data_islist.emplace_back(values[i], std::string(1, char('a' + (i * 5) % 8)));
+        ASSERT_THROW(data_islist.sort(throwing_text_less{ 6 }), std::runtime_error);
+        ASSERT_EQ(data_islist.size(), 8);
+        ASSERT_EQ(sorted_list_texts(data_islist),
+                  (std::vector<std::string>{ "a", "b", "c", "d", "e", "f", "g", "h" }));
+        check_links(data_islist);
+        for (bool value : values)
+            ASSERT_TRUE(value);
+        data_islist.sort(throwing_text_less{ -1 });
+        ASSERT_EQ(list_texts(data_islist), (std::vector<std::string>{ "a", "b", "c", "d", "e", "f", "g", "h" }));
+    }
+    for (bool value : values)
+        ASSERT_FALSE(value);
+}
+
+TEST(intrusive_list_tests, merge__throwing_compare__all_nodes_kept)
+{
+    bool values[6] = {};
+    {
+        itru::sharable_intrusive_list<data_silist_node> data_islist;
+        data_islist.emplace_back(values[0], "a");
+        data_islist.emplace_back(values[1], "c");
+        data_islist.emplace_back(values[2], "e");
+        itru::sharable_intrusive_list<data_silist_node> other_data_islist;
+        other_data_islist.emplace_back(values[3], "b");
+        other_data_islist.emplace_back(values[4], "d");
+        other_data_islist.emplace_back(values[5], "f");
+        ASSERT_THROW(data_islist.merge(other_data_islist, throwing_text_less{ 2 }), std::runtime_error);
+        ASSERT_EQ(data_islist.size(), 6);
+        ASSERT_EQ(sorted_list_texts(data_islist), (std::vector<std::string>{ "a", "b", "c", "d", "e", "f" }));
+        check_links(data_islist);
+        ASSERT_TRUE(other_data_islist.empty());
+        check_links(other_data_islist);
+        for (bool value : values)
+            ASSERT_TRUE(value);
+    }
+    for (bool value : values)
+        ASSERT_FALSE(value);
+}
+
+TEST(intrusive_list_tests, reverse__not_empty_list__reversed)
+{
+    bool values[3] = {};
+    {
+        itru::sharable_intrusive_list<data_silist_node> data_islist;
+        data_islist.emplace_back(values[0], "1");
+        data_islist.emplace_back(values[1], "2");
+        data_islist.emplace_back(values[2], "3");
+        data_islist.reverse();
+        ASSERT_EQ(list_texts(data_islist), (std::vector<std::string>{ "3", "2", "1" }));
+        check_links(data_islist);
+    }
+    for (bool value : values)
+        ASSERT_FALSE(value);
+}
+
+TEST(intrusive_list_tests, unique__consecutive_duplicates__removed)
+{
+    bool values[6] = {};
+    {
+        itru::sharable_intrusive_list<data_silist_node> data_islist;
+        data_islist.emplace_back(values[0], "a");
+        data_islist.emplace_back(values[1], "a");
+        data_islist.emplace_back(values[2], "b");
+        data_islist.emplace_back(values[3], "a");
+        data_islist.emplace_back(values[4], "a");
+        data_islist.emplace_back(values[5], "a");
+        auto count = data_islist.unique([](const data_silist_node& lhs, const data_silist_node& rhs)
+                                        { return lhs.text == rhs.text; });
+        ASSERT_EQ(count, 3);
+        ASSERT_EQ(list_texts(data_islist), (std::vector<std::string>{ "a", "b", "a" }));
+        ASSERT_TRUE(values[0]);
+        ASSERT_FALSE(values[1]);
+        ASSERT_TRUE(values[3]);
+        ASSERT_FALSE(values[5]);
+        check_links(data_islist);
+    }
+}
+
+TEST(intrusive_list_tests, for_each__various_prefetch_distances__visited_in_order)
+{
+    itru::sharable_intrusive_list<data_silist_node> data_islist;
+    std::vector<std::string> expected_texts;
+    for (int i = 0; i < 20; ++i)
+    {
+        expected_texts.push_back(std::to_string(i));
+        data_islist.emplace_back();
+        data_islist.back().text = expected_texts.back();
+    }
+    for (std::size_t prefetch_distance : { 0, 1, 8, 19, 20, 100 })
+    {
+        std::vector<std::string> texts;
+        std::as_const(data_islist).for_each([&](const data_silist_node& node) { texts.push_back(node.text); },
+                                            prefetch_distance);
+        ASSERT_EQ(texts, expected_texts);
+    }
+    data_islist.for_each([](data_silist_node& node) { node.text += "!"; });
+    ASSERT_EQ(data_islist.front().text, "0!");
+    ASSERT_EQ(data_islist.back().text, "19!");
+
+    itru::sharable_intrusive_list<data_silist_node> empty_list;
+    empty_list.for_each([](data_silist_node&) { FAIL(); });
+}
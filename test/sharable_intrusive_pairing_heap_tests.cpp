@@ -0,0 +1,278 @@
+#include "data_siheap_node.hpp"
+#include <arba/itru/sharable_intrusive_pairing_heap.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_siheap = itru::sharable_intrusive_pairing_heap<data_siheap_node, later_deadline>;
+
+template <class HeapT>
+std::vector<int> pop_all(HeapT& heap)
+{
+    std::vector<int> deadlines;
+    while (!heap.empty())
+    {
+        deadlines.push_back(heap.top().deadline);
+        heap.pop();
+    }
+    return deadlines;
+}
+
+struct comparison_failure
+{
+    int call_count = 0;
+    int throw_index = -1;
+};
+
+// Compares as later_deadline, and throws at the throw_index-th call of the shared failure.
+struct throwing_later_deadline
+{
+    comparison_failure* failure = nullptr;
+
+    bool operator()(const data_siheap_node& lhs, const data_siheap_node& rhs) const
+    {
+        if (failure->call_count++ == failure->throw_index)
+            throw std::runtime_error("comparison failed");
+        return lhs.deadline > rhs.deadline;
+    }
+};
+
+using throwing_data_siheap = itru::sharable_intrusive_pairing_heap<data_siheap_node, throwing_later_deadline>;
+} // namespace
+
+TEST(sharable_intrusive_pairing_heap_tests, constructor__no_arg__empty)
+{
+    data_siheap heap;
+    ASSERT_TRUE(heap.empty());
+    ASSERT_EQ(heap.size(), 0);
+}
+
+TEST(sharable_intrusive_pairing_heap_tests, push_pop__values__popped_in_order)
+{
+    bool value = false;
+    {
+        data_siheap heap;
+        for (int deadline : { 5, 3, 8, 1, 9, 2 })
+            heap.emplace(deadline);
+        heap.push(itru::make_shared_intrusive_ptr<data_siheap_node>(value, 4));
+        ASSERT_EQ(heap.size(), 7);
+        ASSERT_EQ(heap.top().deadline, 1);
+        ASSERT_EQ(heap.top().use_count(), 1);
+        ASSERT_EQ(pop_all(heap), (std::vector<int>{ 1, 2, 3, 4, 5, 8, 9 }));
+        ASSERT_FALSE(value);
+    }
+}
+
+TEST(sharable_intrusive_pairing_heap_tests, push_pop__random_values__sorted)
+{
+    std::mt19937 engine(3);
+    std::vector<int> deadlines(1000);
+    for (int& deadline : deadlines)
+        deadline = static_cast<int>(engine() % 10000);
+    data_siheap heap;
+    for (int deadline : deadlines)
+        heap.emplace(deadline);
+    std::sort(deadlines.begin(), deadlines.end());
+    ASSERT_EQ(pop_all(heap), deadlines);
+}
+
+TEST(sharable_intrusive_pairing_heap_tests, promote__earlier_deadline__new_top)
+{
+    data_siheap heap;
+    std::vector<itru::shared_intrusive_ptr<data_siheap_node>> nodes;
+    for (int deadline = 10; deadline < 20; ++deadline)
+    {
+        nodes.push_back(itru::make_shared_intrusive_ptr<data_siheap_node>(deadline));
+        heap.push(nodes.back());
+    }
+    heap.pop();
+    nodes[7]->deadline = 5;
+    heap.promote(*nodes[7]);
+    ASSERT_EQ(&heap.top(), nodes[7].get());
+    nodes[9]->deadline = 12;
+    heap.promote(*nodes[9]);
+    ASSERT_EQ(pop_all(heap), (std::vector<int>{ 5, 11, 12, 12, 13, 14, 15, 16, 18 }));
+}
+
+TEST(sharable_intrusive_pairing_heap_tests, update__later_deadline__moved_down)
+{
+    data_siheap heap;
+    std::vector<itru::shared_intrusive_ptr<data_siheap_node>> nodes;
+    for (int deadline = 0; deadline < 8; ++deadline)
+    {
+        nodes.push_back(itru::make_shared_intrusive_ptr<data_siheap_node>(deadline));
+        heap.push(nodes.back());
+    }
+    heap.pop();
+    heap.pop();
+    nodes[0]->deadline = 20;
+    nodes[2]->deadline = 30;
+    heap.update(*nodes[2]);
+    nodes[5]->deadline = 25;
+    heap.update(*nodes[5]);
+    ASSERT_EQ(heap.size(), 6);
+    ASSERT_EQ(pop_all(heap), (std::vector<int>{ 3, 4, 6, 7, 25, 30 }));
+}
+
+TEST(sharable_intrusive_pairing_heap_tests, erase__any_element__ownership_released)
+{
+    bool value = false;
+    data_siheap heap;
+    for (int deadline : { 4, 1, 7, 3 })
+        heap.emplace(deadline);
+    heap.pop();
+    itru::shared_intrusive_ptr<data_siheap_node> node = itru::make_shared_intrusive_ptr<data_siheap_node>(value, 5);
+    heap.push(node);
+    for (int deadline : { 6, 2, 9 })
+        heap.emplace(deadline);
+    ASSERT_EQ(node->use_count(), 2);
+    heap.erase(*node);
+    ASSERT_EQ(node->use_count(), 1);
+    ASSERT_EQ(node->previous(), nullptr);
+    ASSERT_EQ(node->first_child(), nullptr);
+    ASSERT_EQ(node->next_sibling(), nullptr);
+    itru::shared_intrusive_ptr<data_siheap_node> top = heap.extract(heap.top());
+    ASSERT_EQ(top->deadline, 2);
+    ASSERT_EQ(pop_all(heap), (std::vector<int>{ 3, 4, 6, 7, 9 }));
+    ASSERT_TRUE(value);
+    node = nullptr;
+    ASSERT_FALSE(value);
+}
+
+TEST(sharable_intrusive_pairing_heap_tests, merge__two_heaps__one_heap)
+{
+    data_siheap heap;
+    data_siheap other_heap;
+    for (int deadline : { 1, 4, 6 })
+        heap.emplace(deadline);
+    for (int deadline : { 2, 3, 5 })
+        other_heap.emplace(deadline);
+    heap.merge(other_heap);
+    ASSERT_TRUE(other_heap.empty());
+    ASSERT_EQ(heap.size(), 6);
+    ASSERT_EQ(pop_all(heap), (std::vector<int>{ 1, 2, 3, 4, 5, 6 }));
+}
+
+TEST(sharable_intrusive_pairing_heap_tests, clear__deep_heap__values_released)
+{
+    constexpr int value_count = 100'000;
+    bool value = false;
+    data_siheap heap;
+    heap.emplace(value, value_count);
+    // Each deadline pushed is earlier than the top one: the heap degenerates into a chain of first children.
+    for (int deadline = value_count - 1; deadline >= 0; --deadline)
+        heap.emplace(deadline);
+    heap.clear();
+    ASSERT_FALSE(value);
+    ASSERT_TRUE(heap.empty());
+}
+
+TEST(sharable_intrusive_pairing_heap_tests, raw_link__nodes_owned_elsewhere__no_exception)
+{
+    std::array<data_raw_siheap_node, 4> nodes = { data_raw_siheap_node(3), data_raw_siheap_node(1),
+                                                  data_raw_siheap_node(4), data_raw_siheap_node(2) };
+    {
+        itru::sharable_intrusive_pairing_heap<data_raw_siheap_node, later_deadline> heap;
+        for (auto& node : nodes)
+            heap.push(&node);
+        ASSERT_EQ(&heap.top(), &nodes[1]);
+        ASSERT_EQ(heap.extract(nodes[0]), &nodes[0]);
+        heap.pop();
+        ASSERT_EQ(&heap.top(), &nodes[3]);
+    }
+    for (const auto& node : nodes)
+    {
+        ASSERT_EQ(node.previous(), nullptr);
+        ASSERT_EQ(node.first_child(), nullptr);
+        ASSERT_EQ(node.next_sibling(), nullptr);
+    }
+}
+
+TEST(sharable_intrusive_pairing_heap_tests, pop_erase_update__throwing_compare__heap_unchanged)
+{
+    for (int throw_index = 0; throw_index < 6; ++throw_index)
+    {
+        bool values[16] = {};
+        {
+            comparison_failure failure;
+            throwing_data_siheap heap(throwing_later_deadline{ &failure });
+            std::vector<itru::shared_intrusive_ptr<data_siheap_node>> nodes;
+            for (int i = 0; i < 16; ++i)
+            {
+                nodes.push_back(itru::make_shared_intrusive_ptr<data_siheap_node>(values[i], (i * 7) % 16));
+                heap.push(nodes.back());
+            }
+            heap.pop();
+            std::vector<int> expected_deadlines = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+            const auto remove_expected = [&](int deadline)
+            { expected_deadlines.erase(std::find(expected_deadlines.begin(), expected_deadlines.end(), deadline)); };
+            const auto check_heap = [&]
+            {
+                ASSERT_EQ(heap.size(), expected_deadlines.size());
+                ASSERT_EQ(heap.top().deadline, expected_deadlines.front());
+            };
+
+            failure = { 0, throw_index };
+            const int top_deadline = heap.top().deadline;
+            try
+            {
+                heap.pop();
+                remove_expected(top_deadline);
+            }
+            catch (const std::runtime_error&)
+            {
+            }
+            check_heap();
+
+            failure = { 0, throw_index };
+            try
+            {
+                heap.erase(*nodes[5]);
+                remove_expected(nodes[5]->deadline);
+            }
+            catch (const std::runtime_error&)
+            {
+            }
+            check_heap();
+
+            failure = { 0, throw_index };
+            try
+            {
+                heap.update(*nodes[9]);
+            }
+            catch (const std::runtime_error&)
+            {
+            }
+            check_heap();
+
+            failure = { 0, throw_index };
+            nodes[12]->deadline = 0;
+            try
+            {
+                heap.promote(*nodes[12]);
+                remove_expected(4);
+                expected_deadlines.insert(expected_deadlines.begin(), 0);
+            }
+            catch (const std::runtime_error&)
+            {
+                nodes[12]->deadline = 4;
+            }
+            check_heap();
+
+            nodes.clear();
+            failure = {};
+            ASSERT_EQ(pop_all(heap), expected_deadlines);
+        }
+        for (bool value : values)
+            ASSERT_FALSE(value);
+    }
+}
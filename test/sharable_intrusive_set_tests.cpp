@@ -0,0 +1,247 @@
+#include "data_siset_node.hpp"
+#include <arba/itru/sharable_intrusive_set.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <set>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_siset = itru::sharable_intrusive_set<data_siset_node, data_siset_node_key_of>;
+using transparent_data_siset = itru::sharable_intrusive_set<data_siset_node, data_siset_node_key_of, std::less<>>;
+
+template <class SetT>
+std::vector<int> keys(const SetT& set)
+{
+    std::vector<int> keys;
+    for (const auto& item : set)
+        keys.push_back(item.key);
+    return keys;
+}
+
+// Returns the black height of the subtree, or -1 if a red-black tree property is broken.
+int checked_black_height(const data_siset_node* node, const data_siset_node* parent)
+{
+    if (!node)
+        return 1;
+    if (node->parent() != parent || (node->red() && parent && parent->red()))
+        return -1;
+    const int left_height = checked_black_height(node->left_pointer(), node);
+    const int right_height = checked_black_height(node->right_pointer(), node);
+    if (left_height < 0 || left_height != right_height)
+        return -1;
+    return left_height + (node->red() ? 0 : 1);
+}
+
+bool is_valid_tree(const data_siset& data_set)
+{
+    if (data_set.empty())
+        return data_set.begin() == data_set.end();
+    const data_siset_node* root = data_set.begin().ptr();
+    while (root->parent())
+        root = root->parent();
+    return !root->red() && checked_black_height(root, nullptr) > 0
+           && std::is_sorted(data_set.begin(), data_set.end(),
+                             [](const auto& lhs, const auto& rhs) { return lhs.key < rhs.key; })
+           && static_cast<std::size_t>(std::distance(data_set.begin(), data_set.end())) == data_set.size();
+}
+} // namespace
+
+TEST(sharable_intrusive_set_tests, constructor__no_arg__empty)
+{
+    data_siset data_set;
+    ASSERT_TRUE(data_set.empty());
+    ASSERT_EQ(data_set.size(), 0);
+    ASSERT_EQ(data_set.begin(), data_set.end());
+    ASSERT_EQ(data_set.find(1), data_set.end());
+    ASSERT_EQ(data_set.lower_bound(1), data_set.end());
+}
+
+TEST(sharable_intrusive_set_tests, insert__new_and_duplicate_keys__sorted)
+{
+    bool value_1 = false;
+    bool value_2 = false;
+    bool value_3 = false;
+    {
+        data_siset data_set;
+        auto [iter_2, inserted_2] = data_set.insert(itru::make_shared_intrusive_ptr<data_siset_node>(value_2, 2));
+        ASSERT_TRUE(inserted_2);
+        ASSERT_EQ(iter_2->valid, &value_2);
+        auto [iter_1, inserted_1] = data_set.emplace(value_1, 1);
+        ASSERT_TRUE(inserted_1);
+        auto [iter_3, inserted_3] = data_set.emplace(value_3, 2);
+        ASSERT_FALSE(inserted_3);
+        ASSERT_EQ(iter_3, iter_2);
+        ASSERT_FALSE(value_3);
+        ASSERT_EQ(data_set.size(), 2);
+        ASSERT_EQ(keys(data_set), (std::vector<int>{ 1, 2 }));
+        ASSERT_EQ(data_set.begin(), iter_1);
+        ASSERT_EQ(data_set.find(2)->use_count(), 1);
+    }
+    ASSERT_FALSE(value_1);
+    ASSERT_FALSE(value_2);
+}
+
+TEST(sharable_intrusive_set_tests, insert_erase__random_keys__balanced_and_sorted)
+{
+    std::mt19937 engine(7);
+    std::uniform_int_distribution<int> distribution(0, 499);
+    data_siset data_set;
+    std::set<int> expected_keys;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const int key = distribution(engine);
+        if (engine() % 3 == 0)
+            ASSERT_EQ(data_set.erase(key), expected_keys.erase(key));
+        else
+            ASSERT_EQ(data_set.emplace(key).second, expected_keys.insert(key).second);
+        ASSERT_TRUE(is_valid_tree(data_set));
+    }
+    ASSERT_EQ(keys(data_set), std::vector<int>(expected_keys.begin(), expected_keys.end()));
+}
+
+TEST(sharable_intrusive_set_tests, lower_upper_bound__keys__no_exception)
+{
+    data_siset data_set;
+    for (int key : { 10, 20, 30, 40 })
+        data_set.emplace(key);
+    ASSERT_EQ(data_set.lower_bound(20)->key, 20);
+    ASSERT_EQ(data_set.upper_bound(20)->key, 30);
+    ASSERT_EQ(data_set.lower_bound(25)->key, 30);
+    ASSERT_EQ(data_set.upper_bound(5)->key, 10);
+    ASSERT_EQ(data_set.lower_bound(41), data_set.end());
+    ASSERT_EQ(data_set.upper_bound(40), data_set.end());
+    const data_siset& const_data_set = data_set;
+    ASSERT_EQ(std::distance(const_data_set.lower_bound(15), const_data_set.upper_bound(35)), 2);
+}
+
+TEST(sharable_intrusive_set_tests, iterators__bidirectional__no_exception)
+{
+    data_siset data_set;
+    for (int key : { 3, 1, 2 })
+        data_set.emplace(key);
+    auto iter = data_set.end();
+    ASSERT_EQ((--iter)->key, 3);
+    ASSERT_EQ((--iter)->key, 2);
+    ASSERT_EQ((--iter)->key, 1);
+    ASSERT_EQ(iter, data_set.begin());
+    std::vector<int> reversed_keys;
+    for (auto riter = data_set.rbegin(); riter != data_set.rend(); ++riter)
+        reversed_keys.push_back(riter->key);
+    ASSERT_EQ(reversed_keys, (std::vector<int>{ 3, 2, 1 }));
+}
+
+TEST(sharable_intrusive_set_tests, unlink__element__ownership_moved_out)
+{
+    bool value = false;
+    data_siset data_set;
+    for (int key = 0; key < 10; ++key)
+        data_set.emplace(key);
+    itru::shared_intrusive_ptr<data_siset_node> node_siptr(data_set.emplace(value, 10).first.ptr());
+    ASSERT_EQ(node_siptr->use_count(), 2);
+    data_siset_node& middle = *data_set.find(5);
+    ASSERT_EQ(data_set.iterator_to(middle), data_set.find(5));
+    ASSERT_EQ(data_set.unlink(middle)->key, 5);
+    itru::shared_intrusive_ptr<data_siset_node> unlinked_siptr = data_set.unlink(*node_siptr);
+    ASSERT_EQ(unlinked_siptr, node_siptr);
+    ASSERT_EQ(node_siptr->use_count(), 2);
+    ASSERT_EQ(node_siptr->parent(), nullptr);
+    ASSERT_TRUE(value);
+    ASSERT_EQ(keys(data_set), (std::vector<int>{ 0, 1, 2, 3, 4, 6, 7, 8, 9 }));
+    ASSERT_TRUE(is_valid_tree(data_set));
+}
+
+TEST(sharable_intrusive_set_tests, erase__iterators__all_values_erased)
+{
+    data_siset data_set;
+    for (int key = 0; key < 100; ++key)
+        data_set.emplace(key);
+    int expected_key = 0;
+    for (auto iter = data_set.begin(); iter != data_set.end(); ++expected_key)
+    {
+        ASSERT_EQ(iter->key, expected_key);
+        iter = data_set.erase(iter);
+    }
+    ASSERT_EQ(expected_key, 100);
+    ASSERT_TRUE(data_set.empty());
+    ASSERT_EQ(data_set.begin(), data_set.end());
+}
+
+TEST(sharable_intrusive_set_tests, extract__key__ownership_moved_out)
+{
+    bool value = false;
+    data_siset data_set;
+    data_set.emplace(value, 1);
+    itru::shared_intrusive_ptr<data_siset_node> node_siptr = data_set.extract(1);
+    ASSERT_TRUE(data_set.empty());
+    ASSERT_TRUE(value);
+    ASSERT_EQ(node_siptr->use_count(), 1);
+    ASSERT_EQ(data_set.extract(1), nullptr);
+}
+
+TEST(sharable_intrusive_set_tests, find__heterogeneous_key__no_exception)
+{
+    transparent_data_siset data_set;
+    data_set.emplace(1);
+    data_set.emplace(2);
+    ASSERT_EQ(data_set.find(2L)->key, 2);
+    ASSERT_TRUE(data_set.contains(1L));
+    ASSERT_EQ(data_set.lower_bound(1.5)->key, 2);
+    ASSERT_EQ(data_set.erase(1L), 1);
+    ASSERT_EQ(keys(data_set), std::vector<int>{ 2 });
+}
+
+TEST(sharable_intrusive_set_tests, clear__degenerate_shapes__values_released)
+{
+    constexpr int value_count = 100'000;
+    data_siset data_set;
+    for (int key = 0; key < value_count; ++key)
+        data_set.emplace(key);
+    bool value = false;
+    data_set.emplace(value, value_count);
+    ASSERT_TRUE(is_valid_tree(data_set));
+    data_set.clear();
+    ASSERT_FALSE(value);
+    ASSERT_TRUE(data_set.empty());
+    ASSERT_EQ(data_set.begin(), data_set.end());
+}
+
+TEST(sharable_intrusive_set_tests, move_constructor__not_empty_set__no_exception)
+{
+    data_siset data_set;
+    data_set.emplace(1);
+    data_set.emplace(2);
+    data_siset other_data_set(std::move(data_set));
+    ASSERT_TRUE(data_set.empty());
+    ASSERT_EQ(data_set.begin(), data_set.end());
+    ASSERT_EQ(keys(other_data_set), (std::vector<int>{ 1, 2 }));
+    data_set.emplace(3);
+    ASSERT_EQ(keys(data_set), std::vector<int>{ 3 });
+}
+
+TEST(sharable_intrusive_set_tests, raw_link__nodes_owned_elsewhere__no_exception)
+{
+    std::array<data_raw_siset_node, 3> nodes = { data_raw_siset_node(2), data_raw_siset_node(3),
+                                                 data_raw_siset_node(1) };
+    {
+        itru::sharable_intrusive_set<data_raw_siset_node, data_siset_node_key_of> data_set;
+        for (auto& node : nodes)
+            ASSERT_TRUE(data_set.insert(&node).second);
+        ASSERT_EQ(data_set.begin().ptr(), &nodes[2]);
+        ASSERT_EQ(data_set.unlink(nodes[0]), &nodes[0]);
+        ASSERT_EQ(data_set.size(), 2);
+        ASSERT_EQ(nodes[0].parent(), nullptr);
+    }
+    for (const auto& node : nodes)
+    {
+        ASSERT_EQ(node.parent(), nullptr);
+        ASSERT_EQ(node.left(), nullptr);
+        ASSERT_EQ(node.right(), nullptr);
+    }
+}
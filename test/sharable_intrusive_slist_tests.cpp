@@ -0,0 +1,159 @@
+#include "data_sislist_node.hpp"
+#include <arba/itru/sharable_intrusive_slist.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_slist = itru::sharable_intrusive_slist<data_sislist_node>;
+using raw_data_slist = itru::sharable_intrusive_slist<data_raw_sislist_node>;
+
+template <class SlistT>
+std::vector<std::string> list_texts(const SlistT& slist)
+{
+    std::vector<std::string> texts;
+    for (const auto& item : slist)
+        texts.push_back(item.text);
+    return texts;
+}
+} // namespace
+
+TEST(intrusive_slist_tests, hook__any_link_policy__pointer_size)
+{
+    static_assert(data_slist::owns_values);
+    static_assert(!raw_data_slist::owns_values);
+    ASSERT_EQ(sizeof(itru::sharable_intrusive_slist_hook<data_sislist_node>), sizeof(void*));
+    ASSERT_EQ(sizeof(itru::sharable_intrusive_slist_hook<data_raw_sislist_node, itru::raw_link_t>), sizeof(void*));
+}
+
+TEST(intrusive_slist_tests, push_front_push_back_insert_after__valid_args__ordered)
+{
+    bool values[4] = {};
+    {
+        data_slist slist;
+        ASSERT_TRUE(slist.empty());
+        ASSERT_EQ(slist.begin(), slist.end());
+        slist.emplace_back(values[0], "2");
+        slist.emplace_front(values[1], "1");
+        slist.emplace_back(values[2], "4");
+        auto iter = slist.emplace_after(std::next(slist.begin()), values[3], "3");
+        ASSERT_EQ(iter->text, "3");
+        ASSERT_EQ(slist.size(), 4);
+        ASSERT_EQ(list_texts(slist), (std::vector<std::string>{ "1", "2", "3", "4" }));
+        ASSERT_EQ(slist.front().text, "1");
+        ASSERT_EQ(slist.back().text, "4");
+        ASSERT_EQ(slist.front().use_count(), 1);
+    }
+    for (bool value : values)
+        ASSERT_FALSE(value);
+}
+
+TEST(intrusive_slist_tests, erase_after_pop_front__valid_args__tail_kept)
+{
+    bool values[3] = {};
+    data_slist slist;
+    slist.emplace_back(values[0], "1");
+    slist.emplace_back(values[1], "2");
+    slist.emplace_back(values[2], "3");
+    auto iter = slist.erase_after(slist.begin());
+    ASSERT_EQ(iter->text, "3");
+    ASSERT_FALSE(values[1]);
+    ASSERT_EQ(slist.erase_after(slist.begin()), slist.end());
+    ASSERT_FALSE(values[2]);
+    ASSERT_EQ(slist.back().text, "1");
+    slist.emplace_back(values[1], "4");
+    ASSERT_EQ(list_texts(slist), (std::vector<std::string>{ "1", "4" }));
+    slist.pop_front();
+    slist.pop_front();
+    ASSERT_TRUE(slist.empty());
+    ASSERT_FALSE(values[0]);
+    ASSERT_FALSE(values[1]);
+    slist.emplace_back(values[0], "5");
+    ASSERT_EQ(slist.front().text, "5");
+    ASSERT_EQ(slist.back().text, "5");
+}
+
+TEST(intrusive_slist_tests, splice_after__other_list__nodes_moved)
+{
+    bool valid = false;
+    data_slist slist;
+    data_slist other;
+    for (const char* text : { "1", "4" })
+        slist.emplace_back(valid, text);
+    for (const char* text : { "2", "3" })
+        other.emplace_back(valid, text);
+    slist.splice_after(slist.begin(), other);
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(slist.size(), 4);
+    ASSERT_EQ(list_texts(slist), (std::vector<std::string>{ "1", "2", "3", "4" }));
+    ASSERT_EQ(slist.back().text, "4");
+
+    other.emplace_back(valid, "5");
+    other.emplace_back(valid, "6");
+    slist.splice_after(std::next(slist.begin(), 3), other);
+    ASSERT_EQ(slist.back().text, "6");
+
+    // Single node.
+    other.splice_after(other.before_begin(), slist, std::next(slist.begin(), 4));
+    ASSERT_EQ(list_texts(slist), (std::vector<std::string>{ "1", "2", "3", "4", "5" }));
+    ASSERT_EQ(slist.back().text, "5");
+    ASSERT_EQ(list_texts(other), (std::vector<std::string>{ "6" }));
+    ASSERT_EQ(other.back().text, "6");
+    for (const auto& node : slist)
+        ASSERT_EQ(node.use_count(), 1);
+
+    data_slist moved(std::move(slist));
+    ASSERT_TRUE(slist.empty());
+    ASSERT_EQ(moved.size(), 5);
+    moved.swap(other);
+    ASSERT_EQ(moved.size(), 1);
+    ASSERT_EQ(other.back().text, "5");
+}
+
+TEST(intrusive_slist_tests, remove_if_reverse__lambda__relinked)
+{
+    bool values[6] = {};
+    data_slist slist;
+    for (int i = 0; i < 6; ++i)
+        slist.emplace_back(values[i], std::to_string(i));
+    ASSERT_EQ(slist.remove_if([](const data_sislist_node& node) { return node.text == "0" || node.text == "5"; }), 2);
+    ASSERT_FALSE(values[0]);
+    ASSERT_FALSE(values[5]);
+    ASSERT_EQ(slist.back().text, "4");
+    slist.reverse();
+    ASSERT_EQ(list_texts(slist), (std::vector<std::string>{ "4", "3", "2", "1" }));
+    ASSERT_EQ(slist.back().text, "1");
+    slist.emplace_back(values[0], "0");
+    ASSERT_EQ(list_texts(slist), (std::vector<std::string>{ "4", "3", "2", "1", "0" }));
+}
+
+TEST(intrusive_slist_tests, clear__long_list__no_recursive_release)
+{
+    data_slist slist;
+    for (int i = 0; i < 1'000'000; ++i)
+        slist.emplace_front();
+    slist.clear();
+    ASSERT_TRUE(slist.empty());
+}
+
+TEST(intrusive_slist_tests, raw_link__nodes_owned_elsewhere__indexed)
+{
+    std::array<data_raw_sislist_node, 3> nodes{ data_raw_sislist_node("1"), data_raw_sislist_node("2"),
+                                                data_raw_sislist_node("3") };
+    raw_data_slist slist;
+    slist.push_back(&nodes[1]);
+    slist.push_front(&nodes[0]);
+    slist.push_back(&nodes[2]);
+    ASSERT_EQ(list_texts(slist), (std::vector<std::string>{ "1", "2", "3" }));
+    slist.erase_after(slist.begin());
+    ASSERT_EQ(list_texts(slist), (std::vector<std::string>{ "1", "3" }));
+    ASSERT_EQ(nodes[1].next_pointer(), nullptr);
+    slist.clear();
+    ASSERT_EQ(nodes[0].next_pointer(), nullptr);
+}
@@ -0,0 +1,137 @@
+#include "data_sitree_node.hpp"
+#include <arba/itru/sharable_intrusive_tree.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_tree = itru::sharable_intrusive_tree<data_sitree_node>;
+using data_siptr = itru::shared_intrusive_ptr<data_sitree_node>;
+
+data_siptr make_node(const std::string& text)
+{
+    return itru::make_shared_intrusive_ptr<data_sitree_node>(text);
+}
+
+template <class RangeT>
+std::string range_texts(RangeT&& range)
+{
+    std::string texts;
+    for (const data_sitree_node& node : range)
+        texts += node.text;
+    return texts;
+}
+
+// a(b(d, e), c(f))
+data_tree make_tree()
+{
+    data_tree tree(make_node("a"));
+    data_siptr b = make_node("b");
+    data_siptr c = make_node("c");
+    data_tree::append_child(*b, make_node("e"));
+    data_tree::prepend_child(*b, make_node("d"));
+    data_tree::append_child(*c, make_node("f"));
+    data_tree::append_child(*tree.root(), c);
+    data_tree::prepend_child(*tree.root(), b);
+    return tree;
+}
+} // namespace
+
+TEST(sharable_intrusive_tree_tests, preorder_postorder__tree__iterative_traversals)
+{
+    data_tree tree = make_tree();
+    ASSERT_EQ(tree.size(), 6);
+    ASSERT_EQ(range_texts(tree.preorder()), "abdecf");
+    ASSERT_EQ(range_texts(tree.postorder()), "debfca");
+    ASSERT_EQ(range_texts(std::as_const(tree).preorder()), "abdecf");
+    data_sitree_node& b = *tree.root()->first_child();
+    ASSERT_EQ(range_texts(data_tree::preorder(&b)), "bde");
+    ASSERT_EQ(range_texts(data_tree::postorder(&b)), "deb");
+    ASSERT_EQ(b.parent(), tree.root());
+    ASSERT_EQ(b.next_sibling()->text, "c");
+    ASSERT_EQ(tree.root()->last_child()->previous_sibling(), &b);
+
+    data_tree empty_tree;
+    ASSERT_EQ(range_texts(empty_tree.preorder()), "");
+    ASSERT_EQ(range_texts(empty_tree.postorder()), "");
+    ASSERT_EQ(empty_tree.size(), 0);
+}
+
+TEST(sharable_intrusive_tree_tests, reparent_detach_insert_before__valid_nodes__relinked)
+{
+    data_tree tree = make_tree();
+    data_sitree_node& root = *tree.root();
+    data_sitree_node& b = *root.first_child();
+    data_sitree_node& c = *root.last_child();
+    data_sitree_node& d = *b.first_child();
+
+    data_tree::reparent(b, c);
+    ASSERT_EQ(range_texts(tree.preorder()), "acfbde");
+    ASSERT_EQ(b.parent(), &c);
+    ASSERT_EQ(root.first_child().get(), &c);
+    ASSERT_EQ(b.use_count(), 1);
+
+    data_siptr detached = data_tree::detach(d);
+    ASSERT_EQ(d.parent(), nullptr);
+    ASSERT_EQ(range_texts(tree.preorder()), "acfbe");
+    ASSERT_EQ(detached->use_count(), 1);
+    ASSERT_EQ(data_tree::detach(d), nullptr);
+
+    data_tree::insert_before(c, std::move(detached));
+    ASSERT_EQ(range_texts(tree.preorder()), "adcfbe");
+    ASSERT_EQ(c.previous_sibling(), &d);
+    ASSERT_EQ(d.next_sibling(), &c);
+
+    data_tree::splice_children(d, c);
+    ASSERT_EQ(range_texts(tree.preorder()), "adfbec");
+    ASSERT_EQ(b.parent(), &d);
+    ASSERT_FALSE(c.has_children());
+    ASSERT_EQ(range_texts(tree.postorder()), "febdca");
+}
+
+TEST(sharable_intrusive_tree_tests, destructor__deep_and_wide_tree__no_recursive_release)
+{
+    bool valid = false;
+    {
+        data_tree tree(make_node("root"));
+        data_sitree_node* node = tree.root();
+        for (int i = 0; i < 1'000'000; ++i)
+        {
+            data_siptr child = make_node("");
+            data_sitree_node* next = child.get();
+            data_tree::append_child(*node, std::move(child));
+            node = next;
+        }
+        for (int i = 0; i < 1000; ++i)
+            data_tree::append_child(*tree.root(), itru::make_shared_intrusive_ptr<data_sitree_node>(valid));
+        ASSERT_TRUE(valid);
+    }
+    ASSERT_FALSE(valid);
+}
+
+TEST(sharable_intrusive_tree_tests, clear__node_shared_outside__survives_as_detached_root)
+{
+    bool b_valid = false;
+    bool d_valid = false;
+    bool c_valid = false;
+    data_siptr b = itru::make_shared_intrusive_ptr<data_sitree_node>(b_valid, "b");
+    data_tree tree(make_node("a"));
+    data_tree::append_child(*b, itru::make_shared_intrusive_ptr<data_sitree_node>(d_valid, "d"));
+    data_tree::append_child(*tree.root(), b);
+    data_tree::append_child(*tree.root(), itru::make_shared_intrusive_ptr<data_sitree_node>(c_valid, "c"));
+    tree.clear();
+    ASSERT_FALSE(c_valid);
+    ASSERT_TRUE(b_valid);
+    ASSERT_TRUE(d_valid);
+    ASSERT_EQ(b->parent(), nullptr);
+    ASSERT_EQ(b->next_sibling(), nullptr);
+    ASSERT_EQ(range_texts(data_tree::preorder(b.get())), "bd");
+    b = nullptr;
+    ASSERT_FALSE(b_valid);
+    ASSERT_FALSE(d_valid);
+}
@@ -0,0 +1,212 @@
+#include "data_siuset_node.hpp"
+#include <arba/itru/sharable_intrusive_unordered_set.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_siuset = itru::sharable_intrusive_unordered_set<data_siuset_node, data_siuset_node_key_of>;
+using transparent_data_siuset = itru::sharable_intrusive_unordered_set<data_siuset_node, data_siuset_node_key_of,
+                                                                       transparent_string_hash, std::equal_to<>>;
+
+template <class SetT>
+std::vector<std::string> sorted_keys(const SetT& set)
+{
+    std::vector<std::string> keys;
+    for (const auto& item : set)
+        keys.push_back(item.key);
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+} // namespace
+
+TEST(sharable_intrusive_unordered_set_tests, constructor__no_arg__empty)
+{
+    data_siuset data_set;
+    ASSERT_TRUE(data_set.empty());
+    ASSERT_EQ(data_set.size(), 0);
+    ASSERT_EQ(data_set.bucket_count(), 0);
+    ASSERT_EQ(data_set.begin(), data_set.end());
+    ASSERT_EQ(data_set.find("none"), data_set.end());
+}
+
+TEST(sharable_intrusive_unordered_set_tests, insert__new_and_duplicate_keys__no_exception)
+{
+    bool value_1 = false;
+    bool value_2 = false;
+    bool value_3 = false;
+    {
+        data_siuset data_set;
+        auto [iter_1, inserted_1] = data_set.insert(itru::make_shared_intrusive_ptr<data_siuset_node>(value_1, "1"));
+        ASSERT_TRUE(inserted_1);
+        ASSERT_EQ(iter_1->valid, &value_1);
+        auto [iter_2, inserted_2] = data_set.emplace(value_2, "2");
+        ASSERT_TRUE(inserted_2);
+        ASSERT_EQ(iter_2->valid, &value_2);
+        auto [iter_3, inserted_3] = data_set.emplace(value_3, "1");
+        ASSERT_FALSE(inserted_3);
+        ASSERT_EQ(iter_3, iter_1);
+        ASSERT_FALSE(value_3);
+        ASSERT_EQ(data_set.size(), 2);
+        ASSERT_EQ(data_set.find("1")->valid, &value_1);
+        ASSERT_TRUE(data_set.contains("2"));
+        ASSERT_EQ(data_set.count("3"), 0);
+        ASSERT_EQ(data_set.find("1")->use_count(), 1);
+    }
+    ASSERT_FALSE(value_1);
+    ASSERT_FALSE(value_2);
+}
+
+TEST(sharable_intrusive_unordered_set_tests, insert__shared_value__shared_ownership)
+{
+    bool value = false;
+    itru::shared_intrusive_ptr<data_siuset_node> node_siptr;
+    {
+        data_siuset data_set;
+        node_siptr = itru::make_shared_intrusive_ptr<data_siuset_node>(value, "1");
+        data_set.insert(node_siptr);
+        ASSERT_EQ(node_siptr->use_count(), 2);
+    }
+    ASSERT_TRUE(value);
+    ASSERT_EQ(node_siptr->use_count(), 1);
+    ASSERT_EQ(node_siptr->bucket_next(), nullptr);
+}
+
+TEST(sharable_intrusive_unordered_set_tests, insert__many_values__incremental_rehash)
+{
+    constexpr std::size_t value_count = 1000;
+    data_siuset data_set;
+    bool rehash_seen = false;
+    for (std::size_t i = 0; i < value_count; ++i)
+    {
+        data_set.emplace(std::to_string(i));
+        rehash_seen = rehash_seen || data_set.is_rehashing();
+        ASSERT_LE(data_set.load_factor(), data_set.max_load_factor());
+        ASSERT_TRUE(data_set.contains("0"));
+        ASSERT_TRUE(data_set.contains(std::to_string(i / 2)));
+    }
+    ASSERT_TRUE(rehash_seen);
+    ASSERT_EQ(data_set.size(), value_count);
+    ASSERT_EQ(static_cast<std::size_t>(std::distance(data_set.begin(), data_set.end())), value_count);
+    for (std::size_t i = 0; i < value_count; ++i)
+        ASSERT_EQ(data_set.find(std::to_string(i))->key, std::to_string(i));
+}
+
+TEST(sharable_intrusive_unordered_set_tests, erase__key__no_exception)
+{
+    bool value_1 = false;
+    bool value_2 = false;
+    {
+        data_siuset data_set;
+        data_set.emplace(value_1, "1");
+        data_set.emplace(value_2, "2");
+        ASSERT_EQ(data_set.erase("1"), 1);
+        ASSERT_FALSE(value_1);
+        ASSERT_EQ(data_set.erase("1"), 0);
+        ASSERT_EQ(data_set.size(), 1);
+        ASSERT_EQ(sorted_keys(data_set), std::vector<std::string>{ "2" });
+    }
+    ASSERT_FALSE(value_2);
+}
+
+TEST(sharable_intrusive_unordered_set_tests, erase__iterators__all_values_erased)
+{
+    data_siuset data_set;
+    for (int i = 0; i < 100; ++i)
+        data_set.emplace(std::to_string(i));
+    std::size_t count = 0;
+    for (auto iter = data_set.begin(); iter != data_set.end(); ++count)
+        iter = data_set.erase(iter);
+    ASSERT_EQ(count, 100);
+    ASSERT_TRUE(data_set.empty());
+    ASSERT_EQ(data_set.begin(), data_set.end());
+}
+
+TEST(sharable_intrusive_unordered_set_tests, extract__key__ownership_moved_out)
+{
+    bool value = false;
+    data_siuset data_set;
+    data_set.emplace(value, "1");
+    itru::shared_intrusive_ptr<data_siuset_node> node_siptr = data_set.extract("1");
+    ASSERT_TRUE(data_set.empty());
+    ASSERT_TRUE(value);
+    ASSERT_EQ(node_siptr->use_count(), 1);
+    ASSERT_EQ(data_set.extract("1"), nullptr);
+}
+
+TEST(sharable_intrusive_unordered_set_tests, find__heterogeneous_key__no_exception)
+{
+    transparent_data_siuset data_set;
+    data_set.emplace("one");
+    data_set.emplace("two");
+    std::string_view key = "two";
+    ASSERT_EQ(data_set.find(key)->key, "two");
+    ASSERT_TRUE(data_set.contains(std::string_view("one")));
+    ASSERT_EQ(data_set.count(std::string_view("three")), 0);
+    ASSERT_EQ(data_set.erase(std::string_view("one")), 1);
+    ASSERT_EQ(sorted_keys(data_set), std::vector<std::string>{ "two" });
+}
+
+TEST(sharable_intrusive_unordered_set_tests, clear__not_empty_set__values_released)
+{
+    bool value_1 = false;
+    bool value_2 = false;
+    data_siuset data_set;
+    data_set.emplace(value_1, "1");
+    data_set.emplace(value_2, "2");
+    data_set.clear();
+    ASSERT_FALSE(value_1);
+    ASSERT_FALSE(value_2);
+    ASSERT_TRUE(data_set.empty());
+    ASSERT_EQ(data_set.begin(), data_set.end());
+}
+
+TEST(sharable_intrusive_unordered_set_tests, rehash__bucket_count__keys_kept)
+{
+    data_siuset data_set;
+    for (int i = 0; i < 20; ++i)
+        data_set.emplace(std::to_string(i));
+    data_set.rehash(1000);
+    ASSERT_EQ(data_set.bucket_count(), 1024);
+    ASSERT_FALSE(data_set.is_rehashing());
+    for (int i = 0; i < 20; ++i)
+        ASSERT_TRUE(data_set.contains(std::to_string(i)));
+    data_set.rehash(0);
+    ASSERT_EQ(data_set.bucket_count(), 32);
+    ASSERT_EQ(sorted_keys(data_set).size(), 20);
+}
+
+TEST(sharable_intrusive_unordered_set_tests, move_constructor__not_empty_set__no_exception)
+{
+    data_siuset data_set;
+    data_set.emplace("1");
+    data_set.emplace("2");
+    data_siuset other_data_set(std::move(data_set));
+    ASSERT_TRUE(data_set.empty());
+    ASSERT_EQ(data_set.begin(), data_set.end());
+    ASSERT_EQ(sorted_keys(other_data_set), (std::vector<std::string>{ "1", "2" }));
+    data_set.emplace("3");
+    ASSERT_EQ(sorted_keys(data_set), std::vector<std::string>{ "3" });
+}
+
+TEST(sharable_intrusive_unordered_set_tests, raw_link__nodes_owned_elsewhere__no_exception)
+{
+    std::array<data_raw_siuset_node, 3> nodes = { data_raw_siuset_node("1"), data_raw_siuset_node("2"),
+                                                  data_raw_siuset_node("3") };
+    {
+        itru::sharable_intrusive_unordered_set<data_raw_siuset_node, data_siuset_node_key_of> data_set;
+        for (auto& node : nodes)
+            ASSERT_TRUE(data_set.insert(&node).second);
+        ASSERT_EQ(data_set.find("2").ptr(), &nodes[1]);
+        ASSERT_EQ(data_set.extract("2"), &nodes[1]);
+        ASSERT_EQ(data_set.size(), 2);
+    }
+    for (auto& node : nodes)
+        ASSERT_EQ(node.bucket_next(), nullptr);
+}
@@ -0,0 +1,143 @@
+#include <arba/itru/shared_buffer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+//----------------------------------------------------------------
+
+namespace
+{
+std::string_view as_string_view(std::span<const std::byte> bytes)
+{
+    return std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+itru::buffer_slice make_slice(std::string_view text)
+{
+    itru::shared_intrusive_ptr buffer = itru::shared_buffer::make(text.size());
+    std::memcpy(buffer->data(), text.data(), text.size());
+    return itru::buffer_slice(std::move(buffer));
+}
+
+void write_text(int fd, std::string_view text)
+{
+    ASSERT_EQ(::write(fd, text.data(), text.size()), ::ssize_t(text.size()));
+}
+} // namespace
+
+TEST(shared_buffer_tests, test_subslice__whole_buffer__bytes_shared)
+{
+    itru::buffer_slice slice = make_slice("header:payload");
+    ASSERT_EQ(slice.size(), 14);
+    ASSERT_EQ(slice.buffer()->use_count(), 1);
+    itru::buffer_slice payload = slice.subslice(7);
+    itru::buffer_slice name = slice.subslice(0, 6);
+    ASSERT_EQ(as_string_view(payload.bytes()), "payload");
+    ASSERT_EQ(as_string_view(name.bytes()), "header");
+    ASSERT_EQ(payload.data(), slice.data() + 7);
+    ASSERT_EQ(slice.buffer()->use_count(), 3);
+    slice = itru::buffer_slice();
+    ASSERT_TRUE(slice.empty());
+    ASSERT_EQ(payload.buffer()->use_count(), 2);
+    ASSERT_EQ(as_string_view(payload.subslice(1, 3).bytes()), "ayl");
+}
+
+TEST(shared_buffer_tests, test_split_front__message__parts_shared)
+{
+    itru::buffer_slice rest = make_slice("GET /index HTTP/1.1");
+    itru::buffer_slice method = rest.split_front(3);
+    rest.remove_prefix(1);
+    itru::buffer_slice path = rest.split_front(6);
+    rest.remove_prefix(1);
+    rest.remove_suffix(4);
+    ASSERT_EQ(as_string_view(method.bytes()), "GET");
+    ASSERT_EQ(as_string_view(path.bytes()), "/index");
+    ASSERT_EQ(as_string_view(rest.bytes()), "HTTP");
+    ASSERT_EQ(method.buffer(), rest.buffer());
+    ASSERT_EQ(rest.buffer()->use_count(), 3);
+}
+
+TEST(shared_buffer_tests, test_gather_iovecs__slices__writev_writes_all)
+{
+    itru::buffer_slice message = make_slice("hello world");
+    std::vector<itru::buffer_slice> slices{ message.subslice(6), make_slice(", "), itru::buffer_slice(),
+                                            message.subslice(0, 5) };
+    std::array<::iovec, 8> iovecs;
+    const std::size_t iovec_count = itru::gather_iovecs(slices, iovecs);
+    ASSERT_EQ(iovec_count, 3);
+    ASSERT_EQ(iovecs[0].iov_base, message.data() + 6);
+    ASSERT_EQ(itru::gather_iovecs(slices, std::span(iovecs).first(2)), 2);
+
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    ASSERT_EQ(::writev(fds[1], iovecs.data(), int(iovec_count)), 12);
+    std::array<char, 16> received;
+    ASSERT_EQ(::read(fds[0], received.data(), received.size()), 12);
+    ASSERT_EQ(std::string_view(received.data(), 12), "world, hello");
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(shared_buffer_tests, test_read_some__messages__slices_share_buffer)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    itru::buffer_builder builder(64);
+    write_text(fds[1], "first;second;thi");
+    ASSERT_EQ(builder.read_some(fds[0]), 16);
+    ASSERT_EQ(as_string_view(builder.readable()), "first;second;thi");
+    itru::buffer_slice first = builder.take(5);
+    builder.skip(1);
+    itru::buffer_slice second = builder.take(6);
+    builder.skip(1);
+    write_text(fds[1], "rd;");
+    ASSERT_EQ(builder.read_some(fds[0]), 3);
+    itru::buffer_slice third = builder.take(5);
+    ASSERT_EQ(as_string_view(first.bytes()), "first");
+    ASSERT_EQ(as_string_view(second.bytes()), "second");
+    ASSERT_EQ(as_string_view(third.bytes()), "third");
+    ASSERT_EQ(first.buffer(), third.buffer());
+    ASSERT_EQ(third.data(), first.data() + 13);
+    ASSERT_EQ(builder.readable_size(), 1);
+
+    ::close(fds[1]);
+    builder.skip(1);
+    ASSERT_EQ(builder.read_some(fds[0]), 0);
+    ::close(fds[0]);
+}
+
+TEST(shared_buffer_tests, test_recv_some__buffer_full__partial_message_moved)
+{
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    itru::buffer_builder builder(8);
+    write_text(fds[1], "abcdefgh");
+    ASSERT_EQ(builder.recv_some(fds[0]), 8);
+    itru::buffer_slice taken = builder.take(5);
+    const std::byte* first_data = taken.data();
+
+    // The buffer is shared by a slice: the 3 readable bytes are copied in a new buffer.
+    write_text(fds[1], "ijklmnop");
+    ASSERT_EQ(builder.recv_some(fds[0]), 5);
+    ASSERT_EQ(as_string_view(builder.readable()), "fghijklm");
+    ASSERT_EQ(taken.buffer()->use_count(), 1);
+    ASSERT_EQ(as_string_view(taken.bytes()), "abcde");
+
+    // No slice shares the buffer: the readable bytes are moved to its front.
+    builder.skip(6);
+    const std::byte* second_data = builder.readable().data() - 6;
+    ASSERT_NE(second_data, first_data);
+    ASSERT_EQ(builder.recv_some(fds[0]), 3);
+    ASSERT_EQ(builder.readable().data(), second_data);
+    ASSERT_EQ(as_string_view(builder.take_all().bytes()), "lmnop");
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
@@ -0,0 +1,91 @@
+#include "data_snapshot.hpp"
+#include <arba/itru/snapshot_cell.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------
+
+TEST(snapshot_cell_tests, test_read__empty_cell__null_guard)
+{
+    itru::snapshot_cell<data_snapshot> cell;
+    ASSERT_FALSE(cell.read());
+    ASSERT_EQ(cell.load(), nullptr);
+}
+
+TEST(snapshot_cell_tests, test_publish__new_version__read_returns_it)
+{
+    itru::snapshot_cell<data_snapshot> cell(itru::make_shared_intrusive_ptr<data_snapshot>(1));
+    ASSERT_EQ(cell.read()->version, 1);
+    cell.publish(itru::make_shared_intrusive_ptr<data_snapshot>(2));
+    ASSERT_EQ(cell.read()->version, 2);
+    itru::shared_intrusive_ptr<data_snapshot> version = cell.load();
+    ASSERT_EQ(version->version, 2);
+    ASSERT_EQ(version->use_count(), 2);
+}
+
+TEST(snapshot_cell_tests, test_publish__reader_holds_guard__previous_version_kept_until_guard_ends)
+{
+    std::atomic<int> alive_count = 0;
+    {
+        itru::snapshot_cell<data_snapshot> cell(itru::make_shared_intrusive_ptr<data_snapshot>(alive_count, 1));
+        std::atomic<int> step = 0;
+        std::thread reader(
+            [&]
+            {
+                auto snapshot = cell.read();
+                step = 1;
+                while (step != 2)
+                    std::this_thread::yield();
+                EXPECT_EQ(snapshot->version, 1);
+                EXPECT_EQ(snapshot->use_count(), 1);
+            });
+        while (step != 1)
+            std::this_thread::yield();
+        cell.publish(itru::make_shared_intrusive_ptr<data_snapshot>(alive_count, 2));
+        for (int i = 0; i < 4; ++i)
+            itru::epoch_reclaimer::collect();
+        ASSERT_EQ(alive_count, 2);
+        step = 2;
+        reader.join();
+        itru::epoch_reclaimer::synchronize();
+        ASSERT_EQ(alive_count, 1);
+    }
+    ASSERT_EQ(alive_count, 0);
+}
+
+TEST(snapshot_cell_tests, test_publish__concurrent_readers__consistent_versions)
+{
+    std::atomic<int> alive_count = 0;
+    {
+        itru::snapshot_cell<data_snapshot> cell(itru::make_shared_intrusive_ptr<data_snapshot>(alive_count, 0));
+        std::atomic<bool> stop = false;
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 3; ++i)
+        {
+            readers.emplace_back(
+                [&]
+                {
+                    int last_version = 0;
+                    while (!stop)
+                    {
+                        auto snapshot = cell.read();
+                        EXPECT_EQ(snapshot->checksum, -snapshot->version);
+                        EXPECT_LE(last_version, snapshot->version);
+                        last_version = snapshot->version;
+                    }
+                });
+        }
+        for (int version = 1; version <= 1000; ++version)
+            cell.publish(itru::make_shared_intrusive_ptr<data_snapshot>(alive_count, version));
+        stop = true;
+        for (std::thread& reader : readers)
+            reader.join();
+        itru::epoch_reclaimer::synchronize();
+        ASSERT_EQ(alive_count, 1);
+    }
+    ASSERT_EQ(alive_count, 0);
+}
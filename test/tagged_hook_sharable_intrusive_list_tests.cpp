@@ -0,0 +1,99 @@
+#include "data_silist_node.hpp"
+#include <arba/itru/sharable_intrusive_list.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using connection_silist = itru::sharable_intrusive_list<
+    multi_hook_silist_node, multi_hook_silist_node,
+    itru::base_list_hook_accessor<multi_hook_silist_node, connection_hook_tag>>;
+using timeout_silist =
+    itru::sharable_intrusive_list<multi_hook_silist_node, multi_hook_silist_node,
+                                  itru::base_list_hook_accessor<multi_hook_silist_node, timeout_hook_tag>>;
+using priority_silist = itru::sharable_intrusive_list<
+    multi_hook_silist_node, multi_hook_silist_node,
+    itru::member_list_hook_accessor<multi_hook_silist_node, itru::sharable_intrusive_list_hook<multi_hook_silist_node>,
+                                    &multi_hook_silist_node::priority_hook>>;
+
+template <class ListT>
+std::vector<std::string> texts(const ListT& list)
+{
+    std::vector<std::string> result;
+    for (const auto& node : list)
+        result.push_back(node.text);
+    return result;
+}
+} // namespace
+
+TEST(tagged_hook_sharable_intrusive_list_tests, push_back__same_nodes_in_three_lists__independent_orders)
+{
+    connection_silist connection_list;
+    timeout_silist timeout_list;
+    priority_silist priority_list;
+    for (const char* text : { "a", "b", "c" })
+    {
+        itru::shared_intrusive_ptr node = itru::make_shared_intrusive_ptr<multi_hook_silist_node>(text);
+        connection_list.push_back(node);
+        timeout_list.push_front(node);
+        priority_list.push_back(node);
+    }
+    priority_list.reverse();
+    priority_list.splice(priority_list.end(), priority_list, priority_list.begin(),
+                         std::next(priority_list.begin()));
+    ASSERT_EQ(texts(connection_list), (std::vector<std::string>{ "a", "b", "c" }));
+    ASSERT_EQ(texts(timeout_list), (std::vector<std::string>{ "c", "b", "a" }));
+    ASSERT_EQ(texts(priority_list), (std::vector<std::string>{ "b", "a", "c" }));
+    ASSERT_EQ(connection_list.front().use_count(), 3);
+}
+
+TEST(tagged_hook_sharable_intrusive_list_tests, erase__one_list__other_lists_keep_ownership)
+{
+    itru::shared_intrusive_ptr node = itru::make_shared_intrusive_ptr<multi_hook_silist_node>("a");
+    connection_silist connection_list;
+    timeout_silist timeout_list;
+    connection_list.push_back(node);
+    timeout_list.push_back(node);
+    ASSERT_EQ(node->use_count(), 3);
+    connection_list.erase(connection_list.begin());
+    ASSERT_TRUE(connection_list.empty());
+    ASSERT_EQ(node->use_count(), 2);
+    ASSERT_EQ(&timeout_list.front(), node.get());
+    node->itru::sharable_intrusive_list_hook<multi_hook_silist_node, itru::shared_link_t, timeout_hook_tag>::unhook();
+    ASSERT_EQ(node->use_count(), 1);
+    {
+        priority_silist priority_list;
+        priority_list.push_back(node);
+        ASSERT_EQ(node->use_count(), 2);
+    }
+    ASSERT_EQ(node->use_count(), 1);
+}
+
+TEST(tagged_hook_sharable_intrusive_list_tests, unlink__member_hook__node_unlinked)
+{
+    priority_silist priority_list;
+    connection_silist connection_list;
+    std::vector<itru::shared_intrusive_ptr<multi_hook_silist_node>> nodes;
+    for (const char* text : { "a", "b", "c" })
+    {
+        nodes.push_back(itru::make_shared_intrusive_ptr<multi_hook_silist_node>(text));
+        priority_list.push_back(nodes.back());
+        connection_list.push_back(nodes.back());
+    }
+    priority_list.unlink(*nodes[1]);
+    ASSERT_EQ(texts(priority_list), (std::vector<std::string>{ "a", "c" }));
+    ASSERT_EQ(priority_list.size(), 2);
+    ASSERT_EQ(nodes[1]->priority_hook.previous(), nullptr);
+    ASSERT_EQ(nodes[1]->priority_hook.next(), nullptr);
+    ASSERT_EQ(nodes[2]->priority_hook.previous(), nodes[0].get());
+    ASSERT_EQ(nodes[1]->use_count(), 2);
+    connection_list.unlink(*nodes[0]);
+    ASSERT_EQ(texts(connection_list), (std::vector<std::string>{ "b", "c" }));
+    ASSERT_EQ(nodes[0]->use_count(), 2);
+    ASSERT_EQ(texts(priority_list), (std::vector<std::string>{ "a", "c" }));
+}
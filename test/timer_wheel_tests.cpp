@@ -0,0 +1,137 @@
+#include "data_timer_node.hpp"
+#include <arba/itru/timer_wheel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_timer_wheel = itru::timer_wheel<data_timer_node>;
+
+itru::shared_intrusive_ptr<data_timer_node> make_timer(const std::string& name)
+{
+    return itru::make_shared_intrusive_ptr<data_timer_node>(name);
+}
+
+std::vector<std::string> names(const data_timer_wheel::timer_list_type& timers)
+{
+    std::vector<std::string> result;
+    for (const auto& timer : timers)
+        result.push_back(timer.name);
+    return result;
+}
+} // namespace
+
+TEST(timer_wheel_tests, constructor__now__empty)
+{
+    data_timer_wheel wheel(100);
+    ASSERT_TRUE(wheel.empty());
+    ASSERT_EQ(wheel.now(), 100);
+    ASSERT_TRUE(wheel.advance(200).empty());
+    ASSERT_EQ(wheel.now(), 200);
+}
+
+TEST(timer_wheel_tests, advance__armed_timers__expired_in_order)
+{
+    data_timer_wheel wheel;
+    wheel.arm(make_timer("c"), 30);
+    wheel.arm(make_timer("a"), 10);
+    wheel.arm(make_timer("b"), 20);
+    wheel.arm(make_timer("b2"), 20);
+    ASSERT_EQ(wheel.size(), 4);
+    ASSERT_TRUE(wheel.advance(9).empty());
+    ASSERT_EQ(names(wheel.advance(20)), (std::vector<std::string>{ "a", "b", "b2" }));
+    ASSERT_EQ(wheel.size(), 1);
+    ASSERT_EQ(names(wheel.advance(1000)), std::vector<std::string>{ "c" });
+    ASSERT_TRUE(wheel.empty());
+}
+
+TEST(timer_wheel_tests, advance__timer_in_past__expired_at_next_advance)
+{
+    data_timer_wheel wheel(50);
+    auto timer = make_timer("a");
+    wheel.arm(timer, 10);
+    ASSERT_TRUE(wheel.is_armed(*timer));
+    ASSERT_EQ(names(wheel.advance(51)), std::vector<std::string>{ "a" });
+    ASSERT_FALSE(wheel.is_armed(*timer));
+}
+
+TEST(timer_wheel_tests, advance__far_timers__cascaded_between_levels)
+{
+    std::mt19937_64 engine(11);
+    data_timer_wheel wheel(1000);
+    std::multimap<data_timer_wheel::tick_type, std::string> expected;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const data_timer_wheel::tick_type expiry = 1001 + engine() % 300'000;
+        const std::string name = std::to_string(i);
+        wheel.arm(make_timer(name), expiry);
+        expected.emplace(expiry, name);
+    }
+    // One timer beyond the range of the wheel stays parked in its last level.
+    const data_timer_wheel::tick_type far_expiry = 1000 + data_timer_wheel::max_delay + 12345;
+    wheel.arm(make_timer("far"), far_expiry);
+    expected.emplace(far_expiry, "far");
+
+    data_timer_wheel::timer_list_type expired;
+    for (data_timer_wheel::tick_type previous_now = wheel.now(); previous_now < far_expiry;)
+    {
+        const data_timer_wheel::tick_type now = std::min(previous_now + 997, far_expiry);
+        const std::size_t previous_size = expired.size();
+        wheel.advance(now, expired);
+        for (auto iter = std::next(expired.begin(), previous_size); iter != expired.end(); ++iter)
+        {
+            ASSERT_LE(iter->timer_expiry(), now);
+            ASSERT_GT(iter->timer_expiry(), previous_now);
+        }
+        previous_now = now;
+    }
+    ASSERT_TRUE(wheel.empty());
+    std::vector<std::string> expected_names;
+    for (const auto& [expiry, name] : expected)
+        expected_names.push_back(name);
+    std::vector<std::string> expired_names = names(expired);
+    ASSERT_EQ(expired_names.size(), expected_names.size());
+    ASSERT_EQ(expired_names.back(), "far");
+    std::sort(expired_names.begin(), expired_names.end());
+    std::sort(expected_names.begin(), expected_names.end());
+    ASSERT_EQ(expired_names, expected_names);
+}
+
+TEST(timer_wheel_tests, rearm__armed_timer__moved_without_ref_change)
+{
+    data_timer_wheel wheel;
+    auto timer = make_timer("a");
+    wheel.arm(timer, 10);
+    wheel.arm(make_timer("b"), 20);
+    ASSERT_EQ(timer->use_count(), 2);
+    ASSERT_TRUE(wheel.rearm(*timer, 5000));
+    ASSERT_EQ(timer->use_count(), 2);
+    ASSERT_EQ(names(wheel.advance(100)), std::vector<std::string>{ "b" });
+    ASSERT_TRUE(wheel.rearm(*timer, 150));
+    ASSERT_EQ(names(wheel.advance(150)), std::vector<std::string>{ "a" });
+    ASSERT_FALSE(wheel.rearm(*timer, 200));
+}
+
+TEST(timer_wheel_tests, cancel__armed_timer__ownership_released)
+{
+    bool value = false;
+    data_timer_wheel wheel;
+    wheel.arm(itru::make_shared_intrusive_ptr<data_timer_node>(value, "a"), 10'000);
+    auto timer = make_timer("b");
+    wheel.arm(timer, 10);
+    ASSERT_TRUE(wheel.cancel(*timer));
+    ASSERT_FALSE(wheel.cancel(*timer));
+    ASSERT_EQ(timer->use_count(), 1);
+    ASSERT_EQ(wheel.size(), 1);
+    ASSERT_TRUE(wheel.advance(100).empty());
+    wheel.clear();
+    ASSERT_FALSE(value);
+    ASSERT_TRUE(wheel.empty());
+}
@@ -0,0 +1,125 @@
+#include "data_with_core_counter.hpp"
+#include <arba/itru/weak_intrusive_registry.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------
+
+namespace
+{
+using data_registry = itru::weak_intrusive_registry<data_with_ircnts>;
+
+std::vector<std::string> texts(const data_registry& registry)
+{
+    std::vector<std::string> texts;
+    for (const itru::shared_intrusive_ptr<data_with_ircnts>& element : registry)
+        texts.push_back(element->text);
+    return texts;
+}
+} // namespace
+
+TEST(weak_intrusive_registry_tests, test_insert__live_elements__iterated_in_order)
+{
+    bool valid = false;
+    auto first = itru::make_shared_intrusive_ptr<data_with_ircnts>(valid, "a");
+    auto second = itru::make_shared_intrusive_ptr<data_with_ircnts>(valid, "b");
+    data_registry registry;
+    registry.insert(first);
+    registry.insert(second);
+    ASSERT_EQ(registry.size(), 2);
+    ASSERT_EQ(first->use_count(), 1);
+    ASSERT_EQ(first->latent_count(), 1);
+    ASSERT_EQ(texts(registry), (std::vector<std::string>{ "a", "b" }));
+    for (const auto& element : registry)
+        ASSERT_EQ(element->use_count(), 2);
+}
+
+TEST(weak_intrusive_registry_tests, test_iterate__expired_element__skipped_and_kept_until_compaction)
+{
+    std::array<bool, 3> valids{};
+    auto first = itru::make_shared_intrusive_ptr<data_with_ircnts>(valids[0], "a");
+    auto second = itru::make_shared_intrusive_ptr<data_with_ircnts>(valids[1], "b");
+    auto third = itru::make_shared_intrusive_ptr<data_with_ircnts>(valids[2], "c");
+    data_registry registry;
+    registry.insert(first);
+    registry.insert(second);
+    registry.insert(third);
+    second = nullptr;
+    ASSERT_EQ(texts(registry), (std::vector<std::string>{ "a", "c" }));
+    ASSERT_EQ(registry.size(), 3);
+    ASSERT_TRUE(valids[1]);
+    ASSERT_EQ(registry.compact(), 1);
+    ASSERT_FALSE(valids[1]);
+    ASSERT_EQ(registry.size(), 2);
+    ASSERT_EQ(texts(registry), (std::vector<std::string>{ "a", "c" }));
+}
+
+TEST(weak_intrusive_registry_tests, test_insert__many_expired_entries__compacted_in_batch)
+{
+    bool valid = false;
+    auto kept = itru::make_shared_intrusive_ptr<data_with_ircnts>(valid, "kept");
+    data_registry registry;
+    registry.insert(kept);
+    std::size_t max_size = 0;
+    bool temporary_valid = false;
+    for (int i = 0; i < 1000; ++i)
+    {
+        registry.insert(itru::make_shared_intrusive_ptr<data_with_ircnts>(temporary_valid, "temporary"));
+        max_size = std::max(max_size, registry.size());
+    }
+    ASSERT_LE(max_size, data_registry::min_compaction_threshold + 1);
+    ASSERT_EQ(texts(registry), (std::vector<std::string>{ "kept" }));
+}
+
+TEST(weak_intrusive_registry_tests, test_for_each__half_expired__compacted)
+{
+    std::array<bool, 4> valids{};
+    std::vector<itru::shared_intrusive_ptr<data_with_ircnts>> elements;
+    data_registry registry;
+    for (int i = 0; i < 4; ++i)
+    {
+        elements.push_back(itru::make_shared_intrusive_ptr<data_with_ircnts>(valids[i], std::to_string(i)));
+        registry.insert(elements.back());
+    }
+    elements[0] = nullptr;
+    elements[2] = nullptr;
+    std::vector<std::string> visited;
+    registry.for_each([&](const itru::shared_intrusive_ptr<data_with_ircnts>& element)
+                      { visited.push_back(element->text); });
+    ASSERT_EQ(visited, (std::vector<std::string>{ "1", "3" }));
+    ASSERT_EQ(registry.size(), 2);
+}
+
+TEST(weak_intrusive_registry_tests, test_erase__registered_element__removed)
+{
+    bool valid = false;
+    auto first = itru::make_shared_intrusive_ptr<data_with_ircnts>(valid, "a");
+    auto second = itru::make_shared_intrusive_ptr<data_with_ircnts>(valid, "b");
+    data_registry registry;
+    registry.insert(first);
+    registry.insert(second);
+    ASSERT_TRUE(registry.erase(first.get()));
+    ASSERT_FALSE(registry.erase(first.get()));
+    ASSERT_EQ(first->latent_count(), 0);
+    ASSERT_EQ(texts(registry), (std::vector<std::string>{ "b" }));
+}
+
+TEST(weak_intrusive_registry_tests, test_destructor__expired_elements__memory_released)
+{
+    bool valid = false;
+    {
+        data_registry registry;
+        {
+            auto element = itru::make_shared_intrusive_ptr<data_with_ircnts>(valid, "a");
+            registry.insert(element);
+            data_registry copy(registry);
+            ASSERT_EQ(element->latent_count(), 2);
+        }
+        ASSERT_TRUE(valid);
+    }
+    ASSERT_FALSE(valid);
+}
@@ -93,6 +93,26 @@ TEST(wiptr_with_core_counter_tests, test_wiptr_lock_failure)
     ASSERT_FALSE(valid);
 }
 
+TEST(wiptr_with_core_counter_tests, test_siptr_try_lock_from)
+{
+    bool valid = false;
+    {
+        data_with_ircnts* data_ptr = new data_with_ircnts(valid, "text");
+        itru::shared_intrusive_ptr<data_with_ircnts> siptr(data_ptr);
+        itru::weak_intrusive_ptr<data_with_ircnts> wiptr(siptr);
+        itru::shared_intrusive_ptr<data_with_ircnts> siptr_2 =
+            itru::shared_intrusive_ptr<data_with_ircnts>::try_lock_from(data_ptr);
+        ASSERT_EQ(siptr_2.get(), data_ptr);
+        ASSERT_EQ(siptr_2->use_count(), 2);
+        siptr_2.release();
+        siptr.release();
+        ASSERT_TRUE(valid);
+        ASSERT_FALSE(itru::shared_intrusive_ptr<data_with_ircnts>::try_lock_from(data_ptr));
+        ASSERT_TRUE(wiptr.expired());
+    }
+    ASSERT_FALSE(valid);
+}
+
 TEST(wiptr_with_core_counter_tests, test_wiptr_operator_eq_ne)
 {
     bool valid = false;